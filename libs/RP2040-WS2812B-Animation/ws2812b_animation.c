@@ -7,8 +7,10 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include "pico/stdlib.h"
 #include "hardware/pio.h"
+#include "hardware/dma.h"
 #include "ws2812b_animation.h"
 #include "ws2812.pio.h"
 #include "CP0_EU_8x8.h" // https://github.com/TuriSc/CP0-EU
@@ -24,6 +26,74 @@ static utf8_iter ITER;
  */
 static uGRB32_t *ws2812b_buffer;
 
+/**
+ * @brief Output words in the format shifted out by the PIO program, one per pixel.
+ * The front buffer is read by DMA while the back buffer is prepared by the pixel pipeline.
+ */
+static uint32_t *output_front;
+static uint32_t *output_back;
+
+/**
+ * @brief Flag indicating that the back buffer holds a frame not sent yet.
+ */
+static bool frame_ready;
+
+/**
+ * @brief Time the last frame started to be sent, in microseconds.
+ */
+static uint64_t frame_start_us;
+
+/**
+ * @brief Per-channel lookup tables applying inversion and dimming. Each entry is already
+ * shifted to its channel's byte in the PIO word, so a pixel is three lookups and two ORs.
+ * Rebuilt only when the settings change.
+ */
+static uint32_t color_lut[3][256];
+
+/**
+ * @brief Flag indicating that inversion, dimming and brightness leave colors unchanged.
+ */
+static bool color_identity = true;
+
+/**
+ * @brief 16-bit output level of each 8-bit channel value, after inversion, dimming and
+ * brightness. The low byte is the fraction the LEDs can't show, dithered over frames.
+ */
+static uint16_t level_lut[256];
+
+/**
+ * @brief Flag indicating that some levels have a fraction, so frames are dithered.
+ */
+static bool dithering;
+
+/**
+ * @brief Fraction left over by the last frame for each channel of each pixel (G, R, B),
+ * added to the next frame.
+ */
+static uint8_t *dither_error;
+
+/**
+ * @brief Number of frames in a dithering cycle. The fraction added to each channel is carried
+ * in 8 bits, so a static frame repeats after this many frames, whose average is the exact level.
+ */
+#define DITHER_CYCLE_FRAMES 256u
+
+/**
+ * @brief Frames left before the strip settles: dithered frames while above 1, then one frame
+ * with the rounded levels. Restarted by render requests and setting changes.
+ */
+static uint16_t dither_frames;
+
+/**
+ * @brief Mask expanded to an AND mask per pixel, applied to the PIO words.
+ */
+static uint32_t *mask_words;
+
+/**
+ * @brief Flag indicating that a mask is set.
+ */
+static bool mask_active;
+
 /**
  * @brief Text effect structure.
  */
@@ -40,20 +110,42 @@ static FX_t fxs[MAX_EFFECTS];
 static alarm_id_t frame_by_frame_timer;
 
 /**
- * @brief Timer ID for rendering.
+ * @brief Flag indicating that the render alarm is pending.
  */
-static repeating_timer_t rendering_timer;
+static bool render_scheduled;
 
 /**
- * @brief Array of timer IDs for animation effects.
+ * @brief Timer ID for the animation scheduler, stepping all the effects.
  */
-static alarm_id_t animation_timers[MAX_EFFECTS];
+static alarm_id_t animation_timer;
+
+/**
+ * @brief Time the scheduler started, since when no animation was running. Steps are aligned to it.
+ */
+static uint64_t animation_epoch_us;
+
+/**
+ * @brief Frame composited from the buffer and the layers of the running effects.
+ */
+static uGRB32_t *composite_buffer;
 
 /**
  * @brief Flag to request rendering.
  */
 static bool request_render;
 
+/**
+ * @brief Copy of the buffer at the last render request, so that requests for the frame
+ * already shown don't send it again.
+ */
+static uGRB32_t *requested_buffer;
+
+/**
+ * @brief Flag indicating that the next render request must be sent even with an unchanged
+ * buffer: a setting changed, or the last request had effect layers composited over it.
+ */
+static bool render_stale = true;
+
 /**
  * @brief Character being rendered.
  */
@@ -128,36 +220,71 @@ uGRB32_t ws2812b_hex(uint32_t hex) {
     return ((uint32_t)(r) << 8) | ((uint32_t)(g) << 16) | (uint32_t)(b);
 }
 
+/**
+ * @brief Create a 24-bit color from HSV values in 12-bit fixed point.
+ * @param hue Hue in sixths of the circle (0-6*4096).
+ * @param s Saturation (0-4096).
+ * @param v Value (0-4096).
+ * @return 24-bit color value.
+ */
+static uGRB32_t hsv_q12(uint32_t hue, uint32_t s, uint32_t v) {
+    uint32_t r, g, b;
+
+    uint32_t i = hue >> 12;
+    uint32_t f = hue & 0xfffu;
+    uint32_t p = v * (4096u - s) >> 12;
+    uint32_t q = v * (4096u - (f * s >> 12)) >> 12;
+    uint32_t t = v * (4096u - ((4096u - f) * s >> 12)) >> 12;
+
+    switch (i % 6) {
+        case 0: r = v, g = t, b = p; break;
+        case 1: r = q, g = v, b = p; break;
+        case 2: r = p, g = v, b = t; break;
+        case 3: r = p, g = q, b = v; break;
+        case 4: r = t, g = p, b = v; break;
+        default: r = v, g = p, b = q; break;
+    }
+
+    return ws2812b_rgb(r * 255u >> 12, g * 255u >> 12, b * 255u >> 12);
+}
+
+/**
+ * @brief Convert a float to 12-bit fixed point, clamped to a range.
+ * @param x Value.
+ * @param scale Fixed point units per unit of x.
+ * @param max Largest result.
+ * @return Fixed point value.
+ */
+static uint32_t to_q12(float x, float scale, uint32_t max) {
+    int32_t q = (int32_t)(x * scale);
+    if(q < 0) return 0;
+    return (uint32_t)q > max ? max : (uint32_t)q;
+}
+
 /**
  * @brief Create a 24-bit color from HSV values.
+ * The inputs are converted once to fixed point, the RP2040 has no FPU.
  * @param _h Hue (0.0-360.0).
  * @param _s Saturation (0.0-100.0).
  * @param _v Value (0.0-100.0).
  * @return 24-bit color value.
  */
 uGRB32_t ws2812b_hsv(float _h, float _s, float _v) {
-    float r, g, b;
-	
-	float h = _h / 360;
-	float s = _s / 100;
-	float v = _v / 100;
-	
-	int i   = h * 6;
-	float f = h * 6 - i;
-	float p = v * (1 - s);
-	float q = v * (1 - f * s);
-	float t = v * (1 - (1 - f) * s);
-	
-	switch (i % 6) {
-		case 0: r = v, g = t, b = p; break;
-		case 1: r = q, g = v, b = p; break;
-		case 2: r = p, g = v, b = t; break;
-		case 3: r = p, g = q, b = v; break;
-		case 4: r = t, g = p, b = v; break;
-		case 5: r = v, g = p, b = q; break;
-	}
-
-    return ((uint32_t)(r * 255) << 8) | ((uint32_t)(g * 255) << 16) | (uint32_t)(b * 255);
+    return hsv_q12(to_q12(_h, 6.0f * 4096 / 360, 6 * 4096),
+                   to_q12(_s, 4096.0f / 100, 4096),
+                   to_q12(_v, 4096.0f / 100, 4096));
+}
+
+/**
+ * @brief Create a 24-bit color from 8-bit HSV values, using integer math only.
+ * @param h Hue (0-255 for the whole circle).
+ * @param s Saturation (0-255).
+ * @param v Value (0-255).
+ * @return 24-bit color value.
+ */
+uGRB32_t ws2812b_hsv8(uint8_t h, uint8_t s, uint8_t v) {
+    // 4112/256 is 4096/255 rounded up, so 255 maps to exactly 4096
+    return hsv_q12(h * 96u, s * 4112u >> 8, v * 4112u >> 8);
 }
 
 /**
@@ -167,8 +294,8 @@ uGRB32_t ws2812b_hsv(float _h, float _s, float _v) {
  */
 uGRB32_t ws2812b_random_color(float value) {
     init_random();
-    float h = (rand() % 360);
-    return ws2812b_hsv(h, 100.0f, value);
+    uint32_t h = (rand() % 360);
+    return hsv_q12(h * 4096u / 60u, 4096, to_q12(value, 4096.0f / 100, 4096));
 }
 
 /**
@@ -176,41 +303,222 @@ uGRB32_t ws2812b_random_color(float value) {
  */
 
 /**
- * @brief Write a pixel to the LED strip in blocking mode.
- * @param pixel_grb 24-bit color value.
+ * @brief Flag marking the layer pixels written by an effect.
+ */
+#define FX_OPAQUE 0xff000000u
+
+/**
+ * @brief Blend two colors, channel by channel.
+ * @param below Color below the effect.
+ * @param above Color drawn by the effect.
+ * @param blend Blend mode.
+ * @param alpha Opacity for FX_BLEND_ALPHA.
+ * @return 24-bit color value.
+ */
+static uGRB32_t blend_color(uGRB32_t below, uGRB32_t above, FX_blend_t blend, uint8_t alpha) {
+    uGRB32_t result = 0;
+
+    if(blend == FX_BLEND_REPLACE) return above & 0xffffffu;
+
+    for(uint32_t shift=0; shift<24; shift+=8) {
+        uint32_t b = (below >> shift) & 0xffu;
+        uint32_t a = (above >> shift) & 0xffu;
+        uint32_t c;
+        switch(blend) {
+            case FX_BLEND_ADD:   c = a + b; if(c > 255) c = 255; break;
+            case FX_BLEND_MAX:   c = a > b ? a : b; break;
+            case FX_BLEND_ALPHA: c = (a * alpha + b * (255u - alpha) + 127u) / 255u; break;
+            default:             c = a; break;
+        }
+        result |= c << shift;
+    }
+    return result;
+}
+
+/**
+ * @brief Composite the pixels written by an effect over a buffer.
+ * @param FX Effect descriptor.
+ * @param dst Buffer below the effect.
+ */
+static void blend_layer(const FX_t *FX, uGRB32_t *dst) {
+    uint32_t lo = (FX->from <= FX->to) ? FX->from : FX->to;
+    uint32_t hi = (FX->from <= FX->to) ? FX->to : FX->from;
+    if(hi >= config.num_pixels) hi = config.num_pixels - 1;
+
+    for(uint32_t i=lo; i<=hi; i++) {
+        uGRB32_t p = FX->layer[i];
+        if(p & FX_OPAQUE) {
+            dst[i] = blend_color(dst[i], p, FX->blend, FX->alpha);
+        }
+    }
+}
+
+/**
+ * @brief Composite the running effects over the buffer, in pool order.
+ * @return The frame to send: the buffer itself when no effect is running.
+ */
+static const uGRB32_t *compose_frame() {
+    const uGRB32_t *frame = ws2812b_buffer;
+
+    for(uint8_t i=0; i<MAX_EFFECTS; i++) {
+        if(!fxs[i].running || !fxs[i].layer) continue;
+        if(frame == ws2812b_buffer) {
+            memcpy(composite_buffer, ws2812b_buffer, config.num_pixels * sizeof(uGRB32_t));
+            frame = composite_buffer;
+        }
+        blend_layer(&fxs[i], composite_buffer);
+    }
+    return frame;
+}
+
+/**
+ * @brief Run the pixel pipeline over the whole strip.
+ * @param out Output buffer, receiving one PIO word per pixel.
+ */
+static void prepare_frame(uint32_t *out) {
+    const uGRB32_t *in = compose_frame();
+    uint32_t n = config.num_pixels;
+
+    // The PIO program shifts out the 24 most significant bits
+    if(color_identity) {
+        for(uint32_t i=0; i<n; i++) {
+            out[i] = in[i] << 8u;
+        }
+    } else if(dither_frames > 1) {
+        // The high byte of each level is sent, the low byte is carried over to the next frame
+        uint8_t *e = dither_error;
+        uint32_t fractions = 0;
+        for(uint32_t i=0; i<n; i++, e+=3) {
+            uGRB32_t p = in[i];
+            uint32_t g = level_lut[(p >> 16u) & 0xffu];
+            uint32_t r = level_lut[(p >> 8u) & 0xffu];
+            uint32_t b = level_lut[p & 0xffu];
+            fractions |= g | r | b;
+            g += e[0];
+            r += e[1];
+            b += e[2];
+            e[0] = g;
+            e[1] = r;
+            e[2] = b;
+            out[i] = ((g & 0xff00u) << 16u) | ((r & 0xff00u) << 8u) | (b & 0xff00u);
+        }
+        // Without fractions in the colors shown, this frame is already exact
+        dither_frames = (fractions & 0xffu) ? dither_frames - 1u : 0;
+    } else {
+        // Rounded levels, for a strip that settled after a dithering cycle
+        dither_frames = 0;
+        for(uint32_t i=0; i<n; i++) {
+            uGRB32_t p = in[i];
+            out[i] = color_lut[0][(p >> 16u) & 0xffu]
+                   | color_lut[1][(p >> 8u) & 0xffu]
+                   | color_lut[2][p & 0xffu];
+        }
+    }
+
+    // Apply mask
+    if(mask_active) {
+        for(uint32_t i=0; i<n; i++) {
+            out[i] &= mask_words[i];
+        }
+    }
+}
+
+/**
+ * @brief Time until the strip can take a new frame, and at least WS2812B_COALESCE_US.
+ * @return Delay in microseconds.
  */
-static inline void ws2812b_write_blocking(uGRB32_t pixel_grb) {
-    pio_sm_put_blocking(config.pio, config.pio_sm, pixel_grb << 8u);
+static int64_t next_frame_delay_us() {
+    int64_t wait = (int64_t)(frame_start_us + config.frame_interval_us) - (int64_t)time_us_64();
+    return wait > WS2812B_COALESCE_US ? wait : WS2812B_COALESCE_US;
 }
 
 /**
  * @brief Render the LED strip.
- * @return True if rendering was successful, false otherwise.
+ * Runs from a one-shot alarm, scheduled only when there is something to send, so a static
+ * strip doesn't wake the CPU. A requested frame is prepared in the back buffer, then sent
+ * by DMA, paced by the PIO TX FIFO, as soon as the previous frame has been shifted out and
+ * latched. Neither step waits for the strip. While dithering, a new frame is prepared and
+ * sent whenever the strip is free, so the fractions average out over time. A dithering cycle
+ * after the last change averages them out exactly, then the rounded levels are sent and the
+ * alarm stops until the next request.
+ * @param id Alarm ID.
+ * @param user_data Unused.
+ * @return Microseconds until the next run, or 0 when there is nothing left to send.
  */
-static bool render() {
-    if(request_render) {
+static int64_t render(alarm_id_t id, void *user_data) {
+    bool strip_free = !dma_channel_is_busy(config.dma_chan)
+                      && time_us_64() - frame_start_us >= config.frame_interval_us;
+
+    if(request_render || (dither_frames > 0 && strip_free && !frame_ready)) {
         request_render = false;
-        for(uint32_t i=0; i<config.num_pixels; i++) {
-            uGRB32_t p = ws2812b_buffer[i];
-            uint8_t g = ((p >> 16u) & 0xffu);
-            uint8_t r = ((p >> 8u) & 0xffu);
-            uint8_t b = (p & 0xffu);
-            // Invert colors
-            if(config.inverted) {
-            g = 255 - g;
-            r = 255 - r;
-            b = 255 - b;
-            }
-            // Apply global dimming
-            g >>= config.global_dimming;
-            r >>= config.global_dimming;
-            b >>= config.global_dimming;
-            p = ws2812b_rgb(r, g, b);
-            // Apply mask
-            p *= config.global_mask[i];//mask(p, i, config.global_mask);
-            ws2812b_write_blocking(p);
-        }
+        prepare_frame(output_back);
+        frame_ready = true;
+    }
+
+    if(frame_ready && strip_free) {
+        uint32_t *next = output_back;
+        output_back = output_front;
+        output_front = next;
+        frame_ready = false;
+        frame_start_us = time_us_64();
+        dma_channel_transfer_from_buffer_now(config.dma_chan, output_front, config.num_pixels);
+    }
+
+    if(frame_ready || dither_frames > 0) {
+        return next_frame_delay_us();
+    }
+    render_scheduled = false;
+    return 0;
+}
+
+/**
+ * @brief Schedule the render alarm, unless it is already pending.
+ * Requests made while it is pending are sent together in the next frame.
+ */
+static void schedule_render() {
+    if(render_scheduled) return;
+    render_scheduled = true;
+    if(add_alarm_in_us(next_frame_delay_us(), render, NULL, true) <= 0) {
+        render_scheduled = false;
+    }
+}
+
+/**
+ * @brief Rebuild the lookup tables after inversion, dimming or brightness change.
+ */
+static void update_color_lut() {
+    // Brightness is perceptual, the scale applied to the LEDs follows the gamma curve
+    float scale = powf(config.brightness / 255.0f, WS2812B_GAMMA);
+    bool fractional = false;
+
+    for(uint32_t v=0; v<256; v++) {
+        uint8_t c = v;
+        // Invert colors
+        if(config.inverted) c = 255 - c;
+        // Apply global dimming
+        c >>= config.global_dimming;
+        // Apply brightness, keeping 8 more bits
+        uint16_t level = (uint16_t)(c * 256.0f * scale + 0.5f);
+        level_lut[v] = level;
+        fractional = fractional || (level & 0xffu);
+
+        // Levels without fractions are unchanged, the others are rounded once dithering stops
+        uint32_t high = (level + 0x80u) >> 8u;
+        color_lut[0][v] = high << 24u; // G
+        color_lut[1][v] = high << 16u; // R
+        color_lut[2][v] = high << 8u;  // B
     }
+    color_identity = !config.inverted && config.global_dimming == 0 && config.brightness == 255;
+    render_stale = true;
+
+    if(fractional && !dithering) {
+        memset(dither_error, 0, config.num_pixels * 3u);
+    }
+    dithering = fractional;
+    dither_frames = dithering ? DITHER_CYCLE_FRAMES + 1u : 0;
+
+    // Dithered frames are sent without render requests
+    if(dithering) schedule_render();
 }
 
 /**
@@ -228,25 +536,67 @@ void ws2812b_init(PIO _pio, uint8_t gpio, uint16_t _num_pixels) {
     ws2812_program_init(_pio, config.pio_sm, offset, gpio, WS2812B_FREQ_HZ, WS2812B_IS_RGBW);
     
     // Allocate memory to store pixel data
-    ws2812b_buffer = malloc(_num_pixels * sizeof(ws2812b_buffer));
+    ws2812b_buffer = malloc(_num_pixels * sizeof(uGRB32_t));
     for (uint32_t i = 0; i < _num_pixels; i++) {
         ws2812b_buffer[i] = 0;
     }
+    composite_buffer = malloc(_num_pixels * sizeof(uGRB32_t));
+    requested_buffer = calloc(_num_pixels, sizeof(uGRB32_t));
+
+    // Output buffers, sent to the PIO TX FIFO by DMA
+    output_front = calloc(_num_pixels, sizeof(uint32_t));
+    output_back = calloc(_num_pixels, sizeof(uint32_t));
+    config.frame_us = (uint32_t)((uint64_t)_num_pixels * 24u * 1000000u / WS2812B_FREQ_HZ) + WS2812B_DELAY_US;
+    config.frame_interval_us = config.frame_us > WS2812B_MIN_FRAME_US ? config.frame_us : WS2812B_MIN_FRAME_US;
+    config.dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config dma_config = dma_channel_get_default_config(config.dma_chan);
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_32);
+    channel_config_set_read_increment(&dma_config, true);
+    channel_config_set_write_increment(&dma_config, false);
+    channel_config_set_dreq(&dma_config, pio_get_dreq(_pio, config.pio_sm, true));
+    dma_channel_configure(config.dma_chan, &dma_config, &_pio->txf[config.pio_sm], output_front, 0, false);
+
+    // Color tables, at full brightness
+    dither_error = calloc(_num_pixels * 3u, sizeof(uint8_t));
+    config.brightness = 255;
+    update_color_lut();
 
     // Initialize masks
-    config.global_mask = malloc(_num_pixels * sizeof(uint8_t));
+    mask_words = malloc(_num_pixels * sizeof(uint32_t));
     no_mask = malloc(_num_pixels * sizeof(uint8_t));
     memset(no_mask, 1, _num_pixels);
     ws2812b_clear_mask();
+}
 
-    add_repeating_timer_ms(5, render, NULL, &rendering_timer); // A 5ms timer caps framerate to 200fps
+/**
+ * @brief Check if any running effect has a layer composited over the buffer.
+ */
+static bool effects_composited() {
+    for(uint8_t i=0; i<MAX_EFFECTS; i++) {
+        if(fxs[i].running && fxs[i].layer) return true;
+    }
+    return false;
 }
 
 /**
- * @brief Request a render of the current buffer state
+ * @brief Request a render of the current buffer state.
+ * A request that changes nothing on the strip is dropped, so callers can render on every
+ * loop without waking the CPU or restarting the dithering cycle.
  */
 void ws2812b_render() {
+    bool composited = effects_composited();
+    size_t size = config.num_pixels * sizeof(uGRB32_t);
+
+    if(!render_stale && !composited && memcmp(requested_buffer, ws2812b_buffer, size) == 0) {
+        return;
+    }
+    // The frame after the last effect ends still has to be sent, without its layer
+    render_stale = composited;
+    memcpy(requested_buffer, ws2812b_buffer, size);
+
     request_render = true;
+    if(dithering) dither_frames = DITHER_CYCLE_FRAMES + 1u;
+    schedule_render();
 }
 
 /**
@@ -290,7 +640,7 @@ void ws2812b_fill(uint32_t from, uint32_t to, uGRB32_t grb) {
  * @param grb 24-bit GRB color value
  */
 void ws2812b_fill_all(uGRB32_t grb) {
-    ws2812b_fill(0, config.num_pixels, grb);
+    ws2812b_fill(0, config.num_pixels - 1, grb);
 }
 
 /* Setters */
@@ -318,6 +668,7 @@ void ws2812b_set_fps(FX_t *FX, uint16_t fps) {
  */
 void ws2812b_set_inverted(bool inverted) {
     config.inverted = inverted;
+    update_color_lut();
 }
 
 /**
@@ -345,14 +696,32 @@ void ws2812b_set_callback(FX_t *FX, void (*callback)(void *user_data)) {
 void ws2812b_set_global_dimming(uint8_t dim) {
     if(dim > 7) dim = 7;
     config.global_dimming = dim;
+    update_color_lut();
+}
+
+/**
+ * @brief Set the global brightness, on a perceptual scale
+ * @param brightness Brightness level (0-255). Levels between the 8-bit steps of the LEDs
+ * are reached by temporal dithering: after each change or render request, frames keep being
+ * sent for a dithering cycle, then the strip settles on the rounded levels.
+ */
+void ws2812b_set_brightness(uint8_t brightness) {
+    config.brightness = brightness;
+    update_color_lut();
 }
 
 /**
  * @brief Set a custom mask for the WS2812B buffer
- * @param mask Array of mask values
+ * @param mask Array of mask values; pixels with a zero value are turned off.
+ * The mask is read once, later changes to the array need another call.
  */
 void ws2812b_set_mask(const uint8_t *mask) {
     config.global_mask = (uint8_t*)mask;
+    for(uint32_t i=0; i<config.num_pixels; i++) {
+        mask_words[i] = mask[i] ? 0xffffffffu : 0;
+    }
+    mask_active = true;
+    render_stale = true;
 }
 
 /**
@@ -360,6 +729,8 @@ void ws2812b_set_mask(const uint8_t *mask) {
  */
 void ws2812b_clear_mask() {
     config.global_mask = no_mask;
+    mask_active = false;
+    render_stale = true;
 }
 
 /* Text functions */
@@ -619,6 +990,34 @@ FX_t* ws2812b_spritesheet(const uGRB32_t **spritesheet, uint8_t frames,
 
 /* Procedural effects */
 
+/**
+ * @brief Set a pixel in an effect's layer
+ * @param FX Effect descriptor
+ * @param pixel Pixel index
+ * @param grb 24-bit GRB color value
+ */
+static void fx_put(FX_t *FX, uint32_t pixel, uGRB32_t grb) {
+    if(pixel < config.num_pixels) FX->layer[pixel] = grb | FX_OPAQUE;
+}
+
+/**
+ * @brief Fill a range of pixels in an effect's layer
+ * @param FX Effect descriptor
+ * @param from Start pixel index
+ * @param to End pixel index
+ * @param grb 24-bit GRB color value
+ */
+static void fx_fill(FX_t *FX, uint32_t from, uint32_t to, uGRB32_t grb) {
+    if(from > to) {
+        uint32_t temp = from;
+        from = to;
+        to = temp;
+    }
+    for(uint32_t i = from; i <= to; i++) {
+        fx_put(FX, i, grb);
+    }
+}
+
 /* FX_SCAN
 Draws a running pixel.
 colors[0]: effect
@@ -643,8 +1042,8 @@ static void fx_scan(void *user_data) {
         uint32_t f = ee2;
         p = f * FX->end / 0xff;
     }
-    ws2812b_buffer[p] = FX->colors[0];
-    if(last_p <0xffff) ws2812b_buffer[last_p] = FX->colors[1];
+    fx_put(FX, p, FX->colors[0]);
+    if(last_p <0xffff) fx_put(FX, last_p, FX->colors[1]);
     if(FX->ending) last_p = 0xffff;
     last_p = p;
 }
@@ -660,8 +1059,8 @@ param: not used
  */
 static void fx_wipe(void *user_data) {
     FX_t* FX = (FX_t*)user_data;
-    ws2812b_fill(((FX->dir == 1) ? FX->start : FX->end),
-                 FX->cursor, FX->colors[0]);
+    fx_fill(FX, ((FX->dir == 1) ? FX->start : FX->end),
+            FX->cursor, FX->colors[0]);
 }
 
 /* FX_RANDOM
@@ -677,7 +1076,7 @@ static void fx_random(void *user_data) {
     FX_t* FX = (FX_t*)user_data;
     for(uint32_t i = FX->from; i <= FX->to; i++) {
         uint8_t c = rand() % 8;
-        ws2812b_put(i, FX->colors[c]);
+        fx_put(FX, i, FX->colors[c]);
         // It's hallWS2812Bgenic!
     }
 }
@@ -694,7 +1093,7 @@ param: duration of the effect in steps
 static void fx_blink(void *user_data) {
     FX_t* FX = (FX_t*)user_data;
     bool is_odd = (FX->cursor) % 2;
-    ws2812b_fill(FX->from, FX->to, FX->colors[is_odd]);
+    fx_fill(FX, FX->from, FX->to, FX->colors[is_odd]);
 }
 
 /* FX_CHASER
@@ -712,7 +1111,7 @@ static void fx_chaser(void *user_data) {
     if (FX->param > 2 && FX->param <= 8) { wrap = FX->param;}
     for(uint32_t i = FX->start; i <= FX->end; i++) {
         uint8_t c = (FX->cursor + i) % wrap;
-        ws2812b_put(i, FX->colors[c]);
+        fx_put(FX, i, FX->colors[c]);
     }
 }
 
@@ -734,40 +1133,36 @@ static void fx_fade(void *user_data) {
     uint8_t b = FX->colors[0] & 0xffu;
     uint8_t brightness = (FX->dir ? FX->cursor : 100 - FX->cursor);
 
-    r = r * brightness / 100;
-    g = g * brightness / 100;
-    b = b * brightness / 100;
-    ws2812b_fill(FX->from, FX->to, ws2812b_rgb((uint8_t)r, (uint8_t)g, (uint8_t)b));
+    // x * 5243 >> 19 is x / 100 for x below 43699, without a division
+    r = (uint32_t)(r * brightness) * 5243u >> 19;
+    g = (uint32_t)(g * brightness) * 5243u >> 19;
+    b = (uint32_t)(b * brightness) * 5243u >> 19;
+    fx_fill(FX, FX->from, FX->to, ws2812b_rgb((uint8_t)r, (uint8_t)g, (uint8_t)b));
 }
 
 /**
- * @brief Step function for animations
- * @param id Alarm ID
- * @param user_data Effect descriptor
- * @return Time until the next call in microseconds
+ * @brief Step an animation
+ * @param FX Effect descriptor
  */
-static int64_t animation_step(alarm_id_t id, void *user_data) {
-    FX_t* FX = (FX_t*)user_data;
-
-    if(FX->canceled) {
+static void animation_step(FX_t *FX) {
+    if(FX->canceled) { // The last step stays in the buffer
+        blend_layer(FX, ws2812b_buffer);
         FX->running = false;
-        return 0;
+        return;
     }
 
     if(FX->ending) {
-        if(FX->clear_on_end) { // Cleanup
-            ws2812b_fill(FX->from, FX->to, 0x0);
-            ws2812b_render();
+        if(!FX->clear_on_end) { // Keep the result, otherwise the layer is just dropped
+            blend_layer(FX, ws2812b_buffer);
         }
         FX->callback(FX);
         FX->running = false;
         FX->ending = false;
-        return 0; // Stop the animation
+        return; // Stop the animation
     }
 
     // Call the actual effect function 
-    FX->fx_function(user_data);
-    ws2812b_render();
+    FX->fx_function(FX);
 
     FX->cursor += FX->dir; // Update the cursor position for the next step
     
@@ -778,8 +1173,74 @@ static int64_t animation_step(alarm_id_t id, void *user_data) {
             FX->ending = true;
         }
     }
+}
 
-    return FX->step_ms*1000;
+/**
+ * @brief Time until the next step of any running animation
+ * @param now Current time in microseconds
+ * @return Delay in microseconds, or 0 when no animation is running
+ */
+static int64_t next_animation_delay_us(uint64_t now) {
+    uint64_t next = UINT64_MAX;
+
+    for(uint8_t i=0; i<MAX_EFFECTS; i++) {
+        if(fxs[i].running && fxs[i].next_us < next) next = fxs[i].next_us;
+    }
+    if(next == UINT64_MAX) return 0;
+    return next > now ? (int64_t)(next - now) : 1;
+}
+
+/**
+ * @brief Animation scheduler: steps, in one pass, every animation due before the
+ * next frame could start, then requests a single render for all of them
+ * @param id Alarm ID
+ * @param user_data Unused
+ * @return Time until the next call in microseconds, or 0 when no animation is running
+ */
+static int64_t animation_tick(alarm_id_t id, void *user_data) {
+    uint64_t now = time_us_64();
+    uint64_t horizon = now + config.frame_interval_us;
+    bool stepped = false;
+
+    for(uint8_t i=0; i<MAX_EFFECTS; i++) {
+        FX_t *FX = &fxs[i];
+        if(!FX->running || FX->next_us > horizon) continue;
+
+        animation_step(FX);
+        uint64_t step_us = (FX->step_ms ? FX->step_ms : 1) * 1000u;
+        FX->next_us += step_us;
+        if(FX->next_us <= now) { // Late steps are skipped, not replayed
+            FX->next_us += ((now - FX->next_us) / step_us + 1) * step_us;
+        }
+        stepped = true;
+    }
+    if(stepped) ws2812b_render();
+
+    int64_t delay = next_animation_delay_us(now);
+    if(!delay) animation_timer = 0;
+    return delay;
+}
+
+/**
+ * @brief Time of the first step of a new animation, on the same time grid as the running ones,
+ * so that animations started apart still step in the same frame
+ * @param step_ms Step time in milliseconds
+ * @return Time in microseconds
+ */
+static uint64_t first_step_us(uint32_t step_ms) {
+    uint64_t now = time_us_64();
+    uint64_t step_us = (step_ms ? step_ms : 1) * 1000u;
+
+    if(!next_animation_delay_us(now)) animation_epoch_us = now;
+    return animation_epoch_us + ((now - animation_epoch_us) / step_us + 1) * step_us;
+}
+
+/**
+ * @brief Restart the animation scheduler, after an animation is added
+ */
+static void schedule_animations() {
+    if(animation_timer) cancel_alarm(animation_timer);
+    animation_timer = add_alarm_in_us(next_animation_delay_us(time_us_64()), animation_tick, NULL, true);
 }
 
 /**
@@ -795,6 +1256,11 @@ static int64_t animation_step(alarm_id_t id, void *user_data) {
 FX_t* ws2812b_animate(uint32_t from, uint32_t to, FX_mode_t mode,
                     const uGRB32_t colors[8], uint32_t loops, uint32_t param) {
     uint8_t seg_id = get_available_segment();
+    fxs[seg_id].running = false; // Not composited while it is set up
+    if(!fxs[seg_id].layer) fxs[seg_id].layer = malloc(config.num_pixels * sizeof(uGRB32_t));
+    memset(fxs[seg_id].layer, 0, config.num_pixels * sizeof(uGRB32_t));
+    fxs[seg_id].blend = FX_BLEND_REPLACE;
+    fxs[seg_id].alpha = 255;
     fxs[seg_id].from = from;
     fxs[seg_id].to = to;
     fxs[seg_id].cursor = from;
@@ -810,7 +1276,6 @@ FX_t* ws2812b_animate(uint32_t from, uint32_t to, FX_mode_t mode,
     fxs[seg_id].loop_counter = 0;
     fxs[seg_id].step_ms = config.animation_step_ms;
     fxs[seg_id].callback = noop;
-    fxs[seg_id].running = true;
     fxs[seg_id].ending = false;
     fxs[seg_id].canceled = false;
     fxs[seg_id].clear_on_end = true;
@@ -850,8 +1315,9 @@ FX_t* ws2812b_animate(uint32_t from, uint32_t to, FX_mode_t mode,
             fxs[seg_id].clear_on_end = false;
             break;
     }
-    if(animation_timers[seg_id]) cancel_alarm(animation_timers[seg_id]);
-    animation_timers[seg_id] = add_alarm_in_ms(config.animation_step_ms, animation_step, &fxs[seg_id], false);
+    fxs[seg_id].next_us = first_step_us(config.animation_step_ms);
+    fxs[seg_id].running = true;
+    schedule_animations();
     return &fxs[seg_id];
 }
 
@@ -863,6 +1329,17 @@ void ws2812b_cancel(FX_t* FX){
     FX->canceled = true;
 }
 
+/**
+ * @brief Set how an effect is composited over the pixels below it
+ * @param FX Effect descriptor
+ * @param blend Blend mode
+ * @param alpha Opacity for FX_BLEND_ALPHA (0-255)
+ */
+void ws2812b_set_blend(FX_t *FX, FX_blend_t blend, uint8_t alpha) {
+    FX->blend = blend;
+    FX->alpha = alpha;
+}
+
 void invert_matrix_vertical(uint8_t* matrix, int rows, int cols) {
     for (int i = 0; i < rows / 2; i++) {
         for (int j = 0; j < cols; j++) {
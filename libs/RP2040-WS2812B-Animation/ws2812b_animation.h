@@ -33,11 +33,33 @@ extern "C" {
  */
 #define WS2812B_DELAY_US 300
 
+/**
+ * @def WS2812B_MIN_FRAME_US
+ * @brief Minimum time between the start of two frames, capping the framerate to 200fps.
+ */
+#define WS2812B_MIN_FRAME_US 5000
+
+/**
+ * @def WS2812B_COALESCE_US
+ * @brief Minimum delay between a render request and its frame, so that requests made
+ * close together are sent in a single frame.
+ */
+#define WS2812B_COALESCE_US 1000
+
+/**
+ * @def WS2812B_GAMMA
+ * @brief Gamma curve applied by ws2812b_set_brightness().
+ */
+#define WS2812B_GAMMA 2.2f
+
 /**
  * @def MAX_EFFECTS
- * @brief Maximum number of simultaneous sections with independent effects.
+ * @brief Size of the pool of simultaneous sections with independent effects.
+ * Can be overridden with a compile definition. Each slot in use takes a layer of 4 bytes per pixel.
  */
-#define MAX_EFFECTS 4
+#ifndef MAX_EFFECTS
+#define MAX_EFFECTS 8
+#endif
 
 /**
  * @typedef uGRB32_t
@@ -58,6 +80,17 @@ typedef enum {
     FX_FADE         = 5,
 } FX_mode_t;
 
+/**
+ * @enum FX_blend_t
+ * @brief Enumerated type for the ways an effect is composited over what is below it.
+ */
+typedef enum {
+    FX_BLEND_REPLACE = 0,   // The effect's pixels replace the ones below
+    FX_BLEND_ADD     = 1,   // Channels are added, saturating at 255
+    FX_BLEND_MAX     = 2,   // The brightest value of each channel is kept
+    FX_BLEND_ALPHA   = 3,   // Mixed with the pixels below, by the effect's alpha
+} FX_blend_t;
+
 /**
  * @struct FX_t
  * @brief Structure representing an animation effect.
@@ -177,6 +210,26 @@ typedef struct FX_t {
      * @brief Number of frames for the animation effect (only applicable for sequence-based effects).
      */
     uint8_t frames;
+
+    /**
+     * @brief Blend mode used to composite the animation effect.
+     */
+    FX_blend_t blend;
+
+    /**
+     * @brief Opacity for FX_BLEND_ALPHA (0-255).
+     */
+    uint8_t alpha;
+
+    /**
+     * @brief Pixels drawn by the animation effect; the top byte flags the pixels it has written.
+     */
+    uGRB32_t *layer;
+
+    /**
+     * @brief Time of the next step of the animation effect, in microseconds.
+     */
+    uint64_t next_us;
 } FX_t;
 
 /**
@@ -223,6 +276,26 @@ struct ws2812b_config {
      * @brief Global dimming value for the LED strip.
      */
     uint8_t global_dimming;
+
+    /**
+     * @brief Global brightness for the LED strip, on a perceptual scale.
+     */
+    uint8_t brightness;
+
+    /**
+     * @brief DMA channel feeding the PIO TX FIFO.
+     */
+    int dma_chan;
+
+    /**
+     * @brief Time to shift out a whole frame and latch it, in microseconds.
+     */
+    uint32_t frame_us;
+
+    /**
+     * @brief Minimum time between the start of two frames, in microseconds.
+     */
+    uint32_t frame_interval_us;
 };
 
 /**
@@ -250,6 +323,15 @@ uGRB32_t ws2812b_hex(uint32_t hex);
  */
 uGRB32_t ws2812b_hsv(float _h, float _s, float _v);
 
+/**
+ * @brief Create a 24-bit color from 8-bit HSV values, without floating point.
+ * @param h Hue (0-255 for the whole circle).
+ * @param s Saturation (0-255).
+ * @param v Value (0-255).
+ * @return 24-bit color value.
+ */
+uGRB32_t ws2812b_hsv8(uint8_t h, uint8_t s, uint8_t v);
+
 /**
  * @brief Create a random 24-bit color.
  * @param value Value (0.0-100.0).
@@ -335,6 +417,12 @@ void ws2812b_set_callback(FX_t* FX, void (*callback)(void *user_data));
  */
 void ws2812b_set_global_dimming(uint8_t dim);
 
+/**
+ * @brief Set the global brightness for the LED strip, gamma corrected and dithered.
+ * @param brightness Brightness level (0-255).
+ */
+void ws2812b_set_brightness(uint8_t brightness);
+
 /**
  * @brief Set the global mask for the LED strip.
  * @param mask Mask value.
@@ -389,6 +477,14 @@ FX_t* ws2812b_animate(uint32_t from, uint32_t to, FX_mode_t mode,
  */
 void ws2812b_cancel(FX_t* FX);
 
+/**
+ * @brief Set how an animation effect is composited over the pixels below it.
+ * @param FX Effect structure.
+ * @param blend Blend mode.
+ * @param alpha Opacity for FX_BLEND_ALPHA (0-255).
+ */
+void ws2812b_set_blend(FX_t *FX, FX_blend_t blend, uint8_t alpha);
+
 /**
  * @brief Create a text typing effect.
  * @param str Text string.
@@ -49,6 +49,15 @@
 #include <locale.h>
 #endif
 
+/* vector instructions for scanning strings and whitespace, define CJSON_NO_SIMD to only scan a word at a time */
+#if !defined(CJSON_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define CJSON_SIMD_SSE2
+#include <emmintrin.h>
+#elif !defined(CJSON_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define CJSON_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 #if defined(_MSC_VER)
 #pragma warning (pop)
 #endif
@@ -85,6 +94,31 @@
 #endif
 #endif
 
+/* Converting numbers without strtod and sprintf needs IEEE 754 doubles and a 64 bit integer type, which C89 doesn't have.
+ * Define CJSON_NO_FAST_NUMBERS to always convert them with strtod and sprintf. */
+#if !defined(CJSON_NO_FAST_NUMBERS) && (FLT_RADIX == 2) && (DBL_MANT_DIG == 53) && (DBL_MAX_EXP == 1024)
+#if ULONG_MAX > 0xFFFFFFFFUL
+typedef unsigned long cjson_uint64;
+#define CJSON_FAST_NUMBERS
+#elif defined(__GNUC__)
+__extension__ typedef unsigned long long cjson_uint64;
+#define CJSON_FAST_NUMBERS
+#elif defined(_MSC_VER)
+typedef unsigned __int64 cjson_uint64;
+#define CJSON_FAST_NUMBERS
+#endif
+#endif
+
+#ifdef CJSON_FAST_NUMBERS
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 cjson_uint128;
+#endif
+/* no excess precision, so one operation on exact doubles is correctly rounded */
+#if (defined(__FLT_EVAL_METHOD__) && (__FLT_EVAL_METHOD__ == 0)) || defined(_M_X64) || defined(_M_ARM64)
+#define CJSON_EXACT_DOUBLE_ARITHMETIC
+#endif
+#endif
+
 typedef struct {
     const unsigned char *json;
     size_t position;
@@ -237,969 +271,3391 @@ CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
     }
 }
 
-/* Internal constructor. */
-static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
-{
-    cJSON* node = (cJSON*)hooks->allocate(sizeof(cJSON));
-    if (node)
-    {
-        memset(node, '\0', sizeof(cJSON));
-    }
-
-    return node;
-}
+static void* cast_away_const(const void* string);
 
-/* Delete a cJSON structure. */
-CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
+#ifdef CJSON_INDEX
+typedef struct
 {
-    cJSON *next = NULL;
-    while (item != NULL)
+    cJSON *item;
+    unsigned long hash;
+} index_entry;
+
+/* Index over the children of an object or array, the type of the owner tells which part is used.
+ * Objects use an open addressing hash table. Members are inserted in list order,
+ * so probing finds duplicate names in the same order as walking the list.
+ * Arrays use a vector of their items in list order. */
+struct cJSON_Index
+{
+    /* first and last child when the index was last updated, to notice direct list manipulation */
+    const cJSON *first;
+    const cJSON *last;
+    size_t count;
+    size_t mask; /* number of slots - 1, the number of slots is a power of two */
+    index_entry *entries;
+    size_t capacity; /* number of slots in items */
+    cJSON **items;
+};
+
+static void index_free(cJSON * const item)
+{
+    if (item->index != NULL)
     {
-        next = item->next;
-        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
-        {
-            cJSON_Delete(item->child);
-        }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
-        {
-            global_hooks.deallocate(item->valuestring);
-            item->valuestring = NULL;
-        }
-        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
-        {
-            global_hooks.deallocate(item->string);
-            item->string = NULL;
-        }
-        global_hooks.deallocate(item);
-        item = next;
+        global_hooks.deallocate(item->index);
+        item->index = NULL;
     }
 }
 
-/* get the decimal point character of the current locale */
-static unsigned char get_decimal_point(void)
+/* The index is stale if the first or last child changed without going through the cJSON functions. */
+static cJSON_bool index_is_current(const cJSON * const item)
 {
-#ifdef ENABLE_LOCALES
-    struct lconv *lconv = localeconv();
-    return (unsigned char) lconv->decimal_point[0];
+    return (item->child != NULL) && (item->index->first == item->child) && (item->index->last == item->child->prev);
+}
 #else
-    return '.';
+#define index_free(item)
 #endif
-}
 
-typedef struct
+#ifdef CJSON_OBJECT_INDEX
+
+/* FNV-1a of the lowercase name, so that case insensitive matches land in the same chain */
+static unsigned long hash_name(const unsigned char *name)
 {
-    const unsigned char *content;
-    size_t length;
-    size_t offset;
-    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
-    internal_hooks hooks;
-} parse_buffer;
+    unsigned long hash = 2166136261UL;
 
-/* check if the given size is left to read in a given parse buffer (starting with 1) */
-#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
-/* check if the buffer can be accessed at the given index (starting with 0) */
-#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
-#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
-/* get a pointer to the buffer at the position */
-#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+    for (; *name != '\0'; name++)
+    {
+        hash ^= (unsigned long)tolower(*name);
+        hash *= 16777619UL;
+    }
 
-/* Parse the input text to generate a number, and populate the result into item. */
-static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+    return hash;
+}
+
+static void object_index_insert(struct cJSON_Index * const index, cJSON * const item)
 {
-    double number = 0;
-    unsigned char *after_end = NULL;
-    unsigned char number_c_string[64];
-    unsigned char decimal_point = get_decimal_point();
-    size_t i = 0;
+    unsigned long hash = hash_name((const unsigned char*)item->string);
+    size_t slot = (size_t)hash & index->mask;
 
-    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    while (index->entries[slot].item != NULL)
     {
-        return false;
+        slot = (slot + 1) & index->mask;
     }
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; (i < (sizeof(number_c_string) - 1)) && can_access_at_index(input_buffer, i); i++)
-    {
-        switch (buffer_at_offset(input_buffer)[i])
-        {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_c_string[i] = buffer_at_offset(input_buffer)[i];
-                break;
+    index->entries[slot].item = item;
+    index->entries[slot].hash = hash;
+    index->count++;
+    index->last = item;
+}
 
-            case '.':
-                number_c_string[i] = decimal_point;
-                break;
+/* Build the index of an object, returns NULL for small objects or members without a name. */
+static struct cJSON_Index *object_index_build(const cJSON * const object)
+{
+    struct cJSON_Index *index = NULL;
+    cJSON *current_item = NULL;
+    size_t count = 0;
+    size_t slots = 1;
 
-            default:
-                goto loop_end;
+    for (current_item = object->child; current_item != NULL; current_item = current_item->next)
+    {
+        if (current_item->string == NULL)
+        {
+            return NULL;
         }
+        count++;
     }
-loop_end:
-    number_c_string[i] = '\0';
 
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+    if (count < CJSON_OBJECT_INDEX_THRESHOLD)
     {
-        return false; /* parse_error */
+        return NULL;
     }
 
-    item->valuedouble = number;
-
-    /* use saturation in case of overflow */
-    if (number >= INT_MAX)
+    /* keep the load factor at or below one half */
+    while (slots < (count * 2))
     {
-        item->valueint = INT_MAX;
+        slots *= 2;
     }
-    else if (number <= (double)INT_MIN)
+
+    index = (struct cJSON_Index*)global_hooks.allocate(sizeof(struct cJSON_Index) + (slots * sizeof(index_entry)));
+    if (index == NULL)
     {
-        item->valueint = INT_MIN;
+        return NULL;
     }
-    else
+
+    index->first = object->child;
+    index->count = 0;
+    index->mask = slots - 1;
+    index->entries = (index_entry*)(index + 1);
+    memset(index->entries, '\0', slots * sizeof(index_entry));
+
+    for (current_item = object->child; current_item != NULL; current_item = current_item->next)
     {
-        item->valueint = (int)number;
+        object_index_insert(index, current_item);
     }
 
-    item->type = cJSON_Number;
-
-    input_buffer->offset += (size_t)(after_end - number_c_string);
-    return true;
+    return index;
 }
 
-/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
-CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+/* Keep the index up to date when a member is appended, or drop it if it is full. */
+static void object_index_append(cJSON * const object, cJSON * const item)
 {
-    if (number >= INT_MAX)
+    struct cJSON_Index *index = object->index;
+
+    if (index == NULL)
     {
-        object->valueint = INT_MAX;
+        return;
     }
-    else if (number <= (double)INT_MIN)
+
+    if ((item->string == NULL) || (index->last != item->prev) || (((index->count + 1) * 2) > (index->mask + 1)))
     {
-        object->valueint = INT_MIN;
+        index_free(object);
+        return;
     }
-    else
+
+    object_index_insert(index, item);
+}
+
+static cJSON *object_index_lookup(const struct cJSON_Index * const index, const char * const name, const cJSON_bool case_sensitive)
+{
+    unsigned long hash = hash_name((const unsigned char*)name);
+    size_t slot = (size_t)hash & index->mask;
+    cJSON *item = NULL;
+
+    for (item = index->entries[slot].item; item != NULL; item = index->entries[slot].item)
     {
-        object->valueint = (int)number;
+        if (index->entries[slot].hash == hash)
+        {
+            if (case_sensitive ? (strcmp(name, item->string) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)item->string) == 0))
+            {
+                return item;
+            }
+        }
+        slot = (slot + 1) & index->mask;
     }
 
-    return object->valuedouble = number;
+    return NULL;
 }
+#else
+#define object_index_append(object, item)
+#endif
 
-/* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
-CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+#ifdef CJSON_ARRAY_INDEX
+static struct cJSON_Index *array_index_allocate(const size_t capacity)
 {
-    char *copy = NULL;
-    size_t v1_len;
-    size_t v2_len;
-    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
-    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    struct cJSON_Index *index = (struct cJSON_Index*)global_hooks.allocate(sizeof(struct cJSON_Index) + (capacity * sizeof(cJSON*)));
+    if (index == NULL)
     {
         return NULL;
     }
-    /* return NULL if the object is corrupted or valuestring is NULL */
-    if (object->valuestring == NULL || valuestring == NULL)
+
+    memset(index, '\0', sizeof(struct cJSON_Index));
+    index->capacity = capacity;
+    index->items = (cJSON**)(index + 1);
+
+    return index;
+}
+
+/* Build the index of an array, returns NULL for small arrays. */
+static struct cJSON_Index *array_index_build(const cJSON * const array)
+{
+    struct cJSON_Index *index = NULL;
+    cJSON *current_item = NULL;
+    size_t count = 0;
+
+    for (current_item = array->child; current_item != NULL; current_item = current_item->next)
     {
-        return NULL;
+        count++;
     }
 
-    v1_len = strlen(valuestring);
-    v2_len = strlen(object->valuestring);
-
-    if (v1_len <= v2_len)
+    if (count < CJSON_ARRAY_INDEX_THRESHOLD)
     {
-        /* strcpy does not handle overlapping string: [X1, X2] [Y1, Y2] => X2 < Y1 or Y2 < X1 */
-        if (!( valuestring + v1_len < object->valuestring || object->valuestring + v2_len < valuestring ))
-        {
-            return NULL;
-        }
-        strcpy(object->valuestring, valuestring);
-        return object->valuestring;
+        return NULL;
     }
-    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
-    if (copy == NULL)
+
+    index = array_index_allocate(count);
+    if (index == NULL)
     {
         return NULL;
     }
-    if (object->valuestring != NULL)
+
+    for (current_item = array->child; current_item != NULL; current_item = current_item->next)
     {
-        cJSON_free(object->valuestring);
+        index->items[index->count++] = current_item;
     }
-    object->valuestring = copy;
+    index->first = array->child;
+    index->last = array->child->prev;
 
-    return copy;
+    return index;
 }
 
-typedef struct
-{
-    unsigned char *buffer;
-    size_t length;
-    size_t offset;
-    size_t depth; /* current nesting depth (for formatted printing) */
-    cJSON_bool noalloc;
-    cJSON_bool format; /* is this print a formatted print */
-    internal_hooks hooks;
-} printbuffer;
-
-/* realloc printbuffer if necessary to have at least "needed" bytes more */
-static unsigned char* ensure(printbuffer * const p, size_t needed)
+/* Returns the index of an array if it has a current one, a stale index is dropped. */
+static struct cJSON_Index *array_index_get(const cJSON * const array)
 {
-    unsigned char *newbuffer = NULL;
-    size_t newsize = 0;
-
-    if ((p == NULL) || (p->buffer == NULL))
+    /* references share their items with another array that may change them, don't index those */
+    if (!cJSON_IsArray(array) || (array->type & cJSON_IsReference) || (array->index == NULL))
     {
         return NULL;
     }
 
-    if ((p->length > 0) && (p->offset >= p->length))
+    if (!index_is_current(array))
     {
-        /* make sure that offset is valid */
-        return NULL;
+        index_free((cJSON*)cast_away_const(array));
     }
 
-    if (needed > INT_MAX)
+    return array->index;
+}
+
+/* Called by the walks over an array once they reached the threshold, so small arrays are never counted. */
+static struct cJSON_Index *array_index_create(const cJSON * const array)
+{
+    cJSON *mutable_array = (cJSON*)cast_away_const(array);
+
+    if (!cJSON_IsArray(array) || (array->type & cJSON_IsReference))
     {
-        /* sizes bigger than INT_MAX are currently not supported */
         return NULL;
     }
 
-    needed += p->offset + 1;
-    if (needed <= p->length)
+    mutable_array->index = array_index_build(array);
+
+    return array->index;
+}
+
+/* Keep the index up to date when an item is appended, the vector grows by doubling. */
+static void array_index_append(cJSON * const array, cJSON * const item)
+{
+    struct cJSON_Index *index = array->index;
+    struct cJSON_Index *grown = NULL;
+
+    if (index == NULL)
     {
-        return p->buffer + p->offset;
+        return;
     }
 
-    if (p->noalloc) {
-        return NULL;
+    if (index->last != item->prev)
+    {
+        index_free(array);
+        return;
     }
 
-    /* calculate new buffer size */
-    if (needed > (INT_MAX / 2))
+    if (index->count == index->capacity)
     {
-        /* overflow of int, use INT_MAX if possible */
-        if (needed <= INT_MAX)
-        {
-            newsize = INT_MAX;
-        }
-        else
+        grown = array_index_allocate(index->capacity * 2);
+        if (grown == NULL)
         {
-            return NULL;
+            index_free(array);
+            return;
         }
+
+        memcpy(grown->items, index->items, index->count * sizeof(cJSON*));
+        grown->first = index->first;
+        grown->count = index->count;
+        global_hooks.deallocate(index);
+        array->index = index = grown;
     }
-    else
+
+    index->items[index->count++] = item;
+    index->last = item;
+}
+
+/* Remove an item from the index, has to be called while the item is still linked into the array. */
+static void array_index_remove(cJSON * const array, const cJSON * const item)
+{
+    struct cJSON_Index *index = array->index;
+    size_t position = 0;
+
+    if (index == NULL)
     {
-        newsize = needed * 2;
+        return;
     }
 
-    if (p->hooks.reallocate != NULL)
+    if (!index_is_current(array) || (index->count == 1))
     {
-        /* reallocate with realloc if available */
-        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
-        if (newbuffer == NULL)
-        {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
+        index_free(array);
+        return;
+    }
 
-            return NULL;
-        }
+    /* search from the end, so removing the last item is constant time */
+    for (position = index->count; (position > 0) && (index->items[position - 1] != item); position--)
+    {
     }
-    else
+    if (position == 0)
     {
-        /* otherwise reallocate manually */
-        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
-        if (!newbuffer)
-        {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
-            return NULL;
-        }
-
-        memcpy(newbuffer, p->buffer, p->offset + 1);
-        p->hooks.deallocate(p->buffer);
+        /* not an item of this array */
+        index_free(array);
+        return;
     }
-    p->length = newsize;
-    p->buffer = newbuffer;
+    position--;
 
-    return newbuffer + p->offset;
+    memmove(&index->items[position], &index->items[position + 1], (index->count - position - 1) * sizeof(cJSON*));
+    index->count--;
+    index->first = index->items[0];
+    index->last = index->items[index->count - 1];
 }
+#else
+#define array_index_append(array, item)
+#define array_index_remove(array, item)
+#endif
 
-/* calculate the new length of the string in a printbuffer and update the offset */
-static void update_offset(printbuffer * const buffer)
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *item)
 {
-    const unsigned char *buffer_pointer = NULL;
-    if ((buffer == NULL) || (buffer->buffer == NULL))
+    if (item == NULL)
     {
         return;
     }
-    buffer_pointer = buffer->buffer + buffer->offset;
 
-    buffer->offset += strlen((const char*)buffer_pointer);
+    index_free(item);
 }
 
-/* securely comparison of floating-point variables */
-static cJSON_bool compare_double(double a, double b)
+/* Internal constructor. */
+static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
 {
-    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
-    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+    cJSON* node = (cJSON*)hooks->allocate(sizeof(cJSON));
+    if (node)
+    {
+        memset(node, '\0', sizeof(cJSON));
+    }
+
+    return node;
 }
 
-/* Render the number nicely from the given item into a string. */
-static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+/* Delete a cJSON structure. */
+CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
-    int length = 0;
-    size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
-
-    if (output_buffer == NULL)
+    cJSON *next = NULL;
+    while (item != NULL)
     {
-        return false;
+        next = item->next;
+        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
+        {
+            cJSON_Delete(item->child);
+        }
+        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+        {
+            global_hooks.deallocate(item->valuestring);
+            item->valuestring = NULL;
+        }
+        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
+        {
+            global_hooks.deallocate(item->string);
+            item->string = NULL;
+        }
+        index_free(item);
+        global_hooks.deallocate(item);
+        item = next;
     }
+}
 
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+/* get the decimal point character of the current locale */
+static unsigned char get_decimal_point(void)
+{
+#ifdef ENABLE_LOCALES
+    struct lconv *lconv = localeconv();
+    return (unsigned char) lconv->decimal_point[0];
+#else
+    return '.';
+#endif
+}
+
+#ifdef CJSON_FAST_NUMBERS
+#define U64(high, low) ((((cjson_uint64)(high)) << 32) | (cjson_uint64)(low))
+#define POW10_TABLE_MIN (-342)
+#define POW10_TABLE_MAX 324
+
+/* Normalized 128 bit significands of 10^q for q from POW10_TABLE_MIN to POW10_TABLE_MAX, high half first.
+ * 10^q has the same significand as 5^q. Positive powers are truncated, negative powers are
+ * floor(2^b / 5^-q) + 1, as required by the Eisel-Lemire algorithm. Rounding the high half
+ * with the top bit of the low half gives the correctly rounded 64 bit significand Grisu needs. */
+static const cjson_uint64 pow10_significands[POW10_TABLE_MAX - POW10_TABLE_MIN + 1][2] =
+{
+    {U64(0xeef453d6, 0x923bd65a), U64(0x113faa29, 0x06a13b3f)},
+    {U64(0x9558b466, 0x1b6565f8), U64(0x4ac7ca59, 0xa424c507)},
+    {U64(0xbaaee17f, 0xa23ebf76), U64(0x5d79bcf0, 0x0d2df649)},
+    {U64(0xe95a99df, 0x8ace6f53), U64(0xf4d82c2c, 0x107973dc)},
+    {U64(0x91d8a02b, 0xb6c10594), U64(0x79071b9b, 0x8a4be869)},
+    {U64(0xb64ec836, 0xa47146f9), U64(0x9748e282, 0x6cdee284)},
+    {U64(0xe3e27a44, 0x4d8d98b7), U64(0xfd1b1b23, 0x08169b25)},
+    {U64(0x8e6d8c6a, 0xb0787f72), U64(0xfe30f0f5, 0xe50e20f7)},
+    {U64(0xb208ef85, 0x5c969f4f), U64(0xbdbd2d33, 0x5e51a935)},
+    {U64(0xde8b2b66, 0xb3bc4723), U64(0xad2c7880, 0x35e61382)},
+    {U64(0x8b16fb20, 0x3055ac76), U64(0x4c3bcb50, 0x21afcc31)},
+    {U64(0xaddcb9e8, 0x3c6b1793), U64(0xdf4abe24, 0x2a1bbf3d)},
+    {U64(0xd953e862, 0x4b85dd78), U64(0xd71d6dad, 0x34a2af0d)},
+    {U64(0x87d4713d, 0x6f33aa6b), U64(0x8672648c, 0x40e5ad68)},
+    {U64(0xa9c98d8c, 0xcb009506), U64(0x680efdaf, 0x511f18c2)},
+    {U64(0xd43bf0ef, 0xfdc0ba48), U64(0x0212bd1b, 0x2566def2)},
+    {U64(0x84a57695, 0xfe98746d), U64(0x014bb630, 0xf7604b57)},
+    {U64(0xa5ced43b, 0x7e3e9188), U64(0x419ea3bd, 0x35385e2d)},
+    {U64(0xcf42894a, 0x5dce35ea), U64(0x52064cac, 0x828675b9)},
+    {U64(0x818995ce, 0x7aa0e1b2), U64(0x7343efeb, 0xd1940993)},
+    {U64(0xa1ebfb42, 0x19491a1f), U64(0x1014ebe6, 0xc5f90bf8)},
+    {U64(0xca66fa12, 0x9f9b60a6), U64(0xd41a26e0, 0x77774ef6)},
+    {U64(0xfd00b897, 0x478238d0), U64(0x8920b098, 0x955522b4)},
+    {U64(0x9e20735e, 0x8cb16382), U64(0x55b46e5f, 0x5d5535b0)},
+    {U64(0xc5a89036, 0x2fddbc62), U64(0xeb2189f7, 0x34aa831d)},
+    {U64(0xf712b443, 0xbbd52b7b), U64(0xa5e9ec75, 0x01d523e4)},
+    {U64(0x9a6bb0aa, 0x55653b2d), U64(0x47b233c9, 0x2125366e)},
+    {U64(0xc1069cd4, 0xeabe89f8), U64(0x999ec0bb, 0x696e840a)},
+    {U64(0xf148440a, 0x256e2c76), U64(0xc00670ea, 0x43ca250d)},
+    {U64(0x96cd2a86, 0x5764dbca), U64(0x38040692, 0x6a5e5728)},
+    {U64(0xbc807527, 0xed3e12bc), U64(0xc6050837, 0x04f5ecf2)},
+    {U64(0xeba09271, 0xe88d976b), U64(0xf7864a44, 0xc633682e)},
+    {U64(0x93445b87, 0x31587ea3), U64(0x7ab3ee6a, 0xfbe0211d)},
+    {U64(0xb8157268, 0xfdae9e4c), U64(0x5960ea05, 0xbad82964)},
+    {U64(0xe61acf03, 0x3d1a45df), U64(0x6fb92487, 0x298e33bd)},
+    {U64(0x8fd0c162, 0x06306bab), U64(0xa5d3b6d4, 0x79f8e056)},
+    {U64(0xb3c4f1ba, 0x87bc8696), U64(0x8f48a489, 0x9877186c)},
+    {U64(0xe0b62e29, 0x29aba83c), U64(0x331acdab, 0xfe94de87)},
+    {U64(0x8c71dcd9, 0xba0b4925), U64(0x9ff0c08b, 0x7f1d0b14)},
+    {U64(0xaf8e5410, 0x288e1b6f), U64(0x07ecf0ae, 0x5ee44dd9)},
+    {U64(0xdb71e914, 0x32b1a24a), U64(0xc9e82cd9, 0xf69d6150)},
+    {U64(0x892731ac, 0x9faf056e), U64(0xbe311c08, 0x3a225cd2)},
+    {U64(0xab70fe17, 0xc79ac6ca), U64(0x6dbd630a, 0x48aaf406)},
+    {U64(0xd64d3d9d, 0xb981787d), U64(0x092cbbcc, 0xdad5b108)},
+    {U64(0x85f04682, 0x93f0eb4e), U64(0x25bbf560, 0x08c58ea5)},
+    {U64(0xa76c5823, 0x38ed2621), U64(0xaf2af2b8, 0x0af6f24e)},
+    {U64(0xd1476e2c, 0x07286faa), U64(0x1af5af66, 0x0db4aee1)},
+    {U64(0x82cca4db, 0x847945ca), U64(0x50d98d9f, 0xc890ed4d)},
+    {U64(0xa37fce12, 0x6597973c), U64(0xe50ff107, 0xbab528a0)},
+    {U64(0xcc5fc196, 0xfefd7d0c), U64(0x1e53ed49, 0xa96272c8)},
+    {U64(0xff77b1fc, 0xbebcdc4f), U64(0x25e8e89c, 0x13bb0f7a)},
+    {U64(0x9faacf3d, 0xf73609b1), U64(0x77b19161, 0x8c54e9ac)},
+    {U64(0xc795830d, 0x75038c1d), U64(0xd59df5b9, 0xef6a2417)},
+    {U64(0xf97ae3d0, 0xd2446f25), U64(0x4b057328, 0x6b44ad1d)},
+    {U64(0x9becce62, 0x836ac577), U64(0x4ee367f9, 0x430aec32)},
+    {U64(0xc2e801fb, 0x244576d5), U64(0x229c41f7, 0x93cda73f)},
+    {U64(0xf3a20279, 0xed56d48a), U64(0x6b435275, 0x78c1110f)},
+    {U64(0x9845418c, 0x345644d6), U64(0x830a1389, 0x6b78aaa9)},
+    {U64(0xbe5691ef, 0x416bd60c), U64(0x23cc986b, 0xc656d553)},
+    {U64(0xedec366b, 0x11c6cb8f), U64(0x2cbfbe86, 0xb7ec8aa8)},
+    {U64(0x94b3a202, 0xeb1c3f39), U64(0x7bf7d714, 0x32f3d6a9)},
+    {U64(0xb9e08a83, 0xa5e34f07), U64(0xdaf5ccd9, 0x3fb0cc53)},
+    {U64(0xe858ad24, 0x8f5c22c9), U64(0xd1b3400f, 0x8f9cff68)},
+    {U64(0x91376c36, 0xd99995be), U64(0x23100809, 0xb9c21fa1)},
+    {U64(0xb5854744, 0x8ffffb2d), U64(0xabd40a0c, 0x2832a78a)},
+    {U64(0xe2e69915, 0xb3fff9f9), U64(0x16c90c8f, 0x323f516c)},
+    {U64(0x8dd01fad, 0x907ffc3b), U64(0xae3da7d9, 0x7f6792e3)},
+    {U64(0xb1442798, 0xf49ffb4a), U64(0x99cd11cf, 0xdf41779c)},
+    {U64(0xdd95317f, 0x31c7fa1d), U64(0x40405643, 0xd711d583)},
+    {U64(0x8a7d3eef, 0x7f1cfc52), U64(0x482835ea, 0x666b2572)},
+    {U64(0xad1c8eab, 0x5ee43b66), U64(0xda324365, 0x0005eecf)},
+    {U64(0xd863b256, 0x369d4a40), U64(0x90bed43e, 0x40076a82)},
+    {U64(0x873e4f75, 0xe2224e68), U64(0x5a7744a6, 0xe804a291)},
+    {U64(0xa90de353, 0x5aaae202), U64(0x711515d0, 0xa205cb36)},
+    {U64(0xd3515c28, 0x31559a83), U64(0x0d5a5b44, 0xca873e03)},
+    {U64(0x8412d999, 0x1ed58091), U64(0xe858790a, 0xfe9486c2)},
+    {U64(0xa5178fff, 0x668ae0b6), U64(0x626e974d, 0xbe39a872)},
+    {U64(0xce5d73ff, 0x402d98e3), U64(0xfb0a3d21, 0x2dc8128f)},
+    {U64(0x80fa687f, 0x881c7f8e), U64(0x7ce66634, 0xbc9d0b99)},
+    {U64(0xa139029f, 0x6a239f72), U64(0x1c1fffc1, 0xebc44e80)},
+    {U64(0xc9874347, 0x44ac874e), U64(0xa327ffb2, 0x66b56220)},
+    {U64(0xfbe91419, 0x15d7a922), U64(0x4bf1ff9f, 0x0062baa8)},
+    {U64(0x9d71ac8f, 0xada6c9b5), U64(0x6f773fc3, 0x603db4a9)},
+    {U64(0xc4ce17b3, 0x99107c22), U64(0xcb550fb4, 0x384d21d3)},
+    {U64(0xf6019da0, 0x7f549b2b), U64(0x7e2a53a1, 0x46606a48)},
+    {U64(0x99c10284, 0x4f94e0fb), U64(0x2eda7444, 0xcbfc426d)},
+    {U64(0xc0314325, 0x637a1939), U64(0xfa911155, 0xfefb5308)},
+    {U64(0xf03d93ee, 0xbc589f88), U64(0x793555ab, 0x7eba27ca)},
+    {U64(0x96267c75, 0x35b763b5), U64(0x4bc1558b, 0x2f3458de)},
+    {U64(0xbbb01b92, 0x83253ca2), U64(0x9eb1aaed, 0xfb016f16)},
+    {U64(0xea9c2277, 0x23ee8bcb), U64(0x465e15a9, 0x79c1cadc)},
+    {U64(0x92a1958a, 0x7675175f), U64(0x0bfacd89, 0xec191ec9)},
+    {U64(0xb749faed, 0x14125d36), U64(0xcef980ec, 0x671f667b)},
+    {U64(0xe51c79a8, 0x5916f484), U64(0x82b7e127, 0x80e7401a)},
+    {U64(0x8f31cc09, 0x37ae58d2), U64(0xd1b2ecb8, 0xb0908810)},
+    {U64(0xb2fe3f0b, 0x8599ef07), U64(0x861fa7e6, 0xdcb4aa15)},
+    {U64(0xdfbdcece, 0x67006ac9), U64(0x67a791e0, 0x93e1d49a)},
+    {U64(0x8bd6a141, 0x006042bd), U64(0xe0c8bb2c, 0x5c6d24e0)},
+    {U64(0xaecc4991, 0x4078536d), U64(0x58fae9f7, 0x73886e18)},
+    {U64(0xda7f5bf5, 0x90966848), U64(0xaf39a475, 0x506a899e)},
+    {U64(0x888f9979, 0x7a5e012d), U64(0x6d8406c9, 0x52429603)},
+    {U64(0xaab37fd7, 0xd8f58178), U64(0xc8e5087b, 0xa6d33b83)},
+    {U64(0xd5605fcd, 0xcf32e1d6), U64(0xfb1e4a9a, 0x90880a64)},
+    {U64(0x855c3be0, 0xa17fcd26), U64(0x5cf2eea0, 0x9a55067f)},
+    {U64(0xa6b34ad8, 0xc9dfc06f), U64(0xf42faa48, 0xc0ea481e)},
+    {U64(0xd0601d8e, 0xfc57b08b), U64(0xf13b94da, 0xf124da26)},
+    {U64(0x823c1279, 0x5db6ce57), U64(0x76c53d08, 0xd6b70858)},
+    {U64(0xa2cb1717, 0xb52481ed), U64(0x54768c4b, 0x0c64ca6e)},
+    {U64(0xcb7ddcdd, 0xa26da268), U64(0xa9942f5d, 0xcf7dfd09)},
+    {U64(0xfe5d5415, 0x0b090b02), U64(0xd3f93b35, 0x435d7c4c)},
+    {U64(0x9efa548d, 0x26e5a6e1), U64(0xc47bc501, 0x4a1a6daf)},
+    {U64(0xc6b8e9b0, 0x709f109a), U64(0x359ab641, 0x9ca1091b)},
+    {U64(0xf867241c, 0x8cc6d4c0), U64(0xc30163d2, 0x03c94b62)},
+    {U64(0x9b407691, 0xd7fc44f8), U64(0x79e0de63, 0x425dcf1d)},
+    {U64(0xc2109436, 0x4dfb5636), U64(0x985915fc, 0x12f542e4)},
+    {U64(0xf294b943, 0xe17a2bc4), U64(0x3e6f5b7b, 0x17b2939d)},
+    {U64(0x979cf3ca, 0x6cec5b5a), U64(0xa705992c, 0xeecf9c42)},
+    {U64(0xbd8430bd, 0x08277231), U64(0x50c6ff78, 0x2a838353)},
+    {U64(0xece53cec, 0x4a314ebd), U64(0xa4f8bf56, 0x35246428)},
+    {U64(0x940f4613, 0xae5ed136), U64(0x871b7795, 0xe136be99)},
+    {U64(0xb9131798, 0x99f68584), U64(0x28e2557b, 0x59846e3f)},
+    {U64(0xe757dd7e, 0xc07426e5), U64(0x331aeada, 0x2fe589cf)},
+    {U64(0x9096ea6f, 0x3848984f), U64(0x3ff0d2c8, 0x5def7621)},
+    {U64(0xb4bca50b, 0x065abe63), U64(0x0fed077a, 0x756b53a9)},
+    {U64(0xe1ebce4d, 0xc7f16dfb), U64(0xd3e84959, 0x12c62894)},
+    {U64(0x8d3360f0, 0x9cf6e4bd), U64(0x64712dd7, 0xabbbd95c)},
+    {U64(0xb080392c, 0xc4349dec), U64(0xbd8d794d, 0x96aacfb3)},
+    {U64(0xdca04777, 0xf541c567), U64(0xecf0d7a0, 0xfc5583a0)},
+    {U64(0x89e42caa, 0xf9491b60), U64(0xf41686c4, 0x9db57244)},
+    {U64(0xac5d37d5, 0xb79b6239), U64(0x311c2875, 0xc522ced5)},
+    {U64(0xd77485cb, 0x25823ac7), U64(0x7d633293, 0x366b828b)},
+    {U64(0x86a8d39e, 0xf77164bc), U64(0xae5dff9c, 0x02033197)},
+    {U64(0xa8530886, 0xb54dbdeb), U64(0xd9f57f83, 0x0283fdfc)},
+    {U64(0xd267caa8, 0x62a12d66), U64(0xd072df63, 0xc324fd7b)},
+    {U64(0x8380dea9, 0x3da4bc60), U64(0x4247cb9e, 0x59f71e6d)},
+    {U64(0xa4611653, 0x8d0deb78), U64(0x52d9be85, 0xf074e608)},
+    {U64(0xcd795be8, 0x70516656), U64(0x67902e27, 0x6c921f8b)},
+    {U64(0x806bd971, 0x4632dff6), U64(0x00ba1cd8, 0xa3db53b6)},
+    {U64(0xa086cfcd, 0x97bf97f3), U64(0x80e8a40e, 0xccd228a4)},
+    {U64(0xc8a883c0, 0xfdaf7df0), U64(0x6122cd12, 0x8006b2cd)},
+    {U64(0xfad2a4b1, 0x3d1b5d6c), U64(0x796b8057, 0x20085f81)},
+    {U64(0x9cc3a6ee, 0xc6311a63), U64(0xcbe33036, 0x74053bb0)},
+    {U64(0xc3f490aa, 0x77bd60fc), U64(0xbedbfc44, 0x11068a9c)},
+    {U64(0xf4f1b4d5, 0x15acb93b), U64(0xee92fb55, 0x15482d44)},
+    {U64(0x99171105, 0x2d8bf3c5), U64(0x751bdd15, 0x2d4d1c4a)},
+    {U64(0xbf5cd546, 0x78eef0b6), U64(0xd262d45a, 0x78a0635d)},
+    {U64(0xef340a98, 0x172aace4), U64(0x86fb8971, 0x16c87c34)},
+    {U64(0x9580869f, 0x0e7aac0e), U64(0xd45d35e6, 0xae3d4da0)},
+    {U64(0xbae0a846, 0xd2195712), U64(0x89748360, 0x59cca109)},
+    {U64(0xe998d258, 0x869facd7), U64(0x2bd1a438, 0x703fc94b)},
+    {U64(0x91ff8377, 0x5423cc06), U64(0x7b6306a3, 0x4627ddcf)},
+    {U64(0xb67f6455, 0x292cbf08), U64(0x1a3bc84c, 0x17b1d542)},
+    {U64(0xe41f3d6a, 0x7377eeca), U64(0x20caba5f, 0x1d9e4a93)},
+    {U64(0x8e938662, 0x882af53e), U64(0x547eb47b, 0x7282ee9c)},
+    {U64(0xb23867fb, 0x2a35b28d), U64(0xe99e619a, 0x4f23aa43)},
+    {U64(0xdec681f9, 0xf4c31f31), U64(0x6405fa00, 0xe2ec94d4)},
+    {U64(0x8b3c113c, 0x38f9f37e), U64(0xde83bc40, 0x8dd3dd04)},
+    {U64(0xae0b158b, 0x4738705e), U64(0x9624ab50, 0xb148d445)},
+    {U64(0xd98ddaee, 0x19068c76), U64(0x3badd624, 0xdd9b0957)},
+    {U64(0x87f8a8d4, 0xcfa417c9), U64(0xe54ca5d7, 0x0a80e5d6)},
+    {U64(0xa9f6d30a, 0x038d1dbc), U64(0x5e9fcf4c, 0xcd211f4c)},
+    {U64(0xd47487cc, 0x8470652b), U64(0x7647c320, 0x0069671f)},
+    {U64(0x84c8d4df, 0xd2c63f3b), U64(0x29ecd9f4, 0x0041e073)},
+    {U64(0xa5fb0a17, 0xc777cf09), U64(0xf4681071, 0x00525890)},
+    {U64(0xcf79cc9d, 0xb955c2cc), U64(0x7182148d, 0x4066eeb4)},
+    {U64(0x81ac1fe2, 0x93d599bf), U64(0xc6f14cd8, 0x48405530)},
+    {U64(0xa21727db, 0x38cb002f), U64(0xb8ada00e, 0x5a506a7c)},
+    {U64(0xca9cf1d2, 0x06fdc03b), U64(0xa6d90811, 0xf0e4851c)},
+    {U64(0xfd442e46, 0x88bd304a), U64(0x908f4a16, 0x6d1da663)},
+    {U64(0x9e4a9cec, 0x15763e2e), U64(0x9a598e4e, 0x043287fe)},
+    {U64(0xc5dd4427, 0x1ad3cdba), U64(0x40eff1e1, 0x853f29fd)},
+    {U64(0xf7549530, 0xe188c128), U64(0xd12bee59, 0xe68ef47c)},
+    {U64(0x9a94dd3e, 0x8cf578b9), U64(0x82bb74f8, 0x301958ce)},
+    {U64(0xc13a148e, 0x3032d6e7), U64(0xe36a5236, 0x3c1faf01)},
+    {U64(0xf18899b1, 0xbc3f8ca1), U64(0xdc44e6c3, 0xcb279ac1)},
+    {U64(0x96f5600f, 0x15a7b7e5), U64(0x29ab103a, 0x5ef8c0b9)},
+    {U64(0xbcb2b812, 0xdb11a5de), U64(0x7415d448, 0xf6b6f0e7)},
+    {U64(0xebdf6617, 0x91d60f56), U64(0x111b495b, 0x3464ad21)},
+    {U64(0x936b9fce, 0xbb25c995), U64(0xcab10dd9, 0x00beec34)},
+    {U64(0xb84687c2, 0x69ef3bfb), U64(0x3d5d514f, 0x40eea742)},
+    {U64(0xe65829b3, 0x046b0afa), U64(0x0cb4a5a3, 0x112a5112)},
+    {U64(0x8ff71a0f, 0xe2c2e6dc), U64(0x47f0e785, 0xeaba72ab)},
+    {U64(0xb3f4e093, 0xdb73a093), U64(0x59ed2167, 0x65690f56)},
+    {U64(0xe0f218b8, 0xd25088b8), U64(0x306869c1, 0x3ec3532c)},
+    {U64(0x8c974f73, 0x83725573), U64(0x1e414218, 0xc73a13fb)},
+    {U64(0xafbd2350, 0x644eeacf), U64(0xe5d1929e, 0xf90898fa)},
+    {U64(0xdbac6c24, 0x7d62a583), U64(0xdf45f746, 0xb74abf39)},
+    {U64(0x894bc396, 0xce5da772), U64(0x6b8bba8c, 0x328eb783)},
+    {U64(0xab9eb47c, 0x81f5114f), U64(0x066ea92f, 0x3f326564)},
+    {U64(0xd686619b, 0xa27255a2), U64(0xc80a537b, 0x0efefebd)},
+    {U64(0x8613fd01, 0x45877585), U64(0xbd06742c, 0xe95f5f36)},
+    {U64(0xa798fc41, 0x96e952e7), U64(0x2c481138, 0x23b73704)},
+    {U64(0xd17f3b51, 0xfca3a7a0), U64(0xf75a1586, 0x2ca504c5)},
+    {U64(0x82ef8513, 0x3de648c4), U64(0x9a984d73, 0xdbe722fb)},
+    {U64(0xa3ab6658, 0x0d5fdaf5), U64(0xc13e60d0, 0xd2e0ebba)},
+    {U64(0xcc963fee, 0x10b7d1b3), U64(0x318df905, 0x079926a8)},
+    {U64(0xffbbcfe9, 0x94e5c61f), U64(0xfdf17746, 0x497f7052)},
+    {U64(0x9fd561f1, 0xfd0f9bd3), U64(0xfeb6ea8b, 0xedefa633)},
+    {U64(0xc7caba6e, 0x7c5382c8), U64(0xfe64a52e, 0xe96b8fc0)},
+    {U64(0xf9bd690a, 0x1b68637b), U64(0x3dfdce7a, 0xa3c673b0)},
+    {U64(0x9c1661a6, 0x51213e2d), U64(0x06bea10c, 0xa65c084e)},
+    {U64(0xc31bfa0f, 0xe5698db8), U64(0x486e494f, 0xcff30a62)},
+    {U64(0xf3e2f893, 0xdec3f126), U64(0x5a89dba3, 0xc3efccfa)},
+    {U64(0x986ddb5c, 0x6b3a76b7), U64(0xf8962946, 0x5a75e01c)},
+    {U64(0xbe895233, 0x86091465), U64(0xf6bbb397, 0xf1135823)},
+    {U64(0xee2ba6c0, 0x678b597f), U64(0x746aa07d, 0xed582e2c)},
+    {U64(0x94db4838, 0x40b717ef), U64(0xa8c2a44e, 0xb4571cdc)},
+    {U64(0xba121a46, 0x50e4ddeb), U64(0x92f34d62, 0x616ce413)},
+    {U64(0xe896a0d7, 0xe51e1566), U64(0x77b020ba, 0xf9c81d17)},
+    {U64(0x915e2486, 0xef32cd60), U64(0x0ace1474, 0xdc1d122e)},
+    {U64(0xb5b5ada8, 0xaaff80b8), U64(0x0d819992, 0x132456ba)},
+    {U64(0xe3231912, 0xd5bf60e6), U64(0x10e1fff6, 0x97ed6c69)},
+    {U64(0x8df5efab, 0xc5979c8f), U64(0xca8d3ffa, 0x1ef463c1)},
+    {U64(0xb1736b96, 0xb6fd83b3), U64(0xbd308ff8, 0xa6b17cb2)},
+    {U64(0xddd0467c, 0x64bce4a0), U64(0xac7cb3f6, 0xd05ddbde)},
+    {U64(0x8aa22c0d, 0xbef60ee4), U64(0x6bcdf07a, 0x423aa96b)},
+    {U64(0xad4ab711, 0x2eb3929d), U64(0x86c16c98, 0xd2c953c6)},
+    {U64(0xd89d64d5, 0x7a607744), U64(0xe871c7bf, 0x077ba8b7)},
+    {U64(0x87625f05, 0x6c7c4a8b), U64(0x11471cd7, 0x64ad4972)},
+    {U64(0xa93af6c6, 0xc79b5d2d), U64(0xd598e40d, 0x3dd89bcf)},
+    {U64(0xd389b478, 0x79823479), U64(0x4aff1d10, 0x8d4ec2c3)},
+    {U64(0x843610cb, 0x4bf160cb), U64(0xcedf722a, 0x585139ba)},
+    {U64(0xa54394fe, 0x1eedb8fe), U64(0xc2974eb4, 0xee658828)},
+    {U64(0xce947a3d, 0xa6a9273e), U64(0x733d2262, 0x29feea32)},
+    {U64(0x811ccc66, 0x8829b887), U64(0x0806357d, 0x5a3f525f)},
+    {U64(0xa163ff80, 0x2a3426a8), U64(0xca07c2dc, 0xb0cf26f7)},
+    {U64(0xc9bcff60, 0x34c13052), U64(0xfc89b393, 0xdd02f0b5)},
+    {U64(0xfc2c3f38, 0x41f17c67), U64(0xbbac2078, 0xd443ace2)},
+    {U64(0x9d9ba783, 0x2936edc0), U64(0xd54b944b, 0x84aa4c0d)},
+    {U64(0xc5029163, 0xf384a931), U64(0x0a9e795e, 0x65d4df11)},
+    {U64(0xf64335bc, 0xf065d37d), U64(0x4d4617b5, 0xff4a16d5)},
+    {U64(0x99ea0196, 0x163fa42e), U64(0x504bced1, 0xbf8e4e45)},
+    {U64(0xc06481fb, 0x9bcf8d39), U64(0xe45ec286, 0x2f71e1d6)},
+    {U64(0xf07da27a, 0x82c37088), U64(0x5d767327, 0xbb4e5a4c)},
+    {U64(0x964e858c, 0x91ba2655), U64(0x3a6a07f8, 0xd510f86f)},
+    {U64(0xbbe226ef, 0xb628afea), U64(0x890489f7, 0x0a55368b)},
+    {U64(0xeadab0ab, 0xa3b2dbe5), U64(0x2b45ac74, 0xccea842e)},
+    {U64(0x92c8ae6b, 0x464fc96f), U64(0x3b0b8bc9, 0x0012929d)},
+    {U64(0xb77ada06, 0x17e3bbcb), U64(0x09ce6ebb, 0x40173744)},
+    {U64(0xe5599087, 0x9ddcaabd), U64(0xcc420a6a, 0x101d0515)},
+    {U64(0x8f57fa54, 0xc2a9eab6), U64(0x9fa94682, 0x4a12232d)},
+    {U64(0xb32df8e9, 0xf3546564), U64(0x47939822, 0xdc96abf9)},
+    {U64(0xdff97724, 0x70297ebd), U64(0x59787e2b, 0x93bc56f7)},
+    {U64(0x8bfbea76, 0xc619ef36), U64(0x57eb4edb, 0x3c55b65a)},
+    {U64(0xaefae514, 0x77a06b03), U64(0xede62292, 0x0b6b23f1)},
+    {U64(0xdab99e59, 0x958885c4), U64(0xe95fab36, 0x8e45eced)},
+    {U64(0x88b402f7, 0xfd75539b), U64(0x11dbcb02, 0x18ebb414)},
+    {U64(0xaae103b5, 0xfcd2a881), U64(0xd652bdc2, 0x9f26a119)},
+    {U64(0xd59944a3, 0x7c0752a2), U64(0x4be76d33, 0x46f0495f)},
+    {U64(0x857fcae6, 0x2d8493a5), U64(0x6f70a440, 0x0c562ddb)},
+    {U64(0xa6dfbd9f, 0xb8e5b88e), U64(0xcb4ccd50, 0x0f6bb952)},
+    {U64(0xd097ad07, 0xa71f26b2), U64(0x7e2000a4, 0x1346a7a7)},
+    {U64(0x825ecc24, 0xc873782f), U64(0x8ed40066, 0x8c0c28c8)},
+    {U64(0xa2f67f2d, 0xfa90563b), U64(0x72890080, 0x2f0f32fa)},
+    {U64(0xcbb41ef9, 0x79346bca), U64(0x4f2b40a0, 0x3ad2ffb9)},
+    {U64(0xfea126b7, 0xd78186bc), U64(0xe2f610c8, 0x4987bfa8)},
+    {U64(0x9f24b832, 0xe6b0f436), U64(0x0dd9ca7d, 0x2df4d7c9)},
+    {U64(0xc6ede63f, 0xa05d3143), U64(0x91503d1c, 0x79720dbb)},
+    {U64(0xf8a95fcf, 0x88747d94), U64(0x75a44c63, 0x97ce912a)},
+    {U64(0x9b69dbe1, 0xb548ce7c), U64(0xc986afbe, 0x3ee11aba)},
+    {U64(0xc24452da, 0x229b021b), U64(0xfbe85bad, 0xce996168)},
+    {U64(0xf2d56790, 0xab41c2a2), U64(0xfae27299, 0x423fb9c3)},
+    {U64(0x97c560ba, 0x6b0919a5), U64(0xdccd879f, 0xc967d41a)},
+    {U64(0xbdb6b8e9, 0x05cb600f), U64(0x5400e987, 0xbbc1c920)},
+    {U64(0xed246723, 0x473e3813), U64(0x290123e9, 0xaab23b68)},
+    {U64(0x9436c076, 0x0c86e30b), U64(0xf9a0b672, 0x0aaf6521)},
+    {U64(0xb9447093, 0x8fa89bce), U64(0xf808e40e, 0x8d5b3e69)},
+    {U64(0xe7958cb8, 0x7392c2c2), U64(0xb60b1d12, 0x30b20e04)},
+    {U64(0x90bd77f3, 0x483bb9b9), U64(0xb1c6f22b, 0x5e6f48c2)},
+    {U64(0xb4ecd5f0, 0x1a4aa828), U64(0x1e38aeb6, 0x360b1af3)},
+    {U64(0xe2280b6c, 0x20dd5232), U64(0x25c6da63, 0xc38de1b0)},
+    {U64(0x8d590723, 0x948a535f), U64(0x579c487e, 0x5a38ad0e)},
+    {U64(0xb0af48ec, 0x79ace837), U64(0x2d835a9d, 0xf0c6d851)},
+    {U64(0xdcdb1b27, 0x98182244), U64(0xf8e43145, 0x6cf88e65)},
+    {U64(0x8a08f0f8, 0xbf0f156b), U64(0x1b8e9ecb, 0x641b58ff)},
+    {U64(0xac8b2d36, 0xeed2dac5), U64(0xe272467e, 0x3d222f3f)},
+    {U64(0xd7adf884, 0xaa879177), U64(0x5b0ed81d, 0xcc6abb0f)},
+    {U64(0x86ccbb52, 0xea94baea), U64(0x98e94712, 0x9fc2b4e9)},
+    {U64(0xa87fea27, 0xa539e9a5), U64(0x3f2398d7, 0x47b36224)},
+    {U64(0xd29fe4b1, 0x8e88640e), U64(0x8eec7f0d, 0x19a03aad)},
+    {U64(0x83a3eeee, 0xf9153e89), U64(0x1953cf68, 0x300424ac)},
+    {U64(0xa48ceaaa, 0xb75a8e2b), U64(0x5fa8c342, 0x3c052dd7)},
+    {U64(0xcdb02555, 0x653131b6), U64(0x3792f412, 0xcb06794d)},
+    {U64(0x808e1755, 0x5f3ebf11), U64(0xe2bbd88b, 0xbee40bd0)},
+    {U64(0xa0b19d2a, 0xb70e6ed6), U64(0x5b6aceae, 0xae9d0ec4)},
+    {U64(0xc8de0475, 0x64d20a8b), U64(0xf245825a, 0x5a445275)},
+    {U64(0xfb158592, 0xbe068d2e), U64(0xeed6e2f0, 0xf0d56712)},
+    {U64(0x9ced737b, 0xb6c4183d), U64(0x55464dd6, 0x9685606b)},
+    {U64(0xc428d05a, 0xa4751e4c), U64(0xaa97e14c, 0x3c26b886)},
+    {U64(0xf5330471, 0x4d9265df), U64(0xd53dd99f, 0x4b3066a8)},
+    {U64(0x993fe2c6, 0xd07b7fab), U64(0xe546a803, 0x8efe4029)},
+    {U64(0xbf8fdb78, 0x849a5f96), U64(0xde985204, 0x72bdd033)},
+    {U64(0xef73d256, 0xa5c0f77c), U64(0x963e6685, 0x8f6d4440)},
+    {U64(0x95a86376, 0x27989aad), U64(0xdde70013, 0x79a44aa8)},
+    {U64(0xbb127c53, 0xb17ec159), U64(0x5560c018, 0x580d5d52)},
+    {U64(0xe9d71b68, 0x9dde71af), U64(0xaab8f01e, 0x6e10b4a6)},
+    {U64(0x92267121, 0x62ab070d), U64(0xcab39613, 0x04ca70e8)},
+    {U64(0xb6b00d69, 0xbb55c8d1), U64(0x3d607b97, 0xc5fd0d22)},
+    {U64(0xe45c10c4, 0x2a2b3b05), U64(0x8cb89a7d, 0xb77c506a)},
+    {U64(0x8eb98a7a, 0x9a5b04e3), U64(0x77f3608e, 0x92adb242)},
+    {U64(0xb267ed19, 0x40f1c61c), U64(0x55f038b2, 0x37591ed3)},
+    {U64(0xdf01e85f, 0x912e37a3), U64(0x6b6c46de, 0xc52f6688)},
+    {U64(0x8b61313b, 0xbabce2c6), U64(0x2323ac4b, 0x3b3da015)},
+    {U64(0xae397d8a, 0xa96c1b77), U64(0xabec975e, 0x0a0d081a)},
+    {U64(0xd9c7dced, 0x53c72255), U64(0x96e7bd35, 0x8c904a21)},
+    {U64(0x881cea14, 0x545c7575), U64(0x7e50d641, 0x77da2e54)},
+    {U64(0xaa242499, 0x697392d2), U64(0xdde50bd1, 0xd5d0b9e9)},
+    {U64(0xd4ad2dbf, 0xc3d07787), U64(0x955e4ec6, 0x4b44e864)},
+    {U64(0x84ec3c97, 0xda624ab4), U64(0xbd5af13b, 0xef0b113e)},
+    {U64(0xa6274bbd, 0xd0fadd61), U64(0xecb1ad8a, 0xeacdd58e)},
+    {U64(0xcfb11ead, 0x453994ba), U64(0x67de18ed, 0xa5814af2)},
+    {U64(0x81ceb32c, 0x4b43fcf4), U64(0x80eacf94, 0x8770ced7)},
+    {U64(0xa2425ff7, 0x5e14fc31), U64(0xa1258379, 0xa94d028d)},
+    {U64(0xcad2f7f5, 0x359a3b3e), U64(0x096ee458, 0x13a04330)},
+    {U64(0xfd87b5f2, 0x8300ca0d), U64(0x8bca9d6e, 0x188853fc)},
+    {U64(0x9e74d1b7, 0x91e07e48), U64(0x775ea264, 0xcf55347e)},
+    {U64(0xc6120625, 0x76589dda), U64(0x95364afe, 0x032a819e)},
+    {U64(0xf79687ae, 0xd3eec551), U64(0x3a83ddbd, 0x83f52205)},
+    {U64(0x9abe14cd, 0x44753b52), U64(0xc4926a96, 0x72793543)},
+    {U64(0xc16d9a00, 0x95928a27), U64(0x75b7053c, 0x0f178294)},
+    {U64(0xf1c90080, 0xbaf72cb1), U64(0x5324c68b, 0x12dd6339)},
+    {U64(0x971da050, 0x74da7bee), U64(0xd3f6fc16, 0xebca5e04)},
+    {U64(0xbce50864, 0x92111aea), U64(0x88f4bb1c, 0xa6bcf585)},
+    {U64(0xec1e4a7d, 0xb69561a5), U64(0x2b31e9e3, 0xd06c32e6)},
+    {U64(0x9392ee8e, 0x921d5d07), U64(0x3aff322e, 0x62439fd0)},
+    {U64(0xb877aa32, 0x36a4b449), U64(0x09befeb9, 0xfad487c3)},
+    {U64(0xe69594be, 0xc44de15b), U64(0x4c2ebe68, 0x7989a9b4)},
+    {U64(0x901d7cf7, 0x3ab0acd9), U64(0x0f9d3701, 0x4bf60a11)},
+    {U64(0xb424dc35, 0x095cd80f), U64(0x538484c1, 0x9ef38c95)},
+    {U64(0xe12e1342, 0x4bb40e13), U64(0x2865a5f2, 0x06b06fba)},
+    {U64(0x8cbccc09, 0x6f5088cb), U64(0xf93f87b7, 0x442e45d4)},
+    {U64(0xafebff0b, 0xcb24aafe), U64(0xf78f69a5, 0x1539d749)},
+    {U64(0xdbe6fece, 0xbdedd5be), U64(0xb573440e, 0x5a884d1c)},
+    {U64(0x89705f41, 0x36b4a597), U64(0x31680a88, 0xf8953031)},
+    {U64(0xabcc7711, 0x8461cefc), U64(0xfdc20d2b, 0x36ba7c3e)},
+    {U64(0xd6bf94d5, 0xe57a42bc), U64(0x3d329076, 0x04691b4d)},
+    {U64(0x8637bd05, 0xaf6c69b5), U64(0xa63f9a49, 0xc2c1b110)},
+    {U64(0xa7c5ac47, 0x1b478423), U64(0x0fcf80dc, 0x33721d54)},
+    {U64(0xd1b71758, 0xe219652b), U64(0xd3c36113, 0x404ea4a9)},
+    {U64(0x83126e97, 0x8d4fdf3b), U64(0x645a1cac, 0x083126ea)},
+    {U64(0xa3d70a3d, 0x70a3d70a), U64(0x3d70a3d7, 0x0a3d70a4)},
+    {U64(0xcccccccc, 0xcccccccc), U64(0xcccccccc, 0xcccccccd)},
+    {U64(0x80000000, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xa0000000, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xc8000000, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xfa000000, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0x9c400000, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xc3500000, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xf4240000, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0x98968000, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xbebc2000, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xee6b2800, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0x9502f900, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xba43b740, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xe8d4a510, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0x9184e72a, 0x00000000), U64(0x00000000, 0x00000000)},
+    {U64(0xb5e620f4, 0x80000000), U64(0x00000000, 0x00000000)},
+    {U64(0xe35fa931, 0xa0000000), U64(0x00000000, 0x00000000)},
+    {U64(0x8e1bc9bf, 0x04000000), U64(0x00000000, 0x00000000)},
+    {U64(0xb1a2bc2e, 0xc5000000), U64(0x00000000, 0x00000000)},
+    {U64(0xde0b6b3a, 0x76400000), U64(0x00000000, 0x00000000)},
+    {U64(0x8ac72304, 0x89e80000), U64(0x00000000, 0x00000000)},
+    {U64(0xad78ebc5, 0xac620000), U64(0x00000000, 0x00000000)},
+    {U64(0xd8d726b7, 0x177a8000), U64(0x00000000, 0x00000000)},
+    {U64(0x87867832, 0x6eac9000), U64(0x00000000, 0x00000000)},
+    {U64(0xa968163f, 0x0a57b400), U64(0x00000000, 0x00000000)},
+    {U64(0xd3c21bce, 0xcceda100), U64(0x00000000, 0x00000000)},
+    {U64(0x84595161, 0x401484a0), U64(0x00000000, 0x00000000)},
+    {U64(0xa56fa5b9, 0x9019a5c8), U64(0x00000000, 0x00000000)},
+    {U64(0xcecb8f27, 0xf4200f3a), U64(0x00000000, 0x00000000)},
+    {U64(0x813f3978, 0xf8940984), U64(0x40000000, 0x00000000)},
+    {U64(0xa18f07d7, 0x36b90be5), U64(0x50000000, 0x00000000)},
+    {U64(0xc9f2c9cd, 0x04674ede), U64(0xa4000000, 0x00000000)},
+    {U64(0xfc6f7c40, 0x45812296), U64(0x4d000000, 0x00000000)},
+    {U64(0x9dc5ada8, 0x2b70b59d), U64(0xf0200000, 0x00000000)},
+    {U64(0xc5371912, 0x364ce305), U64(0x6c280000, 0x00000000)},
+    {U64(0xf684df56, 0xc3e01bc6), U64(0xc7320000, 0x00000000)},
+    {U64(0x9a130b96, 0x3a6c115c), U64(0x3c7f4000, 0x00000000)},
+    {U64(0xc097ce7b, 0xc90715b3), U64(0x4b9f1000, 0x00000000)},
+    {U64(0xf0bdc21a, 0xbb48db20), U64(0x1e86d400, 0x00000000)},
+    {U64(0x96769950, 0xb50d88f4), U64(0x13144480, 0x00000000)},
+    {U64(0xbc143fa4, 0xe250eb31), U64(0x17d955a0, 0x00000000)},
+    {U64(0xeb194f8e, 0x1ae525fd), U64(0x5dcfab08, 0x00000000)},
+    {U64(0x92efd1b8, 0xd0cf37be), U64(0x5aa1cae5, 0x00000000)},
+    {U64(0xb7abc627, 0x050305ad), U64(0xf14a3d9e, 0x40000000)},
+    {U64(0xe596b7b0, 0xc643c719), U64(0x6d9ccd05, 0xd0000000)},
+    {U64(0x8f7e32ce, 0x7bea5c6f), U64(0xe4820023, 0xa2000000)},
+    {U64(0xb35dbf82, 0x1ae4f38b), U64(0xdda2802c, 0x8a800000)},
+    {U64(0xe0352f62, 0xa19e306e), U64(0xd50b2037, 0xad200000)},
+    {U64(0x8c213d9d, 0xa502de45), U64(0x4526f422, 0xcc340000)},
+    {U64(0xaf298d05, 0x0e4395d6), U64(0x9670b12b, 0x7f410000)},
+    {U64(0xdaf3f046, 0x51d47b4c), U64(0x3c0cdd76, 0x5f114000)},
+    {U64(0x88d8762b, 0xf324cd0f), U64(0xa5880a69, 0xfb6ac800)},
+    {U64(0xab0e93b6, 0xefee0053), U64(0x8eea0d04, 0x7a457a00)},
+    {U64(0xd5d238a4, 0xabe98068), U64(0x72a49045, 0x98d6d880)},
+    {U64(0x85a36366, 0xeb71f041), U64(0x47a6da2b, 0x7f864750)},
+    {U64(0xa70c3c40, 0xa64e6c51), U64(0x999090b6, 0x5f67d924)},
+    {U64(0xd0cf4b50, 0xcfe20765), U64(0xfff4b4e3, 0xf741cf6d)},
+    {U64(0x82818f12, 0x81ed449f), U64(0xbff8f10e, 0x7a8921a4)},
+    {U64(0xa321f2d7, 0x226895c7), U64(0xaff72d52, 0x192b6a0d)},
+    {U64(0xcbea6f8c, 0xeb02bb39), U64(0x9bf4f8a6, 0x9f764490)},
+    {U64(0xfee50b70, 0x25c36a08), U64(0x02f236d0, 0x4753d5b4)},
+    {U64(0x9f4f2726, 0x179a2245), U64(0x01d76242, 0x2c946590)},
+    {U64(0xc722f0ef, 0x9d80aad6), U64(0x424d3ad2, 0xb7b97ef5)},
+    {U64(0xf8ebad2b, 0x84e0d58b), U64(0xd2e08987, 0x65a7deb2)},
+    {U64(0x9b934c3b, 0x330c8577), U64(0x63cc55f4, 0x9f88eb2f)},
+    {U64(0xc2781f49, 0xffcfa6d5), U64(0x3cbf6b71, 0xc76b25fb)},
+    {U64(0xf316271c, 0x7fc3908a), U64(0x8bef464e, 0x3945ef7a)},
+    {U64(0x97edd871, 0xcfda3a56), U64(0x97758bf0, 0xe3cbb5ac)},
+    {U64(0xbde94e8e, 0x43d0c8ec), U64(0x3d52eeed, 0x1cbea317)},
+    {U64(0xed63a231, 0xd4c4fb27), U64(0x4ca7aaa8, 0x63ee4bdd)},
+    {U64(0x945e455f, 0x24fb1cf8), U64(0x8fe8caa9, 0x3e74ef6a)},
+    {U64(0xb975d6b6, 0xee39e436), U64(0xb3e2fd53, 0x8e122b44)},
+    {U64(0xe7d34c64, 0xa9c85d44), U64(0x60dbbca8, 0x7196b616)},
+    {U64(0x90e40fbe, 0xea1d3a4a), U64(0xbc8955e9, 0x46fe31cd)},
+    {U64(0xb51d13ae, 0xa4a488dd), U64(0x6babab63, 0x98bdbe41)},
+    {U64(0xe264589a, 0x4dcdab14), U64(0xc696963c, 0x7eed2dd1)},
+    {U64(0x8d7eb760, 0x70a08aec), U64(0xfc1e1de5, 0xcf543ca2)},
+    {U64(0xb0de6538, 0x8cc8ada8), U64(0x3b25a55f, 0x43294bcb)},
+    {U64(0xdd15fe86, 0xaffad912), U64(0x49ef0eb7, 0x13f39ebe)},
+    {U64(0x8a2dbf14, 0x2dfcc7ab), U64(0x6e356932, 0x6c784337)},
+    {U64(0xacb92ed9, 0x397bf996), U64(0x49c2c37f, 0x07965404)},
+    {U64(0xd7e77a8f, 0x87daf7fb), U64(0xdc33745e, 0xc97be906)},
+    {U64(0x86f0ac99, 0xb4e8dafd), U64(0x69a028bb, 0x3ded71a3)},
+    {U64(0xa8acd7c0, 0x222311bc), U64(0xc40832ea, 0x0d68ce0c)},
+    {U64(0xd2d80db0, 0x2aabd62b), U64(0xf50a3fa4, 0x90c30190)},
+    {U64(0x83c7088e, 0x1aab65db), U64(0x792667c6, 0xda79e0fa)},
+    {U64(0xa4b8cab1, 0xa1563f52), U64(0x577001b8, 0x91185938)},
+    {U64(0xcde6fd5e, 0x09abcf26), U64(0xed4c0226, 0xb55e6f86)},
+    {U64(0x80b05e5a, 0xc60b6178), U64(0x544f8158, 0x315b05b4)},
+    {U64(0xa0dc75f1, 0x778e39d6), U64(0x696361ae, 0x3db1c721)},
+    {U64(0xc913936d, 0xd571c84c), U64(0x03bc3a19, 0xcd1e38e9)},
+    {U64(0xfb587849, 0x4ace3a5f), U64(0x04ab48a0, 0x4065c723)},
+    {U64(0x9d174b2d, 0xcec0e47b), U64(0x62eb0d64, 0x283f9c76)},
+    {U64(0xc45d1df9, 0x42711d9a), U64(0x3ba5d0bd, 0x324f8394)},
+    {U64(0xf5746577, 0x930d6500), U64(0xca8f44ec, 0x7ee36479)},
+    {U64(0x9968bf6a, 0xbbe85f20), U64(0x7e998b13, 0xcf4e1ecb)},
+    {U64(0xbfc2ef45, 0x6ae276e8), U64(0x9e3fedd8, 0xc321a67e)},
+    {U64(0xefb3ab16, 0xc59b14a2), U64(0xc5cfe94e, 0xf3ea101e)},
+    {U64(0x95d04aee, 0x3b80ece5), U64(0xbba1f1d1, 0x58724a12)},
+    {U64(0xbb445da9, 0xca61281f), U64(0x2a8a6e45, 0xae8edc97)},
+    {U64(0xea157514, 0x3cf97226), U64(0xf52d09d7, 0x1a3293bd)},
+    {U64(0x924d692c, 0xa61be758), U64(0x593c2626, 0x705f9c56)},
+    {U64(0xb6e0c377, 0xcfa2e12e), U64(0x6f8b2fb0, 0x0c77836c)},
+    {U64(0xe498f455, 0xc38b997a), U64(0x0b6dfb9c, 0x0f956447)},
+    {U64(0x8edf98b5, 0x9a373fec), U64(0x4724bd41, 0x89bd5eac)},
+    {U64(0xb2977ee3, 0x00c50fe7), U64(0x58edec91, 0xec2cb657)},
+    {U64(0xdf3d5e9b, 0xc0f653e1), U64(0x2f2967b6, 0x6737e3ed)},
+    {U64(0x8b865b21, 0x5899f46c), U64(0xbd79e0d2, 0x0082ee74)},
+    {U64(0xae67f1e9, 0xaec07187), U64(0xecd85906, 0x80a3aa11)},
+    {U64(0xda01ee64, 0x1a708de9), U64(0xe80e6f48, 0x20cc9495)},
+    {U64(0x884134fe, 0x908658b2), U64(0x3109058d, 0x147fdcdd)},
+    {U64(0xaa51823e, 0x34a7eede), U64(0xbd4b46f0, 0x599fd415)},
+    {U64(0xd4e5e2cd, 0xc1d1ea96), U64(0x6c9e18ac, 0x7007c91a)},
+    {U64(0x850fadc0, 0x9923329e), U64(0x03e2cf6b, 0xc604ddb0)},
+    {U64(0xa6539930, 0xbf6bff45), U64(0x84db8346, 0xb786151c)},
+    {U64(0xcfe87f7c, 0xef46ff16), U64(0xe6126418, 0x65679a63)},
+    {U64(0x81f14fae, 0x158c5f6e), U64(0x4fcb7e8f, 0x3f60c07e)},
+    {U64(0xa26da399, 0x9aef7749), U64(0xe3be5e33, 0x0f38f09d)},
+    {U64(0xcb090c80, 0x01ab551c), U64(0x5cadf5bf, 0xd3072cc5)},
+    {U64(0xfdcb4fa0, 0x02162a63), U64(0x73d9732f, 0xc7c8f7f6)},
+    {U64(0x9e9f11c4, 0x014dda7e), U64(0x2867e7fd, 0xdcdd9afa)},
+    {U64(0xc646d635, 0x01a1511d), U64(0xb281e1fd, 0x541501b8)},
+    {U64(0xf7d88bc2, 0x4209a565), U64(0x1f225a7c, 0xa91a4226)},
+    {U64(0x9ae75759, 0x6946075f), U64(0x3375788d, 0xe9b06958)},
+    {U64(0xc1a12d2f, 0xc3978937), U64(0x0052d6b1, 0x641c83ae)},
+    {U64(0xf209787b, 0xb47d6b84), U64(0xc0678c5d, 0xbd23a49a)},
+    {U64(0x9745eb4d, 0x50ce6332), U64(0xf840b7ba, 0x963646e0)},
+    {U64(0xbd176620, 0xa501fbff), U64(0xb650e5a9, 0x3bc3d898)},
+    {U64(0xec5d3fa8, 0xce427aff), U64(0xa3e51f13, 0x8ab4cebe)},
+    {U64(0x93ba47c9, 0x80e98cdf), U64(0xc66f336c, 0x36b10137)},
+    {U64(0xb8a8d9bb, 0xe123f017), U64(0xb80b0047, 0x445d4184)},
+    {U64(0xe6d3102a, 0xd96cec1d), U64(0xa60dc059, 0x157491e5)},
+    {U64(0x9043ea1a, 0xc7e41392), U64(0x87c89837, 0xad68db2f)},
+    {U64(0xb454e4a1, 0x79dd1877), U64(0x29babe45, 0x98c311fb)},
+    {U64(0xe16a1dc9, 0xd8545e94), U64(0xf4296dd6, 0xfef3d67a)},
+    {U64(0x8ce2529e, 0x2734bb1d), U64(0x1899e4a6, 0x5f58660c)},
+    {U64(0xb01ae745, 0xb101e9e4), U64(0x5ec05dcf, 0xf72e7f8f)},
+    {U64(0xdc21a117, 0x1d42645d), U64(0x76707543, 0xf4fa1f73)},
+    {U64(0x899504ae, 0x72497eba), U64(0x6a06494a, 0x791c53a8)},
+    {U64(0xabfa45da, 0x0edbde69), U64(0x0487db9d, 0x17636892)},
+    {U64(0xd6f8d750, 0x9292d603), U64(0x45a9d284, 0x5d3c42b6)},
+    {U64(0x865b8692, 0x5b9bc5c2), U64(0x0b8a2392, 0xba45a9b2)},
+    {U64(0xa7f26836, 0xf282b732), U64(0x8e6cac77, 0x68d7141e)},
+    {U64(0xd1ef0244, 0xaf2364ff), U64(0x3207d795, 0x430cd926)},
+    {U64(0x8335616a, 0xed761f1f), U64(0x7f44e6bd, 0x49e807b8)},
+    {U64(0xa402b9c5, 0xa8d3a6e7), U64(0x5f16206c, 0x9c6209a6)},
+    {U64(0xcd036837, 0x130890a1), U64(0x36dba887, 0xc37a8c0f)},
+    {U64(0x80222122, 0x6be55a64), U64(0xc2494954, 0xda2c9789)},
+    {U64(0xa02aa96b, 0x06deb0fd), U64(0xf2db9baa, 0x10b7bd6c)},
+    {U64(0xc83553c5, 0xc8965d3d), U64(0x6f928294, 0x94e5acc7)},
+    {U64(0xfa42a8b7, 0x3abbf48c), U64(0xcb772339, 0xba1f17f9)},
+    {U64(0x9c69a972, 0x84b578d7), U64(0xff2a7604, 0x14536efb)},
+    {U64(0xc38413cf, 0x25e2d70d), U64(0xfef51385, 0x19684aba)},
+    {U64(0xf46518c2, 0xef5b8cd1), U64(0x7eb25866, 0x5fc25d69)},
+    {U64(0x98bf2f79, 0xd5993802), U64(0xef2f773f, 0xfbd97a61)},
+    {U64(0xbeeefb58, 0x4aff8603), U64(0xaafb550f, 0xfacfd8fa)},
+    {U64(0xeeaaba2e, 0x5dbf6784), U64(0x95ba2a53, 0xf983cf38)},
+    {U64(0x952ab45c, 0xfa97a0b2), U64(0xdd945a74, 0x7bf26183)},
+    {U64(0xba756174, 0x393d88df), U64(0x94f97111, 0x9aeef9e4)},
+    {U64(0xe912b9d1, 0x478ceb17), U64(0x7a37cd56, 0x01aab85d)},
+    {U64(0x91abb422, 0xccb812ee), U64(0xac62e055, 0xc10ab33a)},
+    {U64(0xb616a12b, 0x7fe617aa), U64(0x577b986b, 0x314d6009)},
+    {U64(0xe39c4976, 0x5fdf9d94), U64(0xed5a7e85, 0xfda0b80b)},
+    {U64(0x8e41ade9, 0xfbebc27d), U64(0x14588f13, 0xbe847307)},
+    {U64(0xb1d21964, 0x7ae6b31c), U64(0x596eb2d8, 0xae258fc8)},
+    {U64(0xde469fbd, 0x99a05fe3), U64(0x6fca5f8e, 0xd9aef3bb)},
+    {U64(0x8aec23d6, 0x80043bee), U64(0x25de7bb9, 0x480d5854)},
+    {U64(0xada72ccc, 0x20054ae9), U64(0xaf561aa7, 0x9a10ae6a)},
+    {U64(0xd910f7ff, 0x28069da4), U64(0x1b2ba151, 0x8094da04)},
+    {U64(0x87aa9aff, 0x79042286), U64(0x90fb44d2, 0xf05d0842)},
+    {U64(0xa99541bf, 0x57452b28), U64(0x353a1607, 0xac744a53)},
+    {U64(0xd3fa922f, 0x2d1675f2), U64(0x42889b89, 0x97915ce8)},
+    {U64(0x847c9b5d, 0x7c2e09b7), U64(0x69956135, 0xfebada11)},
+    {U64(0xa59bc234, 0xdb398c25), U64(0x43fab983, 0x7e699095)},
+    {U64(0xcf02b2c2, 0x1207ef2e), U64(0x94f967e4, 0x5e03f4bb)},
+    {U64(0x8161afb9, 0x4b44f57d), U64(0x1d1be0ee, 0xbac278f5)},
+    {U64(0xa1ba1ba7, 0x9e1632dc), U64(0x6462d92a, 0x69731732)},
+    {U64(0xca28a291, 0x859bbf93), U64(0x7d7b8f75, 0x03cfdcfe)},
+    {U64(0xfcb2cb35, 0xe702af78), U64(0x5cda7352, 0x44c3d43e)},
+    {U64(0x9defbf01, 0xb061adab), U64(0x3a088813, 0x6afa64a7)},
+    {U64(0xc56baec2, 0x1c7a1916), U64(0x088aaa18, 0x45b8fdd0)},
+    {U64(0xf6c69a72, 0xa3989f5b), U64(0x8aad549e, 0x57273d45)},
+    {U64(0x9a3c2087, 0xa63f6399), U64(0x36ac54e2, 0xf678864b)},
+    {U64(0xc0cb28a9, 0x8fcf3c7f), U64(0x84576a1b, 0xb416a7dd)},
+    {U64(0xf0fdf2d3, 0xf3c30b9f), U64(0x656d44a2, 0xa11c51d5)},
+    {U64(0x969eb7c4, 0x7859e743), U64(0x9f644ae5, 0xa4b1b325)},
+    {U64(0xbc4665b5, 0x96706114), U64(0x873d5d9f, 0x0dde1fee)},
+    {U64(0xeb57ff22, 0xfc0c7959), U64(0xa90cb506, 0xd155a7ea)},
+    {U64(0x9316ff75, 0xdd87cbd8), U64(0x09a7f124, 0x42d588f2)},
+    {U64(0xb7dcbf53, 0x54e9bece), U64(0x0c11ed6d, 0x538aeb2f)},
+    {U64(0xe5d3ef28, 0x2a242e81), U64(0x8f1668c8, 0xa86da5fa)},
+    {U64(0x8fa47579, 0x1a569d10), U64(0xf96e017d, 0x694487bc)},
+    {U64(0xb38d92d7, 0x60ec4455), U64(0x37c981dc, 0xc395a9ac)},
+    {U64(0xe070f78d, 0x3927556a), U64(0x85bbe253, 0xf47b1417)},
+    {U64(0x8c469ab8, 0x43b89562), U64(0x93956d74, 0x78ccec8e)},
+    {U64(0xaf584166, 0x54a6babb), U64(0x387ac8d1, 0x970027b2)},
+    {U64(0xdb2e51bf, 0xe9d0696a), U64(0x06997b05, 0xfcc0319e)},
+    {U64(0x88fcf317, 0xf22241e2), U64(0x441fece3, 0xbdf81f03)},
+    {U64(0xab3c2fdd, 0xeeaad25a), U64(0xd527e81c, 0xad7626c3)},
+    {U64(0xd60b3bd5, 0x6a5586f1), U64(0x8a71e223, 0xd8d3b074)},
+    {U64(0x85c70565, 0x62757456), U64(0xf6872d56, 0x67844e49)},
+    {U64(0xa738c6be, 0xbb12d16c), U64(0xb428f8ac, 0x016561db)},
+    {U64(0xd106f86e, 0x69d785c7), U64(0xe13336d7, 0x01beba52)},
+    {U64(0x82a45b45, 0x0226b39c), U64(0xecc00246, 0x61173473)},
+    {U64(0xa34d7216, 0x42b06084), U64(0x27f002d7, 0xf95d0190)},
+    {U64(0xcc20ce9b, 0xd35c78a5), U64(0x31ec038d, 0xf7b441f4)},
+    {U64(0xff290242, 0xc83396ce), U64(0x7e670471, 0x75a15271)},
+    {U64(0x9f79a169, 0xbd203e41), U64(0x0f0062c6, 0xe984d386)},
+    {U64(0xc75809c4, 0x2c684dd1), U64(0x52c07b78, 0xa3e60868)},
+    {U64(0xf92e0c35, 0x37826145), U64(0xa7709a56, 0xccdf8a82)},
+    {U64(0x9bbcc7a1, 0x42b17ccb), U64(0x88a66076, 0x400bb691)},
+    {U64(0xc2abf989, 0x935ddbfe), U64(0x6acff893, 0xd00ea435)},
+    {U64(0xf356f7eb, 0xf83552fe), U64(0x0583f6b8, 0xc4124d43)},
+    {U64(0x98165af3, 0x7b2153de), U64(0xc3727a33, 0x7a8b704a)},
+    {U64(0xbe1bf1b0, 0x59e9a8d6), U64(0x744f18c0, 0x592e4c5c)},
+    {U64(0xeda2ee1c, 0x7064130c), U64(0x1162def0, 0x6f79df73)},
+    {U64(0x9485d4d1, 0xc63e8be7), U64(0x8addcb56, 0x45ac2ba8)},
+    {U64(0xb9a74a06, 0x37ce2ee1), U64(0x6d953e2b, 0xd7173692)},
+    {U64(0xe8111c87, 0xc5c1ba99), U64(0xc8fa8db6, 0xccdd0437)},
+    {U64(0x910ab1d4, 0xdb9914a0), U64(0x1d9c9892, 0x400a22a2)},
+    {U64(0xb54d5e4a, 0x127f59c8), U64(0x2503beb6, 0xd00cab4b)},
+    {U64(0xe2a0b5dc, 0x971f303a), U64(0x2e44ae64, 0x840fd61d)},
+    {U64(0x8da471a9, 0xde737e24), U64(0x5ceaecfe, 0xd289e5d2)},
+    {U64(0xb10d8e14, 0x56105dad), U64(0x7425a83e, 0x872c5f47)},
+    {U64(0xdd50f199, 0x6b947518), U64(0xd12f124e, 0x28f77719)},
+    {U64(0x8a5296ff, 0xe33cc92f), U64(0x82bd6b70, 0xd99aaa6f)},
+    {U64(0xace73cbf, 0xdc0bfb7b), U64(0x636cc64d, 0x1001550b)},
+    {U64(0xd8210bef, 0xd30efa5a), U64(0x3c47f7e0, 0x5401aa4e)},
+    {U64(0x8714a775, 0xe3e95c78), U64(0x65acfaec, 0x34810a71)},
+    {U64(0xa8d9d153, 0x5ce3b396), U64(0x7f1839a7, 0x41a14d0d)},
+    {U64(0xd31045a8, 0x341ca07c), U64(0x1ede4811, 0x1209a050)},
+    {U64(0x83ea2b89, 0x2091e44d), U64(0x934aed0a, 0xab460432)},
+    {U64(0xa4e4b66b, 0x68b65d60), U64(0xf81da84d, 0x5617853f)},
+    {U64(0xce1de406, 0x42e3f4b9), U64(0x36251260, 0xab9d668e)},
+    {U64(0x80d2ae83, 0xe9ce78f3), U64(0xc1d72b7c, 0x6b426019)},
+    {U64(0xa1075a24, 0xe4421730), U64(0xb24cf65b, 0x8612f81f)},
+    {U64(0xc94930ae, 0x1d529cfc), U64(0xdee033f2, 0x6797b627)},
+    {U64(0xfb9b7cd9, 0xa4a7443c), U64(0x169840ef, 0x017da3b1)},
+    {U64(0x9d412e08, 0x06e88aa5), U64(0x8e1f2895, 0x60ee864e)},
+    {U64(0xc491798a, 0x08a2ad4e), U64(0xf1a6f2ba, 0xb92a27e2)},
+    {U64(0xf5b5d7ec, 0x8acb58a2), U64(0xae10af69, 0x6774b1db)},
+    {U64(0x9991a6f3, 0xd6bf1765), U64(0xacca6da1, 0xe0a8ef29)},
+    {U64(0xbff610b0, 0xcc6edd3f), U64(0x17fd090a, 0x58d32af3)},
+    {U64(0xeff394dc, 0xff8a948e), U64(0xddfc4b4c, 0xef07f5b0)},
+    {U64(0x95f83d0a, 0x1fb69cd9), U64(0x4abdaf10, 0x1564f98e)},
+    {U64(0xbb764c4c, 0xa7a4440f), U64(0x9d6d1ad4, 0x1abe37f1)},
+    {U64(0xea53df5f, 0xd18d5513), U64(0x84c86189, 0x216dc5ed)},
+    {U64(0x92746b9b, 0xe2f8552c), U64(0x32fd3cf5, 0xb4e49bb4)},
+    {U64(0xb7118682, 0xdbb66a77), U64(0x3fbc8c33, 0x221dc2a1)},
+    {U64(0xe4d5e823, 0x92a40515), U64(0x0fabaf3f, 0xeaa5334a)},
+    {U64(0x8f05b116, 0x3ba6832d), U64(0x29cb4d87, 0xf2a7400e)},
+    {U64(0xb2c71d5b, 0xca9023f8), U64(0x743e20e9, 0xef511012)},
+    {U64(0xdf78e4b2, 0xbd342cf6), U64(0x914da924, 0x6b255416)},
+    {U64(0x8bab8eef, 0xb6409c1a), U64(0x1ad089b6, 0xc2f7548e)},
+    {U64(0xae9672ab, 0xa3d0c320), U64(0xa184ac24, 0x73b529b1)},
+    {U64(0xda3c0f56, 0x8cc4f3e8), U64(0xc9e5d72d, 0x90a2741e)},
+    {U64(0x88658996, 0x17fb1871), U64(0x7e2fa67c, 0x7a658892)},
+    {U64(0xaa7eebfb, 0x9df9de8d), U64(0xddbb901b, 0x98feeab7)},
+    {U64(0xd51ea6fa, 0x85785631), U64(0x552a7422, 0x7f3ea565)},
+    {U64(0x8533285c, 0x936b35de), U64(0xd53a8895, 0x8f87275f)},
+    {U64(0xa67ff273, 0xb8460356), U64(0x8a892aba, 0xf368f137)},
+    {U64(0xd01fef10, 0xa657842c), U64(0x2d2b7569, 0xb0432d85)},
+    {U64(0x8213f56a, 0x67f6b29b), U64(0x9c3b2962, 0x0e29fc73)},
+    {U64(0xa298f2c5, 0x01f45f42), U64(0x8349f3ba, 0x91b47b8f)},
+    {U64(0xcb3f2f76, 0x42717713), U64(0x241c70a9, 0x36219a73)},
+    {U64(0xfe0efb53, 0xd30dd4d7), U64(0xed238cd3, 0x83aa0110)},
+    {U64(0x9ec95d14, 0x63e8a506), U64(0xf4363804, 0x324a40aa)},
+    {U64(0xc67bb459, 0x7ce2ce48), U64(0xb143c605, 0x3edcd0d5)},
+    {U64(0xf81aa16f, 0xdc1b81da), U64(0xdd94b786, 0x8e94050a)},
+    {U64(0x9b10a4e5, 0xe9913128), U64(0xca7cf2b4, 0x191c8326)},
+    {U64(0xc1d4ce1f, 0x63f57d72), U64(0xfd1c2f61, 0x1f63a3f0)},
+    {U64(0xf24a01a7, 0x3cf2dccf), U64(0xbc633b39, 0x673c8cec)},
+    {U64(0x976e4108, 0x8617ca01), U64(0xd5be0503, 0xe085d813)},
+    {U64(0xbd49d14a, 0xa79dbc82), U64(0x4b2d8644, 0xd8a74e18)},
+    {U64(0xec9c459d, 0x51852ba2), U64(0xddf8e7d6, 0x0ed1219e)},
+    {U64(0x93e1ab82, 0x52f33b45), U64(0xcabb90e5, 0xc942b503)},
+    {U64(0xb8da1662, 0xe7b00a17), U64(0x3d6a751f, 0x3b936243)},
+    {U64(0xe7109bfb, 0xa19c0c9d), U64(0x0cc51267, 0x0a783ad4)},
+    {U64(0x906a617d, 0x450187e2), U64(0x27fb2b80, 0x668b24c5)},
+    {U64(0xb484f9dc, 0x9641e9da), U64(0xb1f9f660, 0x802dedf6)},
+    {U64(0xe1a63853, 0xbbd26451), U64(0x5e7873f8, 0xa0396973)},
+    {U64(0x8d07e334, 0x55637eb2), U64(0xdb0b487b, 0x6423e1e8)},
+    {U64(0xb049dc01, 0x6abc5e5f), U64(0x91ce1a9a, 0x3d2cda62)},
+    {U64(0xdc5c5301, 0xc56b75f7), U64(0x7641a140, 0xcc7810fb)},
+    {U64(0x89b9b3e1, 0x1b6329ba), U64(0xa9e904c8, 0x7fcb0a9d)},
+    {U64(0xac2820d9, 0x623bf429), U64(0x546345fa, 0x9fbdcd44)},
+    {U64(0xd732290f, 0xbacaf133), U64(0xa97c1779, 0x47ad4095)},
+    {U64(0x867f59a9, 0xd4bed6c0), U64(0x49ed8eab, 0xcccc485d)},
+    {U64(0xa81f3014, 0x49ee8c70), U64(0x5c68f256, 0xbfff5a74)},
+    {U64(0xd226fc19, 0x5c6a2f8c), U64(0x73832eec, 0x6fff3111)},
+    {U64(0x83585d8f, 0xd9c25db7), U64(0xc831fd53, 0xc5ff7eab)},
+    {U64(0xa42e74f3, 0xd032f525), U64(0xba3e7ca8, 0xb77f5e55)},
+    {U64(0xcd3a1230, 0xc43fb26f), U64(0x28ce1bd2, 0xe55f35eb)},
+    {U64(0x80444b5e, 0x7aa7cf85), U64(0x7980d163, 0xcf5b81b3)},
+    {U64(0xa0555e36, 0x1951c366), U64(0xd7e105bc, 0xc332621f)},
+    {U64(0xc86ab5c3, 0x9fa63440), U64(0x8dd9472b, 0xf3fefaa7)},
+    {U64(0xfa856334, 0x878fc150), U64(0xb14f98f6, 0xf0feb951)},
+    {U64(0x9c935e00, 0xd4b9d8d2), U64(0x6ed1bf9a, 0x569f33d3)},
+    {U64(0xc3b83581, 0x09e84f07), U64(0x0a862f80, 0xec4700c8)},
+    {U64(0xf4a642e1, 0x4c6262c8), U64(0xcd27bb61, 0x2758c0fa)},
+    {U64(0x98e7e9cc, 0xcfbd7dbd), U64(0x8038d51c, 0xb897789c)},
+    {U64(0xbf21e440, 0x03acdd2c), U64(0xe0470a63, 0xe6bd56c3)},
+    {U64(0xeeea5d50, 0x04981478), U64(0x1858ccfc, 0xe06cac74)},
+    {U64(0x95527a52, 0x02df0ccb), U64(0x0f37801e, 0x0c43ebc8)},
+    {U64(0xbaa718e6, 0x8396cffd), U64(0xd3056025, 0x8f54e6ba)},
+    {U64(0xe950df20, 0x247c83fd), U64(0x47c6b82e, 0xf32a2069)},
+    {U64(0x91d28b74, 0x16cdd27e), U64(0x4cdc331d, 0x57fa5441)},
+    {U64(0xb6472e51, 0x1c81471d), U64(0xe0133fe4, 0xadf8e952)},
+    {U64(0xe3d8f9e5, 0x63a198e5), U64(0x58180fdd, 0xd97723a6)},
+    {U64(0x8e679c2f, 0x5e44ff8f), U64(0x570f09ea, 0xa7ea7648)},
+    {U64(0xb201833b, 0x35d63f73), U64(0x2cd2cc65, 0x51e513da)},
+    {U64(0xde81e40a, 0x034bcf4f), U64(0xf8077f7e, 0xa65e58d1)},
+    {U64(0x8b112e86, 0x420f6191), U64(0xfb04afaf, 0x27faf782)},
+    {U64(0xadd57a27, 0xd29339f6), U64(0x79c5db9a, 0xf1f9b563)},
+    {U64(0xd94ad8b1, 0xc7380874), U64(0x18375281, 0xae7822bc)},
+    {U64(0x87cec76f, 0x1c830548), U64(0x8f229391, 0x0d0b15b5)},
+    {U64(0xa9c2794a, 0xe3a3c69a), U64(0xb2eb3875, 0x504ddb22)},
+    {U64(0xd433179d, 0x9c8cb841), U64(0x5fa60692, 0xa46151eb)},
+    {U64(0x849feec2, 0x81d7f328), U64(0xdbc7c41b, 0xa6bcd333)},
+    {U64(0xa5c7ea73, 0x224deff3), U64(0x12b9b522, 0x906c0800)},
+    {U64(0xcf39e50f, 0xeae16bef), U64(0xd768226b, 0x34870a00)},
+    {U64(0x81842f29, 0xf2cce375), U64(0xe6a11583, 0x00d46640)},
+    {U64(0xa1e53af4, 0x6f801c53), U64(0x60495ae3, 0xc1097fd0)},
+    {U64(0xca5e89b1, 0x8b602368), U64(0x385bb19c, 0xb14bdfc4)},
+    {U64(0xfcf62c1d, 0xee382c42), U64(0x46729e03, 0xdd9ed7b5)},
+    {U64(0x9e19db92, 0xb4e31ba9), U64(0x6c07a2c2, 0x6a8346d1)}
+};
+
+#ifdef CJSON_EXACT_DOUBLE_ARITHMETIC
+/* exactly representable powers of ten for the Clinger fast path */
+static const double exact_powers_of_ten[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#endif
+
+typedef struct
+{
+    cjson_uint64 high;
+    cjson_uint64 low;
+} uint128;
+
+/* full 128 bit product of two 64 bit numbers */
+static uint128 multiply_64(const cjson_uint64 a, const cjson_uint64 b)
+{
+    uint128 product;
+#ifdef __SIZEOF_INT128__
+    const cjson_uint128 full = (cjson_uint128)a * b;
+
+    product.high = (cjson_uint64)(full >> 64);
+    product.low = (cjson_uint64)full;
+#else
+    const cjson_uint64 mask = 0xFFFFFFFF;
+    const cjson_uint64 low_low = (a & mask) * (b & mask);
+    const cjson_uint64 high_low = (a >> 32) * (b & mask);
+    const cjson_uint64 low_high = (a & mask) * (b >> 32);
+    const cjson_uint64 high_high = (a >> 32) * (b >> 32);
+    /* can't overflow, low_high is at most (2^32 - 1)^2 */
+    const cjson_uint64 middle = (low_low >> 32) + (high_low & mask) + low_high;
+
+    product.high = high_high + (high_low >> 32) + (middle >> 32);
+    product.low = (middle << 32) | (low_low & mask);
+#endif
+
+    return product;
+}
+
+/* number of leading zero bits of a number that isn't zero */
+static int leading_zeros_64(cjson_uint64 value)
+{
+#ifdef __GNUC__
+    return __builtin_clzll(value);
+#else
+    int zeros = 0;
+    while ((value >> 63) == 0)
     {
-        length = sprintf((char*)number_buffer, "null");
+        value <<= 1;
+        zeros++;
     }
-    else if(d == (double)item->valueint)
+    return zeros;
+#endif
+}
+
+/* floor(q * log2(10)), 217706 / 2^16 is close enough to log2(10) for the range of the table */
+static int floor_log2_pow10(const int q)
+{
+    if (q >= 0)
     {
-        length = sprintf((char*)number_buffer, "%d", item->valueint);
+        return (int)((217706L * q) >> 16);
     }
-    else
-    {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
 
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
-        {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
-        }
-    }
+    return -(int)(((217706L * -q) + 65535) >> 16);
+}
 
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+/* ceil(e * log10(2)), 78913 / 2^18 is close enough to log10(2) for every double exponent */
+static int ceil_log10_pow2(const int e)
+{
+    if (e > 0)
     {
-        return false;
+        return (int)((78913L * e) >> 18) + 1;
     }
 
-    /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
-    if (output_pointer == NULL)
+    return -(int)((78913L * -e) >> 18);
+}
+
+static double double_from_bits(const cjson_uint64 bits)
+{
+    double value = 0;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* Closest double to w * 10^q with the Eisel-Lemire algorithm, w must not be 0.
+ * Returns false in the very rare cases where the algorithm can't decide. */
+static cJSON_bool eisel_lemire(cjson_uint64 w, const int q, const cJSON_bool negative, double * const result)
+{
+    const cjson_uint64 *power = NULL;
+    uint128 product;
+    uint128 second_product;
+    cjson_uint64 mantissa = 0;
+    int leading_zeros = 0;
+    int upper_bit = 0;
+    int shift = 0;
+    int power2 = 0;
+
+    if ((q < POW10_TABLE_MIN) || (q > DBL_MAX_10_EXP))
     {
         return false;
     }
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
+    leading_zeros = leading_zeros_64(w);
+    w <<= leading_zeros;
+
+    power = pow10_significands[q - POW10_TABLE_MIN];
+    product = multiply_64(w, power[0]);
+    /* the bits below the 55 that matter might be off, use the low half of the power too */
+    if ((product.high & 0x1FF) == 0x1FF)
     {
-        if (number_buffer[i] == decimal_point)
+        second_product = multiply_64(w, power[1]);
+        product.low += second_product.high;
+        if (second_product.high > product.low)
         {
-            output_pointer[i] = '.';
-            continue;
+            product.high++;
         }
-
-        output_pointer[i] = number_buffer[i];
     }
-    output_pointer[i] = '\0';
-
-    output_buffer->offset += (size_t)length;
-
-    return true;
-}
+    if ((product.low == ~(cjson_uint64)0) && ((q < -27) || (q > 55)))
+    {
+        return false;
+    }
 
-/* parse 4 digit hexadecimal number */
-static unsigned parse_hex4(const unsigned char * const input)
-{
-    unsigned int h = 0;
-    size_t i = 0;
+    upper_bit = (int)(product.high >> 63);
+    shift = upper_bit + 64 - 52 - 3;
+    mantissa = product.high >> shift;
+    power2 = floor_log2_pow10(q) + 63 + upper_bit - leading_zeros + 1023;
 
-    for (i = 0; i < 4; i++)
+    if (power2 <= 0)
     {
-        /* parse digit */
-        if ((input[i] >= '0') && (input[i] <= '9'))
+        /* subnormal */
+        if ((-power2 + 1) >= 64)
         {
-            h += (unsigned int) input[i] - '0';
+            mantissa = 0;
+            power2 = 0;
         }
-        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        else
         {
-            h += (unsigned int) 10 + input[i] - 'A';
+            mantissa >>= -power2 + 1;
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            power2 = (mantissa < ((cjson_uint64)1 << 52)) ? 0 : 1;
         }
-        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+    }
+    else
+    {
+        /* exactly halfway between two doubles, round to even instead of up */
+        if ((product.low <= 1) && (q >= -4) && (q <= 23) && ((mantissa & 3) == 1) && ((mantissa << shift) == product.high))
         {
-            h += (unsigned int) 10 + input[i] - 'a';
+            mantissa &= ~(cjson_uint64)1;
         }
-        else /* invalid */
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= ((cjson_uint64)2 << 52))
         {
-            return 0;
+            mantissa = (cjson_uint64)1 << 52;
+            power2++;
         }
-
-        if (i < 3)
+        mantissa &= ~((cjson_uint64)1 << 52);
+        if (power2 >= 0x7FF)
         {
-            /* shift left to make place for the next nibble */
-            h = h << 4;
+            /* infinity */
+            power2 = 0x7FF;
+            mantissa = 0;
         }
     }
 
-    return h;
+    *result = double_from_bits(mantissa | ((cjson_uint64)power2 << 52) | ((cjson_uint64)(negative ? 1 : 0) << 63));
+
+    return true;
 }
 
-/* converts a UTF-16 literal to UTF-8
- * A literal can be one or two sequences of the form \uXXXX */
-static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+/* Scan a number the way strtod does for the characters parse_number accepts and convert it without strtod.
+ * Returns the number of characters used, or 0 if it has to be left to strtod. */
+static size_t parse_number_fast(const unsigned char * const input, const size_t length, double * const result)
 {
-    long unsigned int codepoint = 0;
-    unsigned int first_code = 0;
-    const unsigned char *first_sequence = input_pointer;
-    unsigned char utf8_length = 0;
-    unsigned char utf8_position = 0;
-    unsigned char sequence_length = 0;
-    unsigned char first_byte_mark = 0;
+    size_t i = 0;
+    size_t exponent_start = 0;
+    cJSON_bool negative = false;
+    cJSON_bool negative_exponent = false;
+    cjson_uint64 w = 0;
+    int significant_digits = 0;
+    int digits = 0;
+    long explicit_exponent = 0;
+    long q = 0;
 
-    if ((input_end - first_sequence) < 6)
+    if ((i < length) && ((input[i] == '-') || (input[i] == '+')))
     {
-        /* input ends unexpectedly */
-        goto fail;
+        negative = (input[i] == '-');
+        i++;
     }
 
-    /* get the first utf16 sequence */
-    first_code = parse_hex4(first_sequence + 2);
-
-    /* check that the code is valid */
-    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    for (; (i < length) && (input[i] >= '0') && (input[i] <= '9'); i++)
     {
-        goto fail;
+        digits++;
+        if ((w != 0) || (input[i] != '0'))
+        {
+            w = (w * 10) + (cjson_uint64)(input[i] - '0');
+            significant_digits++;
+        }
+    }
+    if ((i < length) && (input[i] == '.'))
+    {
+        for (i++; (i < length) && (input[i] >= '0') && (input[i] <= '9'); i++)
+        {
+            digits++;
+            q--;
+            if ((w != 0) || (input[i] != '0'))
+            {
+                w = (w * 10) + (cjson_uint64)(input[i] - '0');
+                significant_digits++;
+            }
+        }
     }
 
-    /* UTF16 surrogate pair */
-    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    /* more than 19 digits don't fit into w */
+    if ((digits == 0) || (significant_digits > 19))
     {
-        const unsigned char *second_sequence = first_sequence + 6;
-        unsigned int second_code = 0;
-        sequence_length = 12; /* \uXXXX\uXXXX */
+        return 0;
+    }
 
-        if ((input_end - second_sequence) < 6)
+    /* an exponent without digits isn't part of the number */
+    exponent_start = i;
+    if ((i < length) && ((input[i] == 'e') || (input[i] == 'E')))
+    {
+        i++;
+        if ((i < length) && ((input[i] == '-') || (input[i] == '+')))
         {
-            /* input ends unexpectedly */
-            goto fail;
+            negative_exponent = (input[i] == '-');
+            i++;
         }
-
-        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+        if ((i < length) && (input[i] >= '0') && (input[i] <= '9'))
         {
-            /* missing second half of the surrogate pair */
-            goto fail;
+            for (; (i < length) && (input[i] >= '0') && (input[i] <= '9'); i++)
+            {
+                /* saturate, anything this large is zero or infinity anyway */
+                if (explicit_exponent < 100000)
+                {
+                    explicit_exponent = (explicit_exponent * 10) + (input[i] - '0');
+                }
+            }
+            q += negative_exponent ? -explicit_exponent : explicit_exponent;
         }
-
-        /* get the second utf16 sequence */
-        second_code = parse_hex4(second_sequence + 2);
-        /* check that the code is valid */
-        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        else
         {
-            /* invalid second half of the surrogate pair */
-            goto fail;
+            i = exponent_start;
         }
-
-
-        /* calculate the unicode codepoint from the surrogate pair */
-        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
     }
-    else
+
+    /* the strtod path only looks at the first 63 characters, leave longer numbers to it */
+    if (i >= 63)
     {
-        sequence_length = 6; /* \uXXXX */
-        codepoint = first_code;
+        return 0;
     }
 
-    /* encode as UTF-8
-     * takes at maximum 4 bytes to encode:
-     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
-    if (codepoint < 0x80)
+    if (w == 0)
     {
-        /* normal ascii, encoding 0xxxxxxx */
-        utf8_length = 1;
+        *result = negative ? -0.0 : 0.0;
+        return i;
     }
-    else if (codepoint < 0x800)
+
+#ifdef CJSON_EXACT_DOUBLE_ARITHMETIC
+    /* both w and 10^|q| are exact doubles, so a single multiplication or division rounds correctly */
+    if ((w <= ((cjson_uint64)1 << 53)) && (q >= -22) && (q <= 22))
     {
-        /* two bytes, encoding 110xxxxx 10xxxxxx */
-        utf8_length = 2;
-        first_byte_mark = 0xC0; /* 11000000 */
+        *result = (double)w;
+        if (q < 0)
+        {
+            *result /= exact_powers_of_ten[-q];
+        }
+        else
+        {
+            *result *= exact_powers_of_ten[q];
+        }
+        if (negative)
+        {
+            *result = -*result;
+        }
+        return i;
     }
-    else if (codepoint < 0x10000)
+#endif
+
+    if ((q < POW10_TABLE_MIN) || (q > DBL_MAX_10_EXP) || !eisel_lemire(w, (int)q, negative, result))
     {
-        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 3;
-        first_byte_mark = 0xE0; /* 11100000 */
+        return 0;
     }
-    else if (codepoint <= 0x10FFFF)
+
+    return i;
+}
+
+typedef struct
+{
+    cjson_uint64 f;
+    int e;
+} diy_fp;
+
+/* f * 2^e rounded to 64 bits */
+static diy_fp diy_fp_multiply(const diy_fp a, const diy_fp b)
+{
+    uint128 product = multiply_64(a.f, b.f);
+    diy_fp result;
+
+    result.f = product.high + (product.low >> 63);
+    result.e = a.e + b.e + 64;
+
+    return result;
+}
+
+static diy_fp diy_fp_normalize(diy_fp value)
+{
+    int zeros = leading_zeros_64(value.f);
+
+    value.f <<= zeros;
+    value.e -= zeros;
+
+    return value;
+}
+
+/* Round the last digit towards w, and check that the digits are the closest ones to w. */
+static cJSON_bool grisu_round_weed(unsigned char * const digits, const int length, const cjson_uint64 distance_too_high_w, const cjson_uint64 unsafe_interval, cjson_uint64 rest, const cjson_uint64 ten_kappa, const cjson_uint64 unit)
+{
+    const cjson_uint64 small_distance = distance_too_high_w - unit;
+    const cjson_uint64 big_distance = distance_too_high_w + unit;
+
+    while ((rest < small_distance) && ((unsafe_interval - rest) >= ten_kappa)
+            && (((rest + ten_kappa) < small_distance) || ((small_distance - rest) >= (rest + ten_kappa - small_distance))))
+    {
+        digits[length - 1]--;
+        rest += ten_kappa;
+    }
+
+    if ((rest < big_distance) && ((unsafe_interval - rest) >= ten_kappa)
+            && (((rest + ten_kappa) < big_distance) || ((big_distance - rest) > (rest + ten_kappa - big_distance))))
+    {
+        return false;
+    }
+
+    return ((2 * unit) <= rest) && (rest <= (unsafe_interval - (4 * unit)));
+}
+
+/* Shortest digits of a positive, finite double with Grisu3, value = digits * 10^decimal_exponent.
+ * Returns the number of digits, or 0 in the rare cases where Grisu3 can't prove the result is shortest. */
+static int grisu3(const double value, unsigned char * const digits, int * const decimal_exponent)
+{
+    cjson_uint64 bits = 0;
+    cjson_uint64 fraction = 0;
+    int biased_exponent = 0;
+    diy_fp w;
+    diy_fp plus;
+    diy_fp minus;
+    diy_fp cached_power;
+    diy_fp too_low;
+    diy_fp too_high;
+    cjson_uint64 unsafe_interval = 0;
+    cjson_uint64 one = 0;
+    cjson_uint64 fractionals = 0;
+    cjson_uint64 unit = 1;
+    cjson_uint64 rest = 0;
+    unsigned int integrals = 0;
+    unsigned int divisor = 1000000000;
+    int shift = 0;
+    int kappa = 10;
+    int k = 0;
+    int length = 0;
+
+    memcpy(&bits, &value, sizeof(bits));
+    fraction = bits & (((cjson_uint64)1 << 52) - 1);
+    biased_exponent = (int)((bits >> 52) & 0x7FF);
+    if (biased_exponent == 0)
+    {
+        w.f = fraction;
+        w.e = 1 - 1075;
+    }
+    else
+    {
+        w.f = fraction | ((cjson_uint64)1 << 52);
+        w.e = biased_exponent - 1075;
+    }
+
+    /* boundaries halfway to the neighbouring doubles, the lower one is closer at powers of two */
+    plus.f = (w.f << 1) + 1;
+    plus.e = w.e - 1;
+    plus = diy_fp_normalize(plus);
+    if ((fraction == 0) && (biased_exponent > 1))
+    {
+        minus.f = (w.f << 2) - 1;
+        minus.e = w.e - 2;
+    }
+    else
+    {
+        minus.f = (w.f << 1) - 1;
+        minus.e = w.e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    w = diy_fp_normalize(w);
+
+    /* scale by 10^k so the binary exponent ends up in [-60, -32] */
+    k = ceil_log10_pow2(-60 - (w.e + 64) + 63);
+    if ((k < POW10_TABLE_MIN) || (k > POW10_TABLE_MAX))
+    {
+        return 0;
+    }
+    cached_power.f = pow10_significands[k - POW10_TABLE_MIN][0] + (pow10_significands[k - POW10_TABLE_MIN][1] >> 63);
+    cached_power.e = floor_log2_pow10(k) - 63;
+    w = diy_fp_multiply(w, cached_power);
+    plus = diy_fp_multiply(plus, cached_power);
+    minus = diy_fp_multiply(minus, cached_power);
+
+    /* the scaled boundaries are off by at most one unit, everything between too_low and too_high is unsafe */
+    too_low.f = minus.f - unit;
+    too_low.e = minus.e;
+    too_high.f = plus.f + unit;
+    too_high.e = plus.e;
+    unsafe_interval = too_high.f - too_low.f;
+    shift = -w.e;
+    one = (cjson_uint64)1 << shift;
+    integrals = (unsigned int)(too_high.f >> shift);
+    fractionals = too_high.f & (one - 1);
+
+    while ((kappa > 0) && (divisor > integrals))
+    {
+        divisor /= 10;
+        kappa--;
+    }
+
+    while (kappa > 0)
+    {
+        digits[length++] = (unsigned char)('0' + (integrals / divisor));
+        integrals %= divisor;
+        kappa--;
+        rest = ((cjson_uint64)integrals << shift) + fractionals;
+        if (rest < unsafe_interval)
+        {
+            *decimal_exponent = kappa - k;
+            return grisu_round_weed(digits, length, too_high.f - w.f, unsafe_interval, rest, (cjson_uint64)divisor << shift, unit) ? length : 0;
+        }
+        divisor /= 10;
+    }
+
+    while (length < 17)
+    {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        digits[length++] = (unsigned char)('0' + (fractionals >> shift));
+        fractionals &= one - 1;
+        kappa--;
+        if (fractionals < unsafe_interval)
+        {
+            *decimal_exponent = kappa - k;
+            return grisu_round_weed(digits, length, (too_high.f - w.f) * unit, unsafe_interval, fractionals, one, unit) ? length : 0;
+        }
+    }
+
+    return 0;
+}
+#endif /* CJSON_FAST_NUMBERS */
+
+typedef struct
+{
+    const unsigned char *content;
+    size_t length;
+    size_t offset;
+    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
+    internal_hooks hooks;
+} parse_buffer;
+
+/* check if the given size is left to read in a given parse buffer (starting with 1) */
+#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
+/* check if the buffer can be accessed at the given index (starting with 0) */
+#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
+#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
+/* get a pointer to the buffer at the position */
+#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+
+/* Convert a number with strtod, returns the number of characters used or 0 if there is no number. */
+static size_t parse_number_strtod(const unsigned char * const input, const size_t length, double * const number)
+{
+    unsigned char *after_end = NULL;
+    unsigned char number_c_string[64];
+    unsigned char decimal_point = get_decimal_point();
+    size_t i = 0;
+
+    /* copy the number into a temporary buffer and replace '.' with the decimal point
+     * of the current locale (for strtod)
+     * This also takes care of '\0' not necessarily being available for marking the end of the input */
+    for (i = 0; (i < (sizeof(number_c_string) - 1)) && (i < length); i++)
+    {
+        switch (input[i])
+        {
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+            case '+':
+            case '-':
+            case 'e':
+            case 'E':
+                number_c_string[i] = input[i];
+                break;
+
+            case '.':
+                number_c_string[i] = decimal_point;
+                break;
+
+            default:
+                goto loop_end;
+        }
+    }
+loop_end:
+    number_c_string[i] = '\0';
+
+    *number = strtod((const char*)number_c_string, (char**)&after_end);
+
+    return (size_t)(after_end - number_c_string);
+}
+
+/* Parse the input text to generate a number, and populate the result into item. */
+static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+{
+    double number = 0;
+    size_t length = 0;
+
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    {
+        return false;
+    }
+
+#ifdef CJSON_FAST_NUMBERS
+    length = parse_number_fast(buffer_at_offset(input_buffer), input_buffer->length - input_buffer->offset, &number);
+#endif
+    if (length == 0)
+    {
+        length = parse_number_strtod(buffer_at_offset(input_buffer), input_buffer->length - input_buffer->offset, &number);
+        if (length == 0)
+        {
+            return false; /* parse_error */
+        }
+    }
+
+    item->valuedouble = number;
+
+    /* use saturation in case of overflow */
+    if (number >= INT_MAX)
+    {
+        item->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        item->valueint = INT_MIN;
+    }
+    else
+    {
+        item->valueint = (int)number;
+    }
+
+    item->type = cJSON_Number;
+
+    input_buffer->offset += length;
+    return true;
+}
+
+/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
+CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+{
+    if (number >= INT_MAX)
+    {
+        object->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        object->valueint = INT_MIN;
+    }
+    else
+    {
+        object->valueint = (int)number;
+    }
+
+    return object->valuedouble = number;
+}
+
+/* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
+CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+{
+    char *copy = NULL;
+    size_t v1_len;
+    size_t v2_len;
+    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
+    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    {
+        return NULL;
+    }
+    /* return NULL if the object is corrupted or valuestring is NULL */
+    if (object->valuestring == NULL || valuestring == NULL)
+    {
+        return NULL;
+    }
+
+    v1_len = strlen(valuestring);
+    v2_len = strlen(object->valuestring);
+
+    if (v1_len <= v2_len)
+    {
+        /* strcpy does not handle overlapping string: [X1, X2] [Y1, Y2] => X2 < Y1 or Y2 < X1 */
+        if (!( valuestring + v1_len < object->valuestring || object->valuestring + v2_len < valuestring ))
+        {
+            return NULL;
+        }
+        strcpy(object->valuestring, valuestring);
+        return object->valuestring;
+    }
+    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    if (object->valuestring != NULL)
+    {
+        cJSON_free(object->valuestring);
+    }
+    object->valuestring = copy;
+
+    return copy;
+}
+
+typedef struct
+{
+    unsigned char *buffer;
+    size_t length;
+    size_t offset;
+    size_t depth; /* current nesting depth (for formatted printing) */
+    cJSON_bool noalloc;
+    cJSON_bool format; /* is this print a formatted print */
+    internal_hooks hooks;
+} printbuffer;
+
+/* realloc printbuffer if necessary to have at least "needed" bytes more */
+static unsigned char* ensure(printbuffer * const p, size_t needed)
+{
+    unsigned char *newbuffer = NULL;
+    size_t newsize = 0;
+
+    if ((p == NULL) || (p->buffer == NULL))
+    {
+        return NULL;
+    }
+
+    if ((p->length > 0) && (p->offset > p->length))
+    {
+        /* make sure that offset is valid, it may point right past the end after a write without terminator */
+        return NULL;
+    }
+
+    if (needed > INT_MAX)
+    {
+        /* sizes bigger than INT_MAX are currently not supported */
+        return NULL;
+    }
+
+    /* every caller already accounts for the zero terminator it writes */
+    needed += p->offset;
+    if (needed <= p->length)
+    {
+        return p->buffer + p->offset;
+    }
+
+    if (p->noalloc) {
+        return NULL;
+    }
+
+    /* calculate new buffer size */
+    if (needed > (INT_MAX / 2))
+    {
+        /* overflow of int, use INT_MAX if possible */
+        if (needed <= INT_MAX)
+        {
+            newsize = INT_MAX;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        newsize = needed * 2;
+    }
+
+    if (p->hooks.reallocate != NULL)
+    {
+        /* reallocate with realloc if available */
+        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
+        if (newbuffer == NULL)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+    }
+    else
+    {
+        /* otherwise reallocate manually */
+        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
+        if (!newbuffer)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+
+        memcpy(newbuffer, p->buffer, p->offset);
+        p->hooks.deallocate(p->buffer);
+    }
+    p->length = newsize;
+    p->buffer = newbuffer;
+
+    return newbuffer + p->offset;
+}
+
+/* calculate the new length of the string in a printbuffer and update the offset */
+static void update_offset(printbuffer * const buffer)
+{
+    const unsigned char *buffer_pointer = NULL;
+    if ((buffer == NULL) || (buffer->buffer == NULL))
+    {
+        return;
+    }
+    buffer_pointer = buffer->buffer + buffer->offset;
+
+    buffer->offset += strlen((const char*)buffer_pointer);
+}
+
+/* securely comparison of floating-point variables */
+static cJSON_bool compare_double(double a, double b)
+{
+    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+}
+
+/* Print an int without sprintf, returns the length. */
+static int format_int(const int value, unsigned char * const output)
+{
+    unsigned char reversed[sizeof("-2147483648")];
+    unsigned int magnitude = (unsigned int)value;
+    int reversed_length = 0;
+    int length = 0;
+
+    if (value < 0)
+    {
+        /* also right for INT_MIN */
+        magnitude = 0U - magnitude;
+        output[length++] = '-';
+    }
+
+    do
+    {
+        reversed[reversed_length++] = (unsigned char)('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    while (reversed_length > 0)
+    {
+        output[length++] = reversed[--reversed_length];
+    }
+    output[length] = '\0';
+
+    return length;
+}
+
+/* Print digits * 10^exponent the way printf's %g does, with a precision of 15 digits, or 17 for more digits.
+ * Returns the length. */
+static int format_decimal(const cJSON_bool negative, const unsigned char * const digits, int digit_count, int exponent, unsigned char * const output)
+{
+    int scientific_exponent = 0;
+    int precision = 0;
+    int length = 0;
+    int i = 0;
+
+    while ((digit_count > 1) && (digits[digit_count - 1] == '0'))
+    {
+        digit_count--;
+        exponent++;
+    }
+    scientific_exponent = digit_count - 1 + exponent;
+    precision = (digit_count <= 15) ? 15 : 17;
+
+    if (negative)
+    {
+        output[length++] = '-';
+    }
+
+    if ((scientific_exponent < -4) || (scientific_exponent >= precision))
+    {
+        output[length++] = digits[0];
+        if (digit_count > 1)
+        {
+            output[length++] = '.';
+            memcpy(output + length, digits + 1, (size_t)(digit_count - 1));
+            length += digit_count - 1;
+        }
+        output[length++] = 'e';
+        output[length++] = (scientific_exponent < 0) ? '-' : '+';
+        if (scientific_exponent < 0)
+        {
+            scientific_exponent = -scientific_exponent;
+        }
+        /* at least two digits, at most three */
+        if (scientific_exponent >= 100)
+        {
+            output[length++] = (unsigned char)('0' + (scientific_exponent / 100));
+        }
+        output[length++] = (unsigned char)('0' + ((scientific_exponent / 10) % 10));
+        output[length++] = (unsigned char)('0' + (scientific_exponent % 10));
+    }
+    else if (scientific_exponent >= 0)
+    {
+        for (i = 0; i <= scientific_exponent; i++)
+        {
+            output[length++] = (i < digit_count) ? digits[i] : (unsigned char)'0';
+        }
+        if (digit_count > (scientific_exponent + 1))
+        {
+            output[length++] = '.';
+            memcpy(output + length, digits + scientific_exponent + 1, (size_t)(digit_count - scientific_exponent - 1));
+            length += digit_count - scientific_exponent - 1;
+        }
+    }
+    else
+    {
+        output[length++] = '0';
+        output[length++] = '.';
+        for (i = -1; i > scientific_exponent; i--)
+        {
+            output[length++] = '0';
+        }
+        memcpy(output + length, digits, (size_t)digit_count);
+        length += digit_count;
+    }
+    output[length] = '\0';
+
+    return length;
+}
+
+/* Shortest digits of a positive double with sprintf and strtod, value = digits * 10^decimal_exponent.
+ * Returns the number of digits, or 0 on failure. */
+static int shortest_digits_sprintf(const double value, unsigned char * const digits, int * const decimal_exponent)
+{
+    char printed[32];
+    char *exponent_start = NULL;
+    int precision = 15;
+    int digit_count = 0;
+    int i = 0;
+
+    /* rounded to 15 digits with the trailing zeros removed is the shortest form if one of up to 15 digits exists,
+     * except for subnormals which have less precision */
+    for (precision = (value < DBL_MIN) ? 1 : 15; precision < 17; precision++)
+    {
+        sprintf(printed, "%1.*e", precision - 1, value);
+        if (strtod(printed, NULL) == value)
+        {
+            break;
+        }
+    }
+    if (precision == 17)
+    {
+        sprintf(printed, "%1.16e", value);
+    }
+
+    /* the decimal point depends on the locale, skip whatever isn't a digit */
+    for (i = 0; (printed[i] != '\0') && (printed[i] != 'e') && (digit_count < precision); i++)
+    {
+        if ((printed[i] >= '0') && (printed[i] <= '9'))
+        {
+            digits[digit_count++] = (unsigned char)printed[i];
+        }
+    }
+    exponent_start = strchr(printed, 'e');
+    if ((exponent_start == NULL) || (digit_count == 0))
+    {
+        return 0;
+    }
+
+    *decimal_exponent = (int)strtol(exponent_start + 1, NULL, 10) - (digit_count - 1);
+
+    return digit_count;
+}
+
+/* Print the number into number_buffer (at least 26 bytes), returns the length or -1 on failure.
+ * Numbers are printed with the fewest digits that parse back to the same double. */
+static int format_number(const cJSON * const item, unsigned char * const number_buffer)
+{
+    double d = item->valuedouble;
+    unsigned char digits[17];
+    int digit_count = 0;
+    int exponent = 0;
+
+    /* This checks for NaN and Infinity */
+    if (isnan(d) || isinf(d))
+    {
+        memcpy(number_buffer, "null", sizeof("null"));
+        return (int)sizeof("null") - 1;
+    }
+
+    if (d == (double)item->valueint)
+    {
+        return format_int(item->valueint, number_buffer);
+    }
+
+#ifdef CJSON_FAST_NUMBERS
+    digit_count = grisu3(fabs(d), digits, &exponent);
+#endif
+    if (digit_count == 0)
+    {
+        digit_count = shortest_digits_sprintf(fabs(d), digits, &exponent);
+        if (digit_count == 0)
+        {
+            return -1;
+        }
+    }
+
+    return format_decimal(d < 0, digits, digit_count, exponent, number_buffer);
+}
+
+/* Render the number nicely from the given item into a string. */
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    int length = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    length = format_number(item, number_buffer);
+    if (length < 0)
+    {
+        return false;
+    }
+
+    /* reserve appropriate space in the output */
+    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    /* the printed number always uses '.', whatever the locale */
+    memcpy(output_pointer, number_buffer, (size_t)length + sizeof(""));
+
+    output_buffer->offset += (size_t)length;
+
+    return true;
+}
+
+/* parse 4 digit hexadecimal number */
+static unsigned parse_hex4(const unsigned char * const input)
+{
+    unsigned int h = 0;
+    size_t i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        /* parse digit */
+        if ((input[i] >= '0') && (input[i] <= '9'))
+        {
+            h += (unsigned int) input[i] - '0';
+        }
+        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        {
+            h += (unsigned int) 10 + input[i] - 'A';
+        }
+        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        {
+            h += (unsigned int) 10 + input[i] - 'a';
+        }
+        else /* invalid */
+        {
+            return 0;
+        }
+
+        if (i < 3)
+        {
+            /* shift left to make place for the next nibble */
+            h = h << 4;
+        }
+    }
+
+    return h;
+}
+
+/* encode a unicode codepoint as UTF-8, returns the number of bytes written (at most 4) or 0 for invalid codepoints */
+static unsigned char encode_utf8(long unsigned int codepoint, unsigned char * const output)
+{
+    unsigned char utf8_length = 0;
+    unsigned char utf8_position = 0;
+    unsigned char first_byte_mark = 0;
+
+    /* encode as UTF-8
+     * takes at maximum 4 bytes to encode:
+     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
+    if (codepoint < 0x80)
+    {
+        /* normal ascii, encoding 0xxxxxxx */
+        utf8_length = 1;
+    }
+    else if (codepoint < 0x800)
+    {
+        /* two bytes, encoding 110xxxxx 10xxxxxx */
+        utf8_length = 2;
+        first_byte_mark = 0xC0; /* 11000000 */
+    }
+    else if (codepoint < 0x10000)
+    {
+        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 3;
+        first_byte_mark = 0xE0; /* 11100000 */
+    }
+    else if (codepoint <= 0x10FFFF)
+    {
+        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 4;
+        first_byte_mark = 0xF0; /* 11110000 */
+    }
+    else
+    {
+        /* invalid unicode codepoint */
+        return 0;
+    }
+
+    /* encode as utf8 */
+    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    {
+        /* 10xxxxxx */
+        output[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
+        codepoint >>= 6;
+    }
+    /* encode first byte */
+    if (utf8_length > 1)
+    {
+        output[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+    }
+    else
+    {
+        output[0] = (unsigned char)(codepoint & 0x7F);
+    }
+
+    return utf8_length;
+}
+
+/* converts a UTF-16 literal to UTF-8
+ * A literal can be one or two sequences of the form \uXXXX */
+static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+{
+    long unsigned int codepoint = 0;
+    unsigned int first_code = 0;
+    const unsigned char *first_sequence = input_pointer;
+    unsigned char utf8_length = 0;
+    unsigned char sequence_length = 0;
+
+    if ((input_end - first_sequence) < 6)
+    {
+        /* input ends unexpectedly */
+        goto fail;
+    }
+
+    /* get the first utf16 sequence */
+    first_code = parse_hex4(first_sequence + 2);
+
+    /* check that the code is valid */
+    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    {
+        goto fail;
+    }
+
+    /* UTF16 surrogate pair */
+    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    {
+        const unsigned char *second_sequence = first_sequence + 6;
+        unsigned int second_code = 0;
+        sequence_length = 12; /* \uXXXX\uXXXX */
+
+        if ((input_end - second_sequence) < 6)
+        {
+            /* input ends unexpectedly */
+            goto fail;
+        }
+
+        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+        {
+            /* missing second half of the surrogate pair */
+            goto fail;
+        }
+
+        /* get the second utf16 sequence */
+        second_code = parse_hex4(second_sequence + 2);
+        /* check that the code is valid */
+        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        {
+            /* invalid second half of the surrogate pair */
+            goto fail;
+        }
+
+
+        /* calculate the unicode codepoint from the surrogate pair */
+        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+    }
+    else
+    {
+        sequence_length = 6; /* \uXXXX */
+        codepoint = first_code;
+    }
+
+    utf8_length = encode_utf8(codepoint, *output_pointer);
+    if (utf8_length == 0)
+    {
+        goto fail;
+    }
+
+    *output_pointer += utf8_length;
+
+    return sequence_length;
+
+fail:
+    return 0;
+}
+
+/* Word at a time (SWAR) scanning: every byte of SWAR_ONES is 0x01, every byte of SWAR_HIGHS is 0x80. */
+#define SWAR_ONES ((size_t)-1 / 0xFF)
+#define SWAR_HIGHS (SWAR_ONES * 0x80)
+
+/* Bytes that end a run of plain characters in a string literal. */
+static cJSON_bool is_string_special(const unsigned char character)
+{
+    return (character == '\"') || (character == '\\') || (character < 0x20);
+}
+
+/* true if any byte of the word is a quote, a backslash or a control character */
+static cJSON_bool swar_has_string_special(const size_t word)
+{
+    const size_t quotes = word ^ (SWAR_ONES * '\"');
+    const size_t backslashes = word ^ (SWAR_ONES * '\\');
+
+    return ((((quotes - SWAR_ONES) & ~quotes) | ((backslashes - SWAR_ONES) & ~backslashes) | ((word - (SWAR_ONES * 0x20)) & ~word)) & SWAR_HIGHS) != 0;
+}
+
+/* true if any byte of the word is above ' ', so not whitespace */
+static cJSON_bool swar_has_non_whitespace(const size_t word)
+{
+    return (((word + (SWAR_ONES * (127 - 0x20))) | word) & SWAR_HIGHS) != 0;
+}
+
+#ifdef CJSON_SIMD_SSE2
+/* index of the lowest set bit of a mask that isn't zero */
+static unsigned int lowest_set_bit(unsigned int mask)
+{
+#ifdef __GNUC__
+    return (unsigned int)__builtin_ctz(mask);
+#else
+    unsigned int position = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        position++;
+    }
+    return position;
+#endif
+}
+#endif
+
+/* Returns the first quote, backslash or control character in [pointer, end), or end if there is none.
+ * Takes 16 bytes per step with SSE2 or NEON and a word per step otherwise. */
+static const unsigned char *scan_string_bytes(const unsigned char *pointer, const unsigned char * const end)
+{
+    size_t word = 0;
+
+#if defined(CJSON_SIMD_SSE2)
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+
+    while ((end - pointer) >= 16)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)pointer);
+        /* max(chunk, 0x1F) == 0x1F is an unsigned chunk <= 0x1F */
+        const __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), _mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+        const int mask = _mm_movemask_epi8(found);
+        if (mask != 0)
+        {
+            return pointer + lowest_set_bit((unsigned int)mask);
+        }
+        pointer += 16;
+    }
+#elif defined(CJSON_SIMD_NEON)
+    const uint8x16_t quote = vdupq_n_u8('\"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t control = vdupq_n_u8(0x20);
+
+    while ((end - pointer) >= 16)
+    {
+        const uint8x16_t chunk = vld1q_u8(pointer);
+        const uint8x16_t found = vorrq_u8(vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash)), vcltq_u8(chunk, control));
+        if (vmaxvq_u8(found) != 0)
+        {
+            /* the word and byte loops below find the exact position */
+            break;
+        }
+        pointer += 16;
+    }
+#endif
+
+    while ((size_t)(end - pointer) >= sizeof(word))
+    {
+        memcpy(&word, pointer, sizeof(word));
+        if (swar_has_string_special(word))
+        {
+            break;
+        }
+        pointer += sizeof(word);
+    }
+
+    while ((pointer < end) && !is_string_special(*pointer))
+    {
+        pointer++;
+    }
+
+    return pointer;
+}
+
+/* Returns the first byte above ' ' in [pointer, end), or end if there is none. */
+static const unsigned char *scan_whitespace_bytes(const unsigned char *pointer, const unsigned char * const end)
+{
+    size_t word = 0;
+    size_t narrow_bytes = ((size_t)(end - pointer) > sizeof(word)) ? sizeof(word) : (size_t)(end - pointer);
+
+    /* most runs of whitespace between tokens are short, check their first bytes one at a time */
+    for (; narrow_bytes > 0; narrow_bytes--)
+    {
+        if (*pointer > 0x20)
+        {
+            return pointer;
+        }
+        pointer++;
+    }
+
+#if defined(CJSON_SIMD_SSE2)
+    {
+        const __m128i spaces = _mm_set1_epi8(0x20);
+
+        while ((end - pointer) >= 16)
+        {
+            const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)pointer);
+            /* max(chunk, ' ') == ' ' is an unsigned chunk <= ' ' */
+            const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, spaces), spaces)) ^ 0xFFFF;
+            if (mask != 0)
+            {
+                return pointer + lowest_set_bit((unsigned int)mask);
+            }
+            pointer += 16;
+        }
+    }
+#elif defined(CJSON_SIMD_NEON)
+    {
+        const uint8x16_t spaces = vdupq_n_u8(0x20);
+
+        while ((end - pointer) >= 16)
+        {
+            if (vmaxvq_u8(vcgtq_u8(vld1q_u8(pointer), spaces)) != 0)
+            {
+                break;
+            }
+            pointer += 16;
+        }
+    }
+#endif
+
+    while ((size_t)(end - pointer) >= sizeof(word))
+    {
+        memcpy(&word, pointer, sizeof(word));
+        if (swar_has_non_whitespace(word))
+        {
+            break;
+        }
+        pointer += sizeof(word);
+    }
+
+    while ((pointer < end) && (*pointer <= 0x20))
+    {
+        pointer++;
+    }
+
+    return pointer;
+}
+
+/* Parse the input text into an unescaped cinput, and populate item. */
+static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+    unsigned char *output_pointer = NULL;
+    unsigned char *output = NULL;
+    size_t skipped_bytes = 0;
+
+    /* not a string */
+    if (buffer_at_offset(input_buffer)[0] != '\"')
+    {
+        goto fail;
+    }
+
+    {
+        /* calculate approximate size of the output (overestimate) */
+        const unsigned char *content_end = input_buffer->content + input_buffer->length;
+        size_t allocation_length = 0;
+        for (;;)
+        {
+            input_end = scan_string_bytes(input_end, content_end);
+            if ((input_end >= content_end) || (*input_end == '\"'))
+            {
+                break;
+            }
+
+            /* is escape sequence */
+            if (input_end[0] == '\\')
+            {
+                if ((input_end + 1) >= content_end)
+                {
+                    /* prevent buffer overflow when last input character is a backslash */
+                    goto fail;
+                }
+                skipped_bytes++;
+                input_end++;
+            }
+            /* control characters are copied as they are */
+            input_end++;
+        }
+        if ((input_end >= content_end) || (*input_end != '\"'))
+        {
+            goto fail; /* string ended unexpectedly */
+        }
+
+        /* This is at most how much we need for the output */
+        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        if (output == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+    }
+
+    output_pointer = output;
+    if (skipped_bytes == 0)
+    {
+        /* no escape sequences, copy the string literal as it is */
+        memcpy(output_pointer, input_pointer, (size_t)(input_end - input_pointer));
+        output_pointer += input_end - input_pointer;
+        input_pointer = input_end;
+    }
+    /* loop through the string literal */
+    while (input_pointer < input_end)
+    {
+        if (*input_pointer != '\\')
+        {
+            /* copy everything up to the next escape sequence at once */
+            const unsigned char *run_end = input_pointer;
+            do
+            {
+                run_end = scan_string_bytes(run_end + 1, input_end);
+            } while ((run_end < input_end) && (*run_end != '\\'));
+
+            memcpy(output_pointer, input_pointer, (size_t)(run_end - input_pointer));
+            output_pointer += run_end - input_pointer;
+            input_pointer = run_end;
+        }
+        /* escape sequence */
+        else
+        {
+            unsigned char sequence_length = 2;
+            if ((input_end - input_pointer) < 1)
+            {
+                goto fail;
+            }
+
+            switch (input_pointer[1])
+            {
+                case 'b':
+                    *output_pointer++ = '\b';
+                    break;
+                case 'f':
+                    *output_pointer++ = '\f';
+                    break;
+                case 'n':
+                    *output_pointer++ = '\n';
+                    break;
+                case 'r':
+                    *output_pointer++ = '\r';
+                    break;
+                case 't':
+                    *output_pointer++ = '\t';
+                    break;
+                case '\"':
+                case '\\':
+                case '/':
+                    *output_pointer++ = input_pointer[1];
+                    break;
+
+                /* UTF-16 literal */
+                case 'u':
+                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
+                    if (sequence_length == 0)
+                    {
+                        /* failed to convert UTF16-literal to UTF-8 */
+                        goto fail;
+                    }
+                    break;
+
+                default:
+                    goto fail;
+            }
+            input_pointer += sequence_length;
+        }
+    }
+
+    /* zero terminate the output */
+    *output_pointer = '\0';
+
+    item->type = cJSON_String;
+    item->valuestring = (char*)output;
+
+    input_buffer->offset = (size_t) (input_end - input_buffer->content);
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if (output != NULL)
+    {
+        input_buffer->hooks.deallocate(output);
+        output = NULL;
+    }
+
+    if (input_pointer != NULL)
+    {
+        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+    }
+
+    return false;
+}
+
+/* Count the characters that have to be added to escape a cstring, stores its length in input_length. */
+static size_t count_escape_characters(const unsigned char * const input, size_t * const input_length)
+{
+    const unsigned char *input_pointer = NULL;
+    size_t escape_characters = 0;
+
+    for (input_pointer = input; *input_pointer; input_pointer++)
+    {
+        switch (*input_pointer)
+        {
+            case '\"':
+            case '\\':
+            case '\b':
+            case '\f':
+            case '\n':
+            case '\r':
+            case '\t':
+                /* one character escape sequence */
+                escape_characters++;
+                break;
+            default:
+                if (*input_pointer < 32)
+                {
+                    /* UTF-16 escape sequence uXXXX */
+                    escape_characters += 5;
+                }
+                break;
+        }
+    }
+    *input_length = (size_t)(input_pointer - input);
+
+    return escape_characters;
+}
+
+/* Render the cstring provided to an escaped version that can be printed. */
+static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+{
+    const unsigned char *input_pointer = NULL;
+    unsigned char *output = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t output_length = 0;
+    /* numbers of additional characters needed for escaping */
+    size_t escape_characters = 0;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* empty string */
+    if (input == NULL)
+    {
+        output = ensure(output_buffer, sizeof("\"\""));
+        if (output == NULL)
+        {
+            return false;
+        }
+        strcpy((char*)output, "\"\"");
+
+        return true;
+    }
+
+    escape_characters = count_escape_characters(input, &output_length);
+    output_length += escape_characters;
+
+    output = ensure(output_buffer, output_length + sizeof("\"\""));
+    if (output == NULL)
+    {
+        return false;
+    }
+
+    /* no characters have to be escaped */
+    if (escape_characters == 0)
+    {
+        output[0] = '\"';
+        memcpy(output + 1, input, output_length);
+        output[output_length + 1] = '\"';
+        output[output_length + 2] = '\0';
+
+        return true;
+    }
+
+    output[0] = '\"';
+    output_pointer = output + 1;
+    /* copy the string */
+    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+    {
+        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        {
+            /* normal character, copy */
+            *output_pointer = *input_pointer;
+        }
+        else
+        {
+            /* character needs to be escaped */
+            *output_pointer++ = '\\';
+            switch (*input_pointer)
+            {
+                case '\\':
+                    *output_pointer = '\\';
+                    break;
+                case '\"':
+                    *output_pointer = '\"';
+                    break;
+                case '\b':
+                    *output_pointer = 'b';
+                    break;
+                case '\f':
+                    *output_pointer = 'f';
+                    break;
+                case '\n':
+                    *output_pointer = 'n';
+                    break;
+                case '\r':
+                    *output_pointer = 'r';
+                    break;
+                case '\t':
+                    *output_pointer = 't';
+                    break;
+                default:
+                    /* escape and print as unicode codepoint */
+                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
+                    output_pointer += 4;
+                    break;
+            }
+        }
+    }
+    output[output_length + 1] = '\"';
+    output[output_length + 2] = '\0';
+
+    return true;
+}
+
+/* Invoke print_string_ptr (which is useful) on an item. */
+static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+{
+    return print_string_ptr((unsigned char*)item->valuestring, p);
+}
+
+/* Predeclare these prototypes. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool printed_length(const cJSON * const item, size_t depth, const cJSON_bool format, size_t * const length);
+
+/* Utility to jump whitespace and cr/lf */
+static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL))
     {
-        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 4;
-        first_byte_mark = 0xF0; /* 11110000 */
+        return NULL;
     }
-    else
+
+    if (cannot_access_at_index(buffer, 0))
     {
-        /* invalid unicode codepoint */
-        goto fail;
+        return buffer;
     }
 
-    /* encode as utf8 */
-    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    buffer->offset = (size_t)(scan_whitespace_bytes(buffer_at_offset(buffer), buffer->content + buffer->length) - buffer->content);
+
+    if (buffer->offset == buffer->length)
     {
-        /* 10xxxxxx */
-        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
-        codepoint >>= 6;
+        buffer->offset--;
     }
-    /* encode first byte */
-    if (utf8_length > 1)
+
+    return buffer;
+}
+
+/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
+static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
     {
-        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+        return NULL;
     }
-    else
+
+    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
     {
-        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+        buffer->offset += 3;
     }
 
-    *output_pointer += utf8_length;
+    return buffer;
+}
 
-    return sequence_length;
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    size_t buffer_length;
 
-fail:
-    return 0;
+    if (NULL == value)
+    {
+        return NULL;
+    }
+
+    /* Adding null character size due to require_null_terminated. */
+    buffer_length = strlen(value) + sizeof("");
+
+    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
 }
 
-/* Parse the input text into an unescaped cinput, and populate item. */
-static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+/* Parse an object - create a new root, and populate. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
 {
-    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
-    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
-    unsigned char *output_pointer = NULL;
-    unsigned char *output = NULL;
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    cJSON *item = NULL;
 
-    /* not a string */
-    if (buffer_at_offset(input_buffer)[0] != '\"')
+    /* reset error position */
+    global_error.json = NULL;
+    global_error.position = 0;
+
+    if (value == NULL || 0 == buffer_length)
+    {
+        goto fail;
+    }
+
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
+    buffer.offset = 0;
+    buffer.hooks = global_hooks;
+
+    item = cJSON_New_Item(&global_hooks);
+    if (item == NULL) /* memory fail */
     {
         goto fail;
     }
 
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
     {
-        /* calculate approximate size of the output (overestimate) */
-        size_t allocation_length = 0;
-        size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
+        /* parse failure. ep is set. */
+        goto fail;
+    }
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
         {
-            /* is escape sequence */
-            if (input_end[0] == '\\')
-            {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
-                {
-                    /* prevent buffer overflow when last input character is a backslash */
-                    goto fail;
-                }
-                skipped_bytes++;
-                input_end++;
-            }
-            input_end++;
+            goto fail;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    }
+
+    return item;
+
+fail:
+    if (item != NULL)
+    {
+        cJSON_Delete(item);
+    }
+
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer.offset < buffer.length)
+        {
+            local_error.position = buffer.offset;
         }
-        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
+        else if (buffer.length > 0)
         {
-            goto fail; /* string ended unexpectedly */
+            local_error.position = buffer.length - 1;
         }
 
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
+        if (return_parse_end != NULL)
         {
-            goto fail; /* allocation failure */
+            *return_parse_end = (const char*)local_error.json + local_error.position;
         }
+
+        global_error = local_error;
     }
 
-    output_pointer = output;
-    /* loop through the string literal */
-    while (input_pointer < input_end)
+    return NULL;
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+/* Streaming parser: the input goes through a state machine one byte (or one run of plain bytes) at a time,
+ * so every token can be split across chunks anywhere. Strings, keys and numbers are collected in the token buffer. */
+typedef enum
+{
+    sax_start, /* start of the input, possibly with a UTF-8 BOM */
+    sax_value, /* a value has to follow */
+    sax_value_or_end, /* first value of an array or the ']' of an empty one */
+    sax_key, /* a key has to follow */
+    sax_key_or_end, /* first key of an object or the '}' of an empty one */
+    sax_colon,
+    sax_after_value, /* ',' or the end of the array or object, only whitespace after the root value */
+    sax_string,
+    sax_escape,
+    sax_unicode, /* hex digits of \uXXXX */
+    sax_surrogate_backslash, /* start of the second half of a surrogate pair */
+    sax_surrogate_u,
+    sax_number,
+    sax_literal, /* true, false or null */
+    sax_error
+} sax_state;
+
+static cJSON_bool sax_append(cJSON_SaxParser * const parser, const unsigned char * const bytes, const size_t length)
+{
+    /* always keep room for the zero terminator */
+    if ((parser->token_size - parser->token_length) <= length)
     {
-        if (*input_pointer != '\\')
-        {
-            *output_pointer++ = *input_pointer++;
-        }
-        /* escape sequence */
-        else
-        {
-            unsigned char sequence_length = 2;
-            if ((input_end - input_pointer) < 1)
-            {
-                goto fail;
-            }
+        return false;
+    }
 
-            switch (input_pointer[1])
-            {
-                case 'b':
-                    *output_pointer++ = '\b';
-                    break;
-                case 'f':
-                    *output_pointer++ = '\f';
-                    break;
-                case 'n':
-                    *output_pointer++ = '\n';
-                    break;
-                case 'r':
-                    *output_pointer++ = '\r';
-                    break;
-                case 't':
-                    *output_pointer++ = '\t';
-                    break;
-                case '\"':
-                case '\\':
-                case '/':
-                    *output_pointer++ = input_pointer[1];
-                    break;
+    memcpy(parser->token + parser->token_length, bytes, length);
+    parser->token_length += length;
 
-                /* UTF-16 literal */
-                case 'u':
-                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
-                    if (sequence_length == 0)
-                    {
-                        /* failed to convert UTF16-literal to UTF-8 */
-                        goto fail;
-                    }
-                    break;
+    return true;
+}
 
-                default:
-                    goto fail;
-            }
-            input_pointer += sequence_length;
-        }
+static cJSON_bool sax_in_object(const cJSON_SaxParser * const parser)
+{
+    return (parser->in_object[(parser->depth - 1) / 8] >> ((parser->depth - 1) % 8)) & 1;
+}
+
+static cJSON_bool sax_emit_value(cJSON_SaxParser * const parser, const cJSON * const item)
+{
+    parser->state = sax_after_value;
+
+    return (parser->callbacks->value == NULL) || parser->callbacks->value(parser->user_data, item);
+}
+
+static cJSON_bool sax_begin_container(cJSON_SaxParser * const parser, const cJSON_bool object)
+{
+    unsigned char bit = (unsigned char)(1U << (parser->depth % 8));
+
+    if (parser->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false; /* too deeply nested */
     }
 
-    /* zero terminate the output */
-    *output_pointer = '\0';
+    if (object)
+    {
+        parser->in_object[parser->depth / 8] = (unsigned char)(parser->in_object[parser->depth / 8] | bit);
+        parser->state = sax_key_or_end;
+    }
+    else
+    {
+        parser->in_object[parser->depth / 8] = (unsigned char)(parser->in_object[parser->depth / 8] & ~bit);
+        parser->state = sax_value_or_end;
+    }
+    parser->depth++;
 
-    item->type = cJSON_String;
-    item->valuestring = (char*)output;
+    if (object)
+    {
+        return (parser->callbacks->begin_object == NULL) || parser->callbacks->begin_object(parser->user_data);
+    }
+    return (parser->callbacks->begin_array == NULL) || parser->callbacks->begin_array(parser->user_data);
+}
 
-    input_buffer->offset = (size_t) (input_end - input_buffer->content);
-    input_buffer->offset++;
+static cJSON_bool sax_end_container(cJSON_SaxParser * const parser, const cJSON_bool object)
+{
+    if ((parser->depth == 0) || (sax_in_object(parser) != object))
+    {
+        return false; /* closing bracket doesn't match */
+    }
 
-    return true;
+    parser->depth--;
+    parser->state = sax_after_value;
+
+    if (object)
+    {
+        return (parser->callbacks->end_object == NULL) || parser->callbacks->end_object(parser->user_data);
+    }
+    return (parser->callbacks->end_array == NULL) || parser->callbacks->end_array(parser->user_data);
+}
+
+static cJSON_bool sax_begin_value(cJSON_SaxParser * const parser, const unsigned char character)
+{
+    parser->token_length = 0;
 
-fail:
-    if (output != NULL)
+    if (character == '{')
     {
-        input_buffer->hooks.deallocate(output);
-        output = NULL;
+        return sax_begin_container(parser, true);
+    }
+    if (character == '[')
+    {
+        return sax_begin_container(parser, false);
+    }
+    if (character == '\"')
+    {
+        parser->in_key = false;
+        parser->state = sax_string;
+        return true;
+    }
+    if ((character == '-') || ((character >= '0') && (character <= '9')))
+    {
+        parser->state = sax_number;
+        return sax_append(parser, &character, 1);
     }
 
-    if (input_pointer != NULL)
+    if (character == 't')
     {
-        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+        parser->literal = "true";
+    }
+    else if (character == 'f')
+    {
+        parser->literal = "false";
+    }
+    else if (character == 'n')
+    {
+        parser->literal = "null";
+    }
+    else
+    {
+        return false;
     }
+    parser->counter = 1;
+    parser->state = sax_literal;
 
-    return false;
+    return true;
 }
 
-/* Render the cstring provided to an escaped version that can be printed. */
-static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+/* Handle a byte that isn't whitespace between tokens. */
+static cJSON_bool sax_structural(cJSON_SaxParser * const parser, const unsigned char character)
 {
-    const unsigned char *input_pointer = NULL;
-    unsigned char *output = NULL;
-    unsigned char *output_pointer = NULL;
-    size_t output_length = 0;
-    /* numbers of additional characters needed for escaping */
-    size_t escape_characters = 0;
-
-    if (output_buffer == NULL)
+    if ((parser->state == sax_value_or_end) && (character == ']'))
     {
-        return false;
+        return sax_end_container(parser, false);
+    }
+    if ((parser->state == sax_value) || (parser->state == sax_value_or_end))
+    {
+        return sax_begin_value(parser, character);
     }
 
-    /* empty string */
-    if (input == NULL)
+    if ((parser->state == sax_key_or_end) && (character == '}'))
     {
-        output = ensure(output_buffer, sizeof("\"\""));
-        if (output == NULL)
+        return sax_end_container(parser, true);
+    }
+    if ((parser->state == sax_key) || (parser->state == sax_key_or_end))
+    {
+        if (character != '\"')
         {
             return false;
         }
-        strcpy((char*)output, "\"\"");
-
+        parser->token_length = 0;
+        parser->in_key = true;
+        parser->state = sax_string;
         return true;
     }
 
-    /* set "flag" to 1 if something needs to be escaped */
-    for (input_pointer = input; *input_pointer; input_pointer++)
+    if (parser->state == sax_colon)
     {
-        switch (*input_pointer)
+        if (character != ':')
         {
-            case '\"':
-            case '\\':
-            case '\b':
-            case '\f':
-            case '\n':
-            case '\r':
-            case '\t':
-                /* one character escape sequence */
-                escape_characters++;
-                break;
-            default:
-                if (*input_pointer < 32)
-                {
-                    /* UTF-16 escape sequence uXXXX */
-                    escape_characters += 5;
-                }
-                break;
+            return false;
         }
+        parser->state = sax_value;
+        return true;
     }
-    output_length = (size_t)(input_pointer - input) + escape_characters;
 
-    output = ensure(output_buffer, output_length + sizeof("\"\""));
-    if (output == NULL)
+    /* sax_after_value, nothing but whitespace may follow the root value */
+    if (parser->depth == 0)
     {
         return false;
     }
+    if (character == ',')
+    {
+        parser->state = sax_in_object(parser) ? sax_key : sax_value;
+        return true;
+    }
+    if ((character == '}') || (character == ']'))
+    {
+        return sax_end_container(parser, character == '}');
+    }
 
-    /* no characters have to be escaped */
-    if (escape_characters == 0)
+    return false;
+}
+
+static cJSON_bool sax_end_string(cJSON_SaxParser * const parser)
+{
+    cJSON item;
+
+    parser->token[parser->token_length] = '\0';
+
+    if (parser->in_key)
     {
-        output[0] = '\"';
-        memcpy(output + 1, input, output_length);
-        output[output_length + 1] = '\"';
-        output[output_length + 2] = '\0';
+        parser->state = sax_colon;
+        return (parser->callbacks->key == NULL) || parser->callbacks->key(parser->user_data, parser->token, parser->token_length);
+    }
+
+    memset(&item, '\0', sizeof(item));
+    item.type = cJSON_String;
+    item.valuestring = parser->token;
+
+    return sax_emit_value(parser, &item);
+}
+
+static cJSON_bool sax_escape_character(cJSON_SaxParser * const parser, const unsigned char character)
+{
+    unsigned char decoded = character;
+
+    switch (character)
+    {
+        case 'b':
+            decoded = '\b';
+            break;
+        case 'f':
+            decoded = '\f';
+            break;
+        case 'n':
+            decoded = '\n';
+            break;
+        case 'r':
+            decoded = '\r';
+            break;
+        case 't':
+            decoded = '\t';
+            break;
+        case '\"':
+        case '\\':
+        case '/':
+            break;
+
+        case 'u':
+            parser->counter = 0;
+            parser->code_unit = 0;
+            parser->state = sax_unicode;
+            return true;
+
+        default:
+            return false;
+    }
+
+    parser->state = sax_string;
+
+    return sax_append(parser, &decoded, 1);
+}
+
+/* One hex digit of \uXXXX, surrogate pairs are combined like in utf16_literal_to_utf8 */
+static cJSON_bool sax_unicode_digit(cJSON_SaxParser * const parser, const unsigned char character)
+{
+    unsigned char utf8[4];
+    unsigned char utf8_length = 0;
+    long unsigned int codepoint = 0;
+
+    if ((character >= '0') && (character <= '9'))
+    {
+        parser->code_unit = (parser->code_unit << 4) | (unsigned int)(character - '0');
+    }
+    else if ((character >= 'A') && (character <= 'F'))
+    {
+        parser->code_unit = (parser->code_unit << 4) | (unsigned int)(10 + character - 'A');
+    }
+    else if ((character >= 'a') && (character <= 'f'))
+    {
+        parser->code_unit = (parser->code_unit << 4) | (unsigned int)(10 + character - 'a');
+    }
+    else
+    {
+        return false;
+    }
 
+    parser->counter++;
+    if (parser->counter < 4)
+    {
         return true;
     }
 
-    output[0] = '\"';
-    output_pointer = output + 1;
-    /* copy the string */
-    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+    if (parser->high_surrogate == 0)
     {
-        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        if ((parser->code_unit >= 0xDC00) && (parser->code_unit <= 0xDFFF))
         {
-            /* normal character, copy */
-            *output_pointer = *input_pointer;
+            return false; /* second half of a surrogate pair on its own */
         }
-        else
+        if ((parser->code_unit >= 0xD800) && (parser->code_unit <= 0xDBFF))
         {
-            /* character needs to be escaped */
-            *output_pointer++ = '\\';
-            switch (*input_pointer)
-            {
-                case '\\':
-                    *output_pointer = '\\';
-                    break;
-                case '\"':
-                    *output_pointer = '\"';
-                    break;
-                case '\b':
-                    *output_pointer = 'b';
-                    break;
-                case '\f':
-                    *output_pointer = 'f';
-                    break;
-                case '\n':
-                    *output_pointer = 'n';
-                    break;
-                case '\r':
-                    *output_pointer = 'r';
-                    break;
-                case '\t':
-                    *output_pointer = 't';
-                    break;
-                default:
-                    /* escape and print as unicode codepoint */
-                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
-                    output_pointer += 4;
-                    break;
-            }
+            parser->high_surrogate = parser->code_unit;
+            parser->state = sax_surrogate_backslash;
+            return true;
         }
+        codepoint = parser->code_unit;
+    }
+    else
+    {
+        if ((parser->code_unit < 0xDC00) || (parser->code_unit > 0xDFFF))
+        {
+            return false; /* invalid second half of the surrogate pair */
+        }
+        codepoint = 0x10000 + (((parser->high_surrogate & 0x3FF) << 10) | (parser->code_unit & 0x3FF));
+        parser->high_surrogate = 0;
     }
-    output[output_length + 1] = '\"';
-    output[output_length + 2] = '\0';
 
-    return true;
+    utf8_length = encode_utf8(codepoint, utf8);
+    parser->state = sax_string;
+
+    return (utf8_length > 0) && sax_append(parser, utf8, utf8_length);
 }
 
-/* Invoke print_string_ptr (which is useful) on an item. */
-static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+static cJSON_bool is_number_character(const unsigned char character)
 {
-    return print_string_ptr((unsigned char*)item->valuestring, p);
+    return ((character >= '0') && (character <= '9')) || (character == '.') || (character == 'e') || (character == 'E') || (character == '+') || (character == '-');
 }
 
-/* Predeclare these prototypes. */
-static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
-
-/* Utility to jump whitespace and cr/lf */
-static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+static cJSON_bool sax_end_number(cJSON_SaxParser * const parser)
 {
-    if ((buffer == NULL) || (buffer->content == NULL))
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    cJSON item;
+
+    memset(&item, '\0', sizeof(item));
+    buffer.content = (const unsigned char*)parser->token;
+    buffer.length = parser->token_length;
+
+    /* like the tree parser after a number, anything but a delimiter is an error */
+    if (!parse_number(&item, &buffer) || (buffer.offset != buffer.length))
     {
-        return NULL;
+        return false;
     }
 
-    if (cannot_access_at_index(buffer, 0))
+    return sax_emit_value(parser, &item);
+}
+
+static cJSON_bool sax_end_literal(cJSON_SaxParser * const parser)
+{
+    cJSON item;
+
+    memset(&item, '\0', sizeof(item));
+    if (parser->literal[0] == 't')
     {
-        return buffer;
+        item.type = cJSON_True;
+        item.valueint = 1;
     }
-
-    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    else if (parser->literal[0] == 'f')
     {
-       buffer->offset++;
+        item.type = cJSON_False;
     }
-
-    if (buffer->offset == buffer->length)
+    else
     {
-        buffer->offset--;
+        item.type = cJSON_NULL;
     }
 
-    return buffer;
+    return sax_emit_value(parser, &item);
 }
 
-/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
-static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+CJSON_PUBLIC(void) cJSON_SaxInit(cJSON_SaxParser *parser, const cJSON_SaxCallbacks *callbacks, void *user_data, char *token_buffer, size_t token_buffer_size)
 {
-    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
-    {
-        return NULL;
-    }
-
-    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    if (parser == NULL)
     {
-        buffer->offset += 3;
+        return;
     }
 
-    return buffer;
+    memset(parser, '\0', sizeof(cJSON_SaxParser));
+    parser->callbacks = callbacks;
+    parser->user_data = user_data;
+    parser->token = token_buffer;
+    parser->token_size = token_buffer_size;
+    parser->state = sax_start;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+CJSON_PUBLIC(cJSON_bool) cJSON_SaxFeed(cJSON_SaxParser *parser, const char *chunk, size_t length)
 {
-    size_t buffer_length;
+    const unsigned char *pointer = (const unsigned char*)chunk;
+    const unsigned char *end = NULL;
+    const unsigned char *run_end = NULL;
+    cJSON_bool success = true;
 
-    if (NULL == value)
+    if ((parser == NULL) || (parser->callbacks == NULL) || (parser->token == NULL) || (parser->token_size == 0) || (parser->state == sax_error))
     {
-        return NULL;
+        return false;
+    }
+    if (length == 0)
+    {
+        return true;
+    }
+    if (chunk == NULL)
+    {
+        parser->state = sax_error;
+        return false;
     }
+    end = pointer + length;
 
-    /* Adding null character size due to require_null_terminated. */
-    buffer_length = strlen(value) + sizeof("");
+    while (success && (pointer < end))
+    {
+        switch ((sax_state)parser->state)
+        {
+            case sax_start:
+                if (*pointer == (unsigned char)"\xEF\xBB\xBF"[parser->counter])
+                {
+                    parser->counter++;
+                    pointer++;
+                    if (parser->counter == 3)
+                    {
+                        parser->state = sax_value;
+                    }
+                }
+                else if (parser->counter == 0)
+                {
+                    /* no BOM, look at the same byte again */
+                    parser->state = sax_value;
+                }
+                else
+                {
+                    success = false;
+                }
+                break;
+
+            case sax_value:
+            case sax_value_or_end:
+            case sax_key:
+            case sax_key_or_end:
+            case sax_colon:
+            case sax_after_value:
+                if (*pointer <= 32)
+                {
+                    pointer = scan_whitespace_bytes(pointer, end);
+                }
+                else if ((success = sax_structural(parser, *pointer)))
+                {
+                    pointer++;
+                }
+                break;
+
+            case sax_string:
+                /* copy everything up to the next quote, backslash or control character at once */
+                run_end = scan_string_bytes(pointer, end);
+                success = sax_append(parser, pointer, (size_t)(run_end - pointer));
+                if (success)
+                {
+                    pointer = run_end;
+                }
+                if (success && (pointer < end))
+                {
+                    if (*pointer == '\"')
+                    {
+                        success = sax_end_string(parser);
+                    }
+                    else if (*pointer == '\\')
+                    {
+                        parser->state = sax_escape;
+                    }
+                    else
+                    {
+                        /* control characters are copied as they are */
+                        success = sax_append(parser, pointer, 1);
+                    }
+                    if (success)
+                    {
+                        pointer++;
+                    }
+                }
+                break;
 
-    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
-}
+            case sax_escape:
+                if ((success = sax_escape_character(parser, *pointer)))
+                {
+                    pointer++;
+                }
+                break;
 
-/* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
-{
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
-    cJSON *item = NULL;
+            case sax_unicode:
+                if ((success = sax_unicode_digit(parser, *pointer)))
+                {
+                    pointer++;
+                }
+                break;
 
-    /* reset error position */
-    global_error.json = NULL;
-    global_error.position = 0;
+            case sax_surrogate_backslash:
+            case sax_surrogate_u:
+                success = (*pointer == ((parser->state == sax_surrogate_backslash) ? '\\' : 'u'));
+                if (success)
+                {
+                    pointer++;
+                    parser->counter = 0;
+                    parser->code_unit = 0;
+                    parser->state = (parser->state == sax_surrogate_backslash) ? sax_surrogate_u : sax_unicode;
+                }
+                break;
 
-    if (value == NULL || 0 == buffer_length)
-    {
-        goto fail;
-    }
+            case sax_number:
+                run_end = pointer;
+                while ((run_end < end) && is_number_character(*run_end))
+                {
+                    run_end++;
+                }
+                success = sax_append(parser, pointer, (size_t)(run_end - pointer));
+                if (success)
+                {
+                    pointer = run_end;
+                }
+                if (success && (pointer < end))
+                {
+                    /* the byte after the number is looked at again */
+                    success = sax_end_number(parser);
+                }
+                break;
 
-    buffer.content = (const unsigned char*)value;
-    buffer.length = buffer_length;
-    buffer.offset = 0;
-    buffer.hooks = global_hooks;
+            case sax_literal:
+                success = (*pointer == (unsigned char)parser->literal[parser->counter]);
+                if (success)
+                {
+                    pointer++;
+                    parser->counter++;
+                    if (parser->literal[parser->counter] == '\0')
+                    {
+                        success = sax_end_literal(parser);
+                    }
+                }
+                break;
 
-    item = cJSON_New_Item(&global_hooks);
-    if (item == NULL) /* memory fail */
-    {
-        goto fail;
+            case sax_error:
+            default:
+                success = false;
+                break;
+        }
     }
 
-    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    parser->offset += (size_t)(pointer - (const unsigned char*)chunk);
+    if (!success)
     {
-        /* parse failure. ep is set. */
-        goto fail;
+        parser->state = sax_error;
     }
 
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated)
-    {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
-        {
-            goto fail;
-        }
-    }
-    if (return_parse_end)
+    return success;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_SaxFinish(cJSON_SaxParser *parser)
+{
+    if ((parser == NULL) || (parser->callbacks == NULL))
     {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+        return false;
     }
 
-    return item;
-
-fail:
-    if (item != NULL)
+    /* a number at the end of the input has no delimiter after it */
+    if ((parser->state == sax_number) && !sax_end_number(parser))
     {
-        cJSON_Delete(item);
+        parser->state = sax_error;
     }
 
-    if (value != NULL)
+    if ((parser->state != sax_after_value) || (parser->depth != 0))
     {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
-
-        if (buffer.offset < buffer.length)
-        {
-            local_error.position = buffer.offset;
-        }
-        else if (buffer.length > 0)
-        {
-            local_error.position = buffer.length - 1;
-        }
-
-        if (return_parse_end != NULL)
-        {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
-        }
-
-        global_error = local_error;
+        parser->state = sax_error;
+        return false;
     }
 
-    return NULL;
+    return true;
 }
 
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+CJSON_PUBLIC(cJSON_bool) cJSON_SaxParse(const char *value, size_t buffer_length, const cJSON_SaxCallbacks *callbacks, void *user_data, char *token_buffer, size_t token_buffer_size)
 {
-    return cJSON_ParseWithOpts(value, 0, 0);
-}
+    cJSON_SaxParser parser;
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
-{
-    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+    cJSON_SaxInit(&parser, callbacks, user_data, token_buffer, token_buffer_size);
+
+    return cJSON_SaxFeed(&parser, value, buffer_length) && cJSON_SaxFinish(&parser);
 }
 
 #define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
@@ -1313,6 +3769,51 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
     return (char*)p.buffer;
 }
 
+CJSON_PUBLIC(size_t) cJSON_PrintedLength(const cJSON *item, cJSON_bool format)
+{
+    size_t length = 0;
+
+    if (!printed_length(item, 0, format, &length))
+    {
+        return 0;
+    }
+
+    return length;
+}
+
+CJSON_PUBLIC(char *) cJSON_PrintExact(const cJSON *item, cJSON_bool fmt)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    size_t length = 0;
+
+    if (!printed_length(item, 0, fmt, &length) || (length >= INT_MAX))
+    {
+        return NULL;
+    }
+
+    /* the size is known, so print into a single buffer that never grows */
+    p.buffer = (unsigned char*)global_hooks.allocate(length + sizeof(""));
+    if (!p.buffer)
+    {
+        return NULL;
+    }
+
+    p.length = length + sizeof("");
+    p.offset = 0;
+    p.noalloc = true;
+    p.format = fmt;
+    p.hooks = global_hooks;
+
+    if (!print_value(item, &p))
+    {
+        global_hooks.deallocate(p.buffer);
+        p.buffer = NULL;
+        return NULL;
+    }
+
+    return (char*)p.buffer;
+}
+
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format)
 {
     printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
@@ -1469,7 +3970,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
-        return false; /* to deeply nested */
+        return false; /* too deeply nested */
     }
     input_buffer->depth++;
 
@@ -1629,7 +4130,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
-        return false; /* to deeply nested */
+        return false; /* too deeply nested */
     }
     input_buffer->depth++;
 
@@ -1853,6 +4354,115 @@ static cJSON_bool print_object(const cJSON * const item, printbuffer * const out
     return true;
 }
 
+/* Length of a cstring once escaped and quoted by print_string_ptr. */
+static size_t printed_string_length(const unsigned char * const input)
+{
+    size_t input_length = 0;
+    size_t escape_characters = 0;
+
+    if (input == NULL)
+    {
+        return sizeof("\"\"") - sizeof("");
+    }
+
+    escape_characters = count_escape_characters(input, &input_length);
+
+    return input_length + escape_characters + sizeof("\"\"") - sizeof("");
+}
+
+/* Compute the length print_value would produce at the given depth, without the zero terminator. */
+static cJSON_bool printed_length(const cJSON * const item, size_t depth, const cJSON_bool format, size_t * const length)
+{
+    unsigned char number_buffer[26] = {0};
+    const cJSON *current_item = NULL;
+    int number_length = 0;
+
+    if (item == NULL)
+    {
+        return false;
+    }
+
+    switch ((item->type) & 0xFF)
+    {
+        case cJSON_NULL:
+        case cJSON_True:
+            *length += 4;
+            return true;
+
+        case cJSON_False:
+            *length += 5;
+            return true;
+
+        case cJSON_Number:
+            number_length = format_number(item, number_buffer);
+            if (number_length < 0)
+            {
+                return false;
+            }
+            *length += (size_t)number_length;
+            return true;
+
+        case cJSON_Raw:
+            if (item->valuestring == NULL)
+            {
+                return false;
+            }
+            *length += strlen(item->valuestring);
+            return true;
+
+        case cJSON_String:
+            *length += printed_string_length((unsigned char*)item->valuestring);
+            return true;
+
+        case cJSON_Array:
+            /* brackets and separators */
+            *length += 2;
+            for (current_item = item->child; current_item != NULL; current_item = current_item->next)
+            {
+                if (!printed_length(current_item, depth + 1, format, length))
+                {
+                    return false;
+                }
+                if (current_item->next)
+                {
+                    *length += (size_t)(format ? 2 : 1);
+                }
+            }
+            return true;
+
+        case cJSON_Object:
+            /* braces, formatted output adds a newline after '{' and indents the '}' */
+            *length += format ? (depth + 3) : 2;
+            for (current_item = item->child; current_item != NULL; current_item = current_item->next)
+            {
+                if (format)
+                {
+                    /* indentation, ":\t" and newline */
+                    *length += (depth + 1) + 3;
+                }
+                else
+                {
+                    /* ':' */
+                    *length += 1;
+                }
+                *length += printed_string_length((unsigned char*)current_item->string);
+
+                if (!printed_length(current_item, depth + 1, format, length))
+                {
+                    return false;
+                }
+                if (current_item->next)
+                {
+                    *length += 1;
+                }
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 /* Get Array size/item / object item. */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 {
@@ -1864,12 +4474,25 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
         return 0;
     }
 
+#ifdef CJSON_ARRAY_INDEX
+    if (array_index_get(array) != NULL)
+    {
+        return (int)array->index->count;
+    }
+#endif
+
     child = array->child;
 
     while(child != NULL)
     {
         size++;
         child = child->next;
+#ifdef CJSON_ARRAY_INDEX
+        if ((size == CJSON_ARRAY_INDEX_THRESHOLD) && (array_index_create(array) != NULL))
+        {
+            return (int)array->index->count;
+        }
+#endif
     }
 
     /* FIXME: Can overflow here. Cannot be fixed without breaking the API */
@@ -1880,17 +4503,31 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 static cJSON* get_array_item(const cJSON *array, size_t index)
 {
     cJSON *current_child = NULL;
+    size_t position = 0;
 
     if (array == NULL)
     {
         return NULL;
     }
 
+#ifdef CJSON_ARRAY_INDEX
+    if (array_index_get(array) != NULL)
+    {
+        return (index < array->index->count) ? array->index->items[index] : NULL;
+    }
+#endif
+
     current_child = array->child;
-    while ((current_child != NULL) && (index > 0))
+    while ((current_child != NULL) && (position < index))
     {
-        index--;
+        position++;
         current_child = current_child->next;
+#ifdef CJSON_ARRAY_INDEX
+        if ((position == CJSON_ARRAY_INDEX_THRESHOLD) && (array_index_create(array) != NULL))
+        {
+            return (index < array->index->count) ? array->index->items[index] : NULL;
+        }
+#endif
     }
 
     return current_child;
@@ -1909,33 +4546,62 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = NULL;
+#ifdef CJSON_OBJECT_INDEX
+    cJSON *mutable_object = (cJSON*)cast_away_const(object);
+    size_t position = 0;
+    /* references share their members with another object that may change them, don't index those */
+    cJSON_bool indexable = false;
+#endif
 
     if ((object == NULL) || (name == NULL))
     {
         return NULL;
     }
 
-    current_element = object->child;
-    if (case_sensitive)
+#ifdef CJSON_OBJECT_INDEX
+    indexable = cJSON_IsObject(object) && !(object->type & cJSON_IsReference);
+    if (indexable && (object->index != NULL))
     {
-        while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
+        if (index_is_current(object))
         {
-            current_element = current_element->next;
+            return object_index_lookup(object->index, name, case_sensitive);
         }
+        index_free(mutable_object);
     }
-    else
+#endif
+
+    for (current_element = object->child; current_element != NULL; current_element = current_element->next)
     {
-        while ((current_element != NULL) && (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) != 0))
+        if (case_sensitive)
+        {
+            if (current_element->string == NULL)
+            {
+                return NULL;
+            }
+            if (strcmp(name, current_element->string) == 0)
+            {
+                return current_element;
+            }
+        }
+        else if (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) == 0)
         {
-            current_element = current_element->next;
+            return current_element;
         }
-    }
 
-    if ((current_element == NULL) || (current_element->string == NULL)) {
-        return NULL;
+#ifdef CJSON_OBJECT_INDEX
+        /* the index is only built once a lookup walked past the threshold, so small objects are never counted */
+        if (indexable && (++position == CJSON_OBJECT_INDEX_THRESHOLD))
+        {
+            mutable_object->index = object_index_build(object);
+            if (object->index != NULL)
+            {
+                return object_index_lookup(object->index, name, case_sensitive);
+            }
+        }
+#endif
     }
 
-    return current_element;
+    return NULL;
 }
 
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string)
@@ -1979,6 +4645,10 @@ static cJSON *create_reference(const cJSON *item, const internal_hooks * const h
     reference->string = NULL;
     reference->type |= cJSON_IsReference;
     reference->next = reference->prev = NULL;
+#ifdef CJSON_INDEX
+    /* the index belongs to the referenced item, deleting the reference must not free it */
+    reference->index = NULL;
+#endif
     return reference;
 }
 
@@ -2012,6 +4682,15 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
         }
     }
 
+    if (cJSON_IsArray(array))
+    {
+        array_index_append(array, item);
+    }
+    else
+    {
+        object_index_append(array, item);
+    }
+
     return true;
 }
 
@@ -2220,6 +4899,15 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
         return NULL;
     }
 
+    if (cJSON_IsArray(parent))
+    {
+        array_index_remove(parent, item);
+    }
+    else
+    {
+        index_free(parent);
+    }
+
     if (item != parent->child)
     {
         /* not the first element */
@@ -2320,6 +5008,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
     {
         newitem->prev->next = newitem;
     }
+    index_free(array);
     return true;
 }
 
@@ -2368,6 +5057,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
     item->next = NULL;
     item->prev = NULL;
     cJSON_Delete(item);
+    index_free(parent);
 
     return true;
 }
@@ -99,6 +99,11 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
 
+/* Both lookup indexes live in the same field of the cJSON structure. */
+#if defined(CJSON_OBJECT_INDEX) || defined(CJSON_ARRAY_INDEX)
+#define CJSON_INDEX
+#endif
+
 /* The cJSON structure: */
 typedef struct cJSON
 {
@@ -120,6 +125,11 @@ typedef struct cJSON
 
     /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
     char *string;
+
+#ifdef CJSON_INDEX
+    /* Index of the children of a large object or array, built lazily on lookup and owned by cJSON. */
+    struct cJSON_Index *index;
+#endif
 } cJSON;
 
 typedef struct cJSON_Hooks
@@ -143,6 +153,53 @@ typedef int cJSON_bool;
 #define CJSON_CIRCULAR_LIMIT 10000
 #endif
 
+/* Objects with at least this many members get a hash index for lookups when cJSON is built with CJSON_OBJECT_INDEX.
+ * Every translation unit using cJSON has to be compiled with the same CJSON_OBJECT_INDEX setting. */
+#ifndef CJSON_OBJECT_INDEX_THRESHOLD
+#define CJSON_OBJECT_INDEX_THRESHOLD 16
+#endif
+
+/* Arrays with at least this many items get an index for constant time access and size when cJSON is built with CJSON_ARRAY_INDEX.
+ * Like CJSON_OBJECT_INDEX, the CJSON_ARRAY_INDEX setting has to be the same in every translation unit using cJSON. */
+#ifndef CJSON_ARRAY_INDEX_THRESHOLD
+#define CJSON_ARRAY_INDEX_THRESHOLD 16
+#endif
+
+/* Callbacks of the streaming parser, any of them can be NULL. Returning false from one stops parsing with an error. */
+typedef struct cJSON_SaxCallbacks
+{
+      cJSON_bool (CJSON_CDECL *begin_object)(void *user_data);
+      cJSON_bool (CJSON_CDECL *end_object)(void *user_data);
+      cJSON_bool (CJSON_CDECL *begin_array)(void *user_data);
+      cJSON_bool (CJSON_CDECL *end_array)(void *user_data);
+      /* the key of the next value in an object, zero terminated and only valid during the call */
+      cJSON_bool (CJSON_CDECL *key)(void *user_data, const char *key, size_t length);
+      /* a string, number, true, false or null; item->valuestring is only valid during the call */
+      cJSON_bool (CJSON_CDECL *value)(void *user_data, const cJSON *item);
+} cJSON_SaxCallbacks;
+
+/* State of the streaming parser. The members are private, it is only declared here so it can live on the stack or in static memory. */
+typedef struct cJSON_SaxParser
+{
+    const cJSON_SaxCallbacks *callbacks;
+    void *user_data;
+    /* strings, keys and numbers are collected here, so they can span chunks */
+    char *token;
+    size_t token_size;
+    size_t token_length;
+    /* number of bytes consumed, the position of the error after a failure */
+    size_t offset;
+    size_t depth;
+    /* one bit per nesting level, set for objects and clear for arrays */
+    unsigned char in_object[(CJSON_NESTING_LIMIT + 7) / 8];
+    int state;
+    cJSON_bool in_key;
+    const char *literal;
+    unsigned int counter;
+    unsigned int code_unit;
+    unsigned int high_surrogate;
+} cJSON_SaxParser;
+
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cJSON_Version(void);
 
@@ -158,14 +215,28 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/* Streaming parser: calls the callbacks for every value while the JSON is fed in chunks of any size, nothing is allocated.
+ * token_buffer has to hold the longest string, key or number of the document plus its zero terminator (UTF-8 decoded).
+ * Feed returns 0 on an error, and parser->offset is then the position of the error in the whole input.
+ * Finish returns 1 if exactly one complete value (and only whitespace after it) was fed. */
+CJSON_PUBLIC(void) cJSON_SaxInit(cJSON_SaxParser *parser, const cJSON_SaxCallbacks *callbacks, void *user_data, char *token_buffer, size_t token_buffer_size);
+CJSON_PUBLIC(cJSON_bool) cJSON_SaxFeed(cJSON_SaxParser *parser, const char *chunk, size_t length);
+CJSON_PUBLIC(cJSON_bool) cJSON_SaxFinish(cJSON_SaxParser *parser);
+/* Init, Feed and Finish for JSON that is all in memory. */
+CJSON_PUBLIC(cJSON_bool) cJSON_SaxParse(const char *value, size_t buffer_length, const cJSON_SaxCallbacks *callbacks, void *user_data, char *token_buffer, size_t token_buffer_size);
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
 CJSON_PUBLIC(char *) cJSON_PrintUnformatted(const cJSON *item);
 /* Render a cJSON entity to text using a buffered strategy. prebuffer is a guess at the final size. guessing well reduces reallocation. fmt=0 gives unformatted, =1 gives formatted */
 CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON_bool fmt);
+/* Compute the exact length of the text cJSON_Print (format=1) or cJSON_PrintUnformatted (format=0) would produce, not counting the zero terminator. Nothing is allocated. Returns 0 on failure. */
+CJSON_PUBLIC(size_t) cJSON_PrintedLength(const cJSON *item, cJSON_bool format);
+/* Render a cJSON entity to text with a single allocation of exactly cJSON_PrintedLength() + 1 bytes. fmt=0 gives unformatted, =1 gives formatted */
+CJSON_PUBLIC(char *) cJSON_PrintExact(const cJSON *item, cJSON_bool fmt);
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
-/* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
+/* NOTE: a buffer of cJSON_PrintedLength() + 1 bytes is always large enough */
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
@@ -178,6 +249,9 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItem(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON *) cJSON_GetObjectItemCaseSensitive(const cJSON * const object, const char * const string);
 CJSON_PUBLIC(cJSON_bool) cJSON_HasObjectItem(const cJSON *object, const char *string);
+/* Drop the lookup index of an object or array after its list of children was modified directly instead of through the cJSON functions.
+ * Does nothing unless cJSON is built with CJSON_OBJECT_INDEX or CJSON_ARRAY_INDEX. */
+CJSON_PUBLIC(void) cJSON_InvalidateIndex(cJSON *item);
 /* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
 CJSON_PUBLIC(const char *) cJSON_GetErrorPtr(void);
 
@@ -422,6 +422,7 @@ static cJSON *detach_item_from_array(cJSON *array, size_t which)
     }
     /* make sure the detached item doesn't point anywhere anymore */
     c->prev = c->next = NULL;
+    cJSON_InvalidateIndex(array);
 
     return c;
 }
@@ -599,6 +600,7 @@ static void sort_object(cJSON * const object, const cJSON_bool case_sensitive)
         return;
     }
     object->child = sort_list(object->child, case_sensitive);
+    cJSON_InvalidateIndex(object);
 }
 
 static cJSON_bool compare_json(cJSON *a, cJSON *b, const cJSON_bool case_sensitive)
@@ -723,6 +725,7 @@ static cJSON_bool insert_item_in_array(cJSON *array, size_t which, cJSON *newite
     {
         newitem->prev->next = newitem;
     }
+    cJSON_InvalidateIndex(array);
 
     return 1;
 }
@@ -800,6 +803,7 @@ static void overwrite_item(cJSON * const root, const cJSON replacement)
     {
         cJSON_Delete(root->child);
     }
+    cJSON_InvalidateIndex(root);
 
     memcpy(root, &replacement, sizeof(cJSON));
 }
@@ -840,7 +844,11 @@ static int apply_patch(cJSON *object, const cJSON *patch, const cJSON_bool case_
     {
         if (opcode == REMOVE)
         {
-            static const cJSON invalid = { NULL, NULL, NULL, cJSON_Invalid, NULL, 0, 0, NULL};
+            static const cJSON invalid = { NULL, NULL, NULL, cJSON_Invalid, NULL, 0, 0, NULL
+#ifdef CJSON_INDEX
+                , NULL
+#endif
+            };
 
             overwrite_item(object, invalid);
 
@@ -0,0 +1,361 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static cJSON *create_array_of_numbers(int count)
+{
+    cJSON *array = cJSON_CreateArray();
+    int i = 0;
+
+    TEST_ASSERT_NOT_NULL(array);
+    for (i = 0; i < count; i++)
+    {
+        TEST_ASSERT_TRUE(cJSON_AddItemToArray(array, cJSON_CreateNumber(i)));
+    }
+
+    return array;
+}
+
+/* checks size, indexed access and the linked list against the expected values */
+static void assert_array_equals(const cJSON *array, const int *expected, int count)
+{
+    cJSON *item = NULL;
+    int i = 0;
+
+    TEST_ASSERT_EQUAL_INT(count, cJSON_GetArraySize(array));
+    for (i = 0; i < count; i++)
+    {
+        item = cJSON_GetArrayItem(array, i);
+        TEST_ASSERT_NOT_NULL(item);
+        TEST_ASSERT_EQUAL_INT(expected[i], item->valueint);
+    }
+    TEST_ASSERT_NULL(cJSON_GetArrayItem(array, count));
+    TEST_ASSERT_NULL(cJSON_GetArrayItem(array, -1));
+
+    i = 0;
+    cJSON_ArrayForEach(item, array)
+    {
+        TEST_ASSERT_EQUAL_INT(expected[i], item->valueint);
+        i++;
+    }
+    TEST_ASSERT_EQUAL_INT(count, i);
+    if (count > 0)
+    {
+        TEST_ASSERT_EQUAL_INT(expected[count - 1], array->child->prev->valueint);
+    }
+}
+
+static void array_access_should_find_all_items(void)
+{
+    int counts[] = { 0, 1, CJSON_ARRAY_INDEX_THRESHOLD - 1, CJSON_ARRAY_INDEX_THRESHOLD, 1000 };
+    int expected[1000];
+    size_t i = 0;
+    int j = 0;
+
+    for (j = 0; j < 1000; j++)
+    {
+        expected[j] = j;
+    }
+
+    for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        cJSON *array = create_array_of_numbers(counts[i]);
+
+        assert_array_equals(array, expected, counts[i]);
+
+#ifdef CJSON_ARRAY_INDEX
+        if (counts[i] >= CJSON_ARRAY_INDEX_THRESHOLD)
+        {
+            TEST_ASSERT_NOT_NULL(array->index);
+        }
+        else
+        {
+            TEST_ASSERT_NULL(array->index);
+        }
+#endif
+
+        cJSON_Delete(array);
+    }
+}
+
+static void array_access_should_follow_appends(void)
+{
+    cJSON *array = create_array_of_numbers(100);
+    int expected[300];
+    int i = 0;
+
+    for (i = 0; i < 300; i++)
+    {
+        expected[i] = i;
+    }
+    assert_array_equals(array, expected, 100);
+
+    /* appending past the capacity of the vector has to grow it */
+    for (i = 100; i < 300; i++)
+    {
+        TEST_ASSERT_TRUE(cJSON_AddItemToArray(array, cJSON_CreateNumber(i)));
+        TEST_ASSERT_EQUAL_INT(i + 1, cJSON_GetArraySize(array));
+        TEST_ASSERT_EQUAL_INT(i, cJSON_GetArrayItem(array, i)->valueint);
+    }
+    assert_array_equals(array, expected, 300);
+
+    cJSON_Delete(array);
+}
+
+static void array_access_should_follow_detaches(void)
+{
+    cJSON *array = create_array_of_numbers(100);
+    cJSON *item = NULL;
+    int expected[100];
+    int count = 0;
+    int i = 0;
+
+    for (i = 0; i < 100; i++)
+    {
+        expected[i] = i;
+    }
+    count = 100;
+    assert_array_equals(array, expected, count);
+
+    /* last, first and middle */
+    cJSON_DeleteItemFromArray(array, 99);
+    count--;
+    assert_array_equals(array, expected, count);
+
+    cJSON_DeleteItemFromArray(array, 0);
+    memmove(&expected[0], &expected[1], (size_t)(count - 1) * sizeof(int));
+    count--;
+    assert_array_equals(array, expected, count);
+
+    item = cJSON_DetachItemFromArray(array, 40);
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_EQUAL_INT(41, item->valueint);
+    TEST_ASSERT_NULL(item->next);
+    TEST_ASSERT_NULL(item->prev);
+    cJSON_Delete(item);
+    memmove(&expected[40], &expected[41], (size_t)(count - 41) * sizeof(int));
+    count--;
+    assert_array_equals(array, expected, count);
+
+    /* via pointer */
+    item = cJSON_GetArrayItem(array, 10);
+    TEST_ASSERT_EQUAL_PTR(item, cJSON_DetachItemViaPointer(array, item));
+    cJSON_Delete(item);
+    memmove(&expected[10], &expected[11], (size_t)(count - 11) * sizeof(int));
+    count--;
+    assert_array_equals(array, expected, count);
+
+    /* out of range */
+    TEST_ASSERT_NULL(cJSON_DetachItemFromArray(array, count));
+    assert_array_equals(array, expected, count);
+
+    /* shrink to nothing and grow again */
+    while (count > 0)
+    {
+        cJSON_DeleteItemFromArray(array, 0);
+        memmove(&expected[0], &expected[1], (size_t)(count - 1) * sizeof(int));
+        count--;
+        assert_array_equals(array, expected, count);
+    }
+    TEST_ASSERT_NULL(array->child);
+    for (i = 0; i < 50; i++)
+    {
+        expected[i] = i;
+        cJSON_AddItemToArray(array, cJSON_CreateNumber(i));
+    }
+    assert_array_equals(array, expected, 50);
+
+    cJSON_Delete(array);
+}
+
+static void array_access_should_follow_inserts_and_replaces(void)
+{
+    cJSON *array = create_array_of_numbers(50);
+    cJSON *item = NULL;
+    int expected[51];
+    int i = 0;
+
+    for (i = 0; i < 50; i++)
+    {
+        expected[i + 1] = i;
+    }
+    assert_array_equals(array, &expected[1], 50);
+
+    TEST_ASSERT_TRUE(cJSON_InsertItemInArray(array, 0, cJSON_CreateNumber(-1)));
+    expected[0] = -1;
+    assert_array_equals(array, expected, 51);
+
+    TEST_ASSERT_TRUE(cJSON_InsertItemInArray(array, 20, cJSON_CreateNumber(-2)));
+    TEST_ASSERT_EQUAL_INT(52, cJSON_GetArraySize(array));
+    TEST_ASSERT_EQUAL_INT(-1, cJSON_GetArrayItem(array, 0)->valueint);
+    TEST_ASSERT_EQUAL_INT(-2, cJSON_GetArrayItem(array, 20)->valueint);
+    TEST_ASSERT_EQUAL_INT(19, cJSON_GetArrayItem(array, 21)->valueint);
+    TEST_ASSERT_EQUAL_INT(49, cJSON_GetArrayItem(array, 51)->valueint);
+
+    TEST_ASSERT_TRUE(cJSON_ReplaceItemInArray(array, 51, cJSON_CreateNumber(-3)));
+    TEST_ASSERT_EQUAL_INT(-3, cJSON_GetArrayItem(array, 51)->valueint);
+    TEST_ASSERT_EQUAL_INT(-3, array->child->prev->valueint);
+    TEST_ASSERT_TRUE(cJSON_ReplaceItemInArray(array, 0, cJSON_CreateNumber(-4)));
+    TEST_ASSERT_EQUAL_INT(-4, cJSON_GetArrayItem(array, 0)->valueint);
+    TEST_ASSERT_EQUAL_INT(52, cJSON_GetArraySize(array));
+
+    /* unlink the last item by hand, then tell cJSON about it */
+    item = array->child->prev;
+    item->prev->next = NULL;
+    array->child->prev = item->prev;
+    item->prev = NULL;
+    cJSON_InvalidateIndex(array);
+    cJSON_Delete(item);
+    TEST_ASSERT_EQUAL_INT(51, cJSON_GetArraySize(array));
+    TEST_ASSERT_NULL(cJSON_GetArrayItem(array, 51));
+
+    cJSON_Delete(array);
+}
+
+static void array_access_should_work_on_parsed_duplicated_and_referenced_arrays(void)
+{
+    cJSON *array = create_array_of_numbers(300);
+    cJSON *parsed = NULL;
+    cJSON *duplicate = NULL;
+    cJSON *reference = NULL;
+    char *printed = NULL;
+    int expected[300];
+    int i = 0;
+
+    for (i = 0; i < 300; i++)
+    {
+        expected[i] = i;
+    }
+    /* make sure the source has an index that must not be shared */
+    assert_array_equals(array, expected, 300);
+
+    printed = cJSON_PrintUnformatted(array);
+    TEST_ASSERT_NOT_NULL(printed);
+    parsed = cJSON_Parse(printed);
+    TEST_ASSERT_NOT_NULL(parsed);
+    assert_array_equals(parsed, expected, 300);
+
+    reference = cJSON_CreateArrayReference(array->child);
+    TEST_ASSERT_NOT_NULL(reference);
+    TEST_ASSERT_EQUAL_INT(300, cJSON_GetArraySize(reference));
+    TEST_ASSERT_EQUAL_INT(299, cJSON_GetArrayItem(reference, 299)->valueint);
+#ifdef CJSON_ARRAY_INDEX
+    TEST_ASSERT_NULL(reference->index);
+#endif
+    cJSON_Delete(reference);
+
+    duplicate = cJSON_Duplicate(array, true);
+    TEST_ASSERT_NOT_NULL(duplicate);
+    cJSON_Delete(array);
+    assert_array_equals(duplicate, expected, 300);
+
+    cJSON_free(printed);
+    cJSON_Delete(parsed);
+    cJSON_Delete(duplicate);
+}
+
+static void array_access_should_survive_deleting_a_reference(void)
+{
+    cJSON *array = create_array_of_numbers(50);
+    cJSON *holder = cJSON_CreateObject();
+    cJSON *reference = NULL;
+    int expected[50];
+    int i = 0;
+
+    TEST_ASSERT_NOT_NULL(holder);
+    for (i = 0; i < 50; i++)
+    {
+        expected[i] = i;
+    }
+    /* build the vector before the reference copies the array */
+    TEST_ASSERT_EQUAL_INT(49, cJSON_GetArrayItem(array, 49)->valueint);
+#ifdef CJSON_ARRAY_INDEX
+    TEST_ASSERT_NOT_NULL(array->index);
+#endif
+
+    TEST_ASSERT_TRUE(cJSON_AddItemReferenceToObject(holder, "items", array));
+    reference = cJSON_GetObjectItem(holder, "items");
+    assert_array_equals(reference, expected, 50);
+#ifdef CJSON_ARRAY_INDEX
+    TEST_ASSERT_NULL(reference->index);
+#endif
+    cJSON_Delete(holder);
+
+    assert_array_equals(array, expected, 50);
+    cJSON_Delete(array);
+}
+
+/* Walk arrays of growing size with the GetArraySize/GetArrayItem loop and report the cost per item. */
+static void array_access_benchmark(void)
+{
+    int counts[] = { 8, 64, 512, 4096 };
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        cJSON *array = create_array_of_numbers(counts[i]);
+        int rounds = (16384 / counts[i]) + 1;
+        int round = 0;
+        int item = 0;
+        long sum = 0;
+        clock_t start = 0;
+        double elapsed = 0.0;
+
+        start = clock();
+        for (round = 0; round < rounds; round++)
+        {
+            for (item = 0; item < cJSON_GetArraySize(array); item++)
+            {
+                sum += cJSON_GetArrayItem(array, item)->valueint;
+            }
+        }
+        elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        TEST_ASSERT_EQUAL_INT((long)rounds * (((long)counts[i] * (counts[i] - 1)) / 2), sum);
+        printf("%5d items: %8.1f ns per item\n", counts[i], (elapsed * 1e9) / ((double)rounds * counts[i]));
+
+        cJSON_Delete(array);
+    }
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(array_access_should_find_all_items);
+    RUN_TEST(array_access_should_follow_appends);
+    RUN_TEST(array_access_should_follow_detaches);
+    RUN_TEST(array_access_should_follow_inserts_and_replaces);
+    RUN_TEST(array_access_should_work_on_parsed_duplicated_and_referenced_arrays);
+    RUN_TEST(array_access_should_survive_deleting_a_reference);
+    RUN_TEST(array_access_benchmark);
+
+    return UNITY_END();
+}
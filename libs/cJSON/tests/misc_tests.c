@@ -238,7 +238,11 @@ static void cjson_should_not_follow_too_deep_circular_references(void)
 
 static void cjson_set_number_value_should_set_numbers(void)
 {
-    cJSON number[1] = {{NULL, NULL, NULL, cJSON_Number, NULL, 0, 0, NULL}};
+    cJSON number[1] = {{NULL, NULL, NULL, cJSON_Number, NULL, 0, 0, NULL
+#ifdef CJSON_INDEX
+        , NULL
+#endif
+    }};
 
     cJSON_SetNumberValue(number, 1.5);
     TEST_ASSERT_EQUAL(1, number->valueint);
@@ -263,6 +267,7 @@ static void cjson_detach_item_via_pointer_should_detach_items(void)
     cJSON parent[1];
 
     memset(list, '\0', sizeof(list));
+    memset(parent, '\0', sizeof(parent));
 
     /* link the list */
     list[0].next = &(list[1]);
@@ -303,6 +308,7 @@ static void cjson_detach_item_via_pointer_should_return_null_if_item_prev_is_nul
     cJSON parent[1];
 
     memset(list, '\0', sizeof(list));
+    memset(parent, '\0', sizeof(parent));
 
     /* link the list */
     list[0].next = &(list[1]);
@@ -360,7 +366,11 @@ static void cjson_replace_item_via_pointer_should_replace_items(void)
 
 static void cjson_replace_item_in_object_should_preserve_name(void)
 {
-    cJSON root[1] = {{NULL, NULL, NULL, 0, NULL, 0, 0, NULL}};
+    cJSON root[1] = {{NULL, NULL, NULL, 0, NULL, 0, 0, NULL
+#ifdef CJSON_INDEX
+        , NULL
+#endif
+    }};
     cJSON *child = NULL;
     cJSON *replacement = NULL;
     cJSON_bool flag = false;
@@ -0,0 +1,247 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+#define ROUNDS 200000
+
+static unsigned long random_state = 2463534242UL;
+
+/* xorshift32, so the test runs the same everywhere */
+static unsigned long random_next(void)
+{
+    random_state ^= (random_state << 13) & 0xFFFFFFFFUL;
+    random_state ^= random_state >> 17;
+    random_state ^= (random_state << 5) & 0xFFFFFFFFUL;
+    return random_state;
+}
+
+static int random_below(int limit)
+{
+    return (int)(random_next() % (unsigned long)limit);
+}
+
+static void append_digits(char *buffer, size_t *length, int count)
+{
+    while (count-- > 0)
+    {
+        buffer[(*length)++] = (char)('0' + random_below(10));
+    }
+}
+
+/* Random number literals: mostly well formed, some with many digits or extreme exponents, some truncated. */
+static void random_number_literal(char *buffer)
+{
+    size_t length = 0;
+    int shape = random_below(8);
+
+    if (random_below(2))
+    {
+        buffer[length++] = '-';
+    }
+
+    if (shape == 0)
+    {
+        /* any mix of the characters a number consists of */
+        const char characters[] = "0123456789.eE+-";
+        int count = 1 + random_below(20);
+        buffer[length++] = (char)('0' + random_below(10));
+        while (count-- > 0)
+        {
+            buffer[length++] = characters[random_below((int)sizeof(characters) - 1)];
+        }
+    }
+    else
+    {
+        append_digits(buffer, &length, (shape == 1) ? 1 + random_below(30) : 1 + random_below(10));
+        if (random_below(3))
+        {
+            buffer[length++] = '.';
+            append_digits(buffer, &length, (shape == 2) ? random_below(30) : random_below(12));
+        }
+        if (random_below(2))
+        {
+            buffer[length++] = random_below(2) ? 'e' : 'E';
+            if (random_below(2))
+            {
+                buffer[length++] = random_below(2) ? '-' : '+';
+            }
+            if (shape == 3)
+            {
+                /* around the limits of double and beyond */
+                length += (size_t)sprintf(buffer + length, "%d", 290 + random_below(50));
+            }
+            else
+            {
+                append_digits(buffer, &length, random_below(3));
+            }
+        }
+    }
+    buffer[length] = '\0';
+}
+
+/* Random doubles over the whole range: random bits, short decimals, subnormals, powers of two and ten. */
+static double random_double(void)
+{
+    double mantissa = ((double)(random_next() >> 11) * 4294967296.0) + (double)random_next();
+    char literal[32];
+
+    switch (random_below(6))
+    {
+        case 0:
+            return ldexp(mantissa, random_below(2098) - 1126);
+        case 1:
+            return ldexp(mantissa, random_below(60) - 1126);
+        case 2:
+            return ldexp(1.0, random_below(2098) - 1074);
+        case 3:
+            sprintf(literal, "1e%d", random_below(630) - 320);
+            return strtod(literal, NULL);
+        case 4:
+            sprintf(literal, "%lu.%lue%d", random_next() % 100000UL, random_next() % 1000UL, random_below(40) - 20);
+            return strtod(literal, NULL);
+        default:
+            return ldexp(mantissa, random_below(100) - 75);
+    }
+}
+
+/* The digits of a printed number without leading and trailing zeros, the exponent doesn't matter here. */
+static size_t significant_digits(const char *printed, char *digits)
+{
+    size_t count = 0;
+
+    for (; (*printed != '\0') && (*printed != 'e'); printed++)
+    {
+        if ((*printed >= '0') && (*printed <= '9') && ((count > 0) || (*printed != '0')))
+        {
+            digits[count++] = *printed;
+        }
+    }
+    while ((count > 0) && (digits[count - 1] == '0'))
+    {
+        count--;
+    }
+
+    return count;
+}
+
+static void number_parsing_should_match_strtod(void)
+{
+    char literal[128];
+    char message[192];
+    int round = 0;
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        const char *parse_end = NULL;
+        char *strtod_end = NULL;
+        double expected = 0.0;
+        cJSON *parsed = NULL;
+
+        random_number_literal(literal);
+        expected = strtod(literal, &strtod_end);
+        sprintf(message, "Parsing %s", literal);
+
+        parsed = cJSON_ParseWithOpts(literal, &parse_end, false);
+        TEST_ASSERT_NOT_NULL_MESSAGE(parsed, message);
+        TEST_ASSERT_TRUE_MESSAGE(cJSON_IsNumber(parsed), message);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(0, memcmp(&expected, &parsed->valuedouble, sizeof(double)), message);
+        TEST_ASSERT_EQUAL_PTR_MESSAGE(strtod_end, parse_end, message);
+        cJSON_Delete(parsed);
+    }
+}
+
+static void number_printing_should_be_shortest_round_trip(void)
+{
+    char message[192];
+    char reference[32];
+    int round = 0;
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        double number = random_double();
+        cJSON *item = NULL;
+        char *printed = NULL;
+        char digits[32];
+        char reference_digits[32];
+        size_t digit_count = 0;
+        size_t reference_count = 0;
+        int precision = 0;
+
+        if ((number == 0.0) || isinf(number))
+        {
+            continue;
+        }
+        if (random_below(2))
+        {
+            number = -number;
+        }
+
+        item = cJSON_CreateNumber(number);
+        TEST_ASSERT_NOT_NULL(item);
+        printed = cJSON_PrintUnformatted(item);
+        TEST_ASSERT_NOT_NULL(printed);
+        sprintf(message, "Printing %.17g gave %s", number, printed);
+
+        TEST_ASSERT_TRUE_MESSAGE(strtod(printed, NULL) == number, message);
+
+        digit_count = significant_digits(printed, digits);
+
+        /* the fewest digits that sprintf can round trip with */
+        for (precision = 1; precision <= 17; precision++)
+        {
+            sprintf(reference, "%.*e", precision - 1, number);
+            if (strtod(reference, NULL) == number)
+            {
+                break;
+            }
+        }
+        reference_count = significant_digits(reference, reference_digits);
+
+        TEST_ASSERT_TRUE_MESSAGE(digit_count <= reference_count, message);
+        if (digit_count == reference_count)
+        {
+            TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(reference_digits, digits, digit_count, message);
+        }
+
+        free(printed);
+        cJSON_Delete(item);
+    }
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(number_parsing_should_match_strtod);
+    RUN_TEST(number_printing_should_be_shortest_round_trip);
+
+    return UNITY_END();
+}
@@ -0,0 +1,259 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+static cJSON *create_object_with_keys(int count)
+{
+    cJSON *object = cJSON_CreateObject();
+    char name[32];
+    int i = 0;
+
+    TEST_ASSERT_NOT_NULL(object);
+    for (i = 0; i < count; i++)
+    {
+        sprintf(name, "key_%d", i);
+        TEST_ASSERT_NOT_NULL(cJSON_AddNumberToObject(object, name, i));
+    }
+
+    return object;
+}
+
+static void assert_all_keys_found(const cJSON *object, int count)
+{
+    char name[32];
+    cJSON *item = NULL;
+    int i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        sprintf(name, "key_%d", i);
+        item = cJSON_GetObjectItemCaseSensitive(object, name);
+        TEST_ASSERT_NOT_NULL_MESSAGE(item, name);
+        TEST_ASSERT_EQUAL_INT(i, item->valueint);
+
+        sprintf(name, "KEY_%d", i);
+        TEST_ASSERT_NULL(cJSON_GetObjectItemCaseSensitive(object, name));
+        item = cJSON_GetObjectItem(object, name);
+        TEST_ASSERT_NOT_NULL_MESSAGE(item, name);
+        TEST_ASSERT_EQUAL_INT(i, item->valueint);
+    }
+}
+
+static void object_lookup_should_find_all_members(void)
+{
+    int counts[] = { 1, CJSON_OBJECT_INDEX_THRESHOLD - 1, CJSON_OBJECT_INDEX_THRESHOLD, 500 };
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        cJSON *object = create_object_with_keys(counts[i]);
+
+        assert_all_keys_found(object, counts[i]);
+        TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "missing"));
+        TEST_ASSERT_NULL(cJSON_GetObjectItem(object, ""));
+        TEST_ASSERT_FALSE(cJSON_HasObjectItem(object, "key_"));
+
+#ifdef CJSON_OBJECT_INDEX
+        if (counts[i] >= CJSON_OBJECT_INDEX_THRESHOLD)
+        {
+            TEST_ASSERT_NOT_NULL(object->index);
+        }
+        else
+        {
+            TEST_ASSERT_NULL(object->index);
+        }
+#endif
+
+        cJSON_Delete(object);
+    }
+}
+
+static void object_lookup_should_return_first_duplicate(void)
+{
+    cJSON *object = create_object_with_keys(100);
+
+    cJSON_AddStringToObject(object, "Name", "first");
+    cJSON_AddStringToObject(object, "name", "second");
+    cJSON_AddStringToObject(object, "Name", "third");
+
+    TEST_ASSERT_EQUAL_STRING("first", cJSON_GetObjectItem(object, "NAME")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("first", cJSON_GetObjectItemCaseSensitive(object, "Name")->valuestring);
+    TEST_ASSERT_EQUAL_STRING("second", cJSON_GetObjectItemCaseSensitive(object, "name")->valuestring);
+
+    cJSON_Delete(object);
+}
+
+static void object_lookup_should_follow_mutations(void)
+{
+    cJSON *object = create_object_with_keys(100);
+    cJSON *item = NULL;
+
+    assert_all_keys_found(object, 100);
+
+    /* append after the index was built */
+    TEST_ASSERT_NOT_NULL(cJSON_AddStringToObject(object, "appended", "value"));
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, "appended"));
+    assert_all_keys_found(object, 100);
+
+    /* detach and delete */
+    item = cJSON_DetachItemFromObject(object, "key_50");
+    TEST_ASSERT_NOT_NULL(item);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "key_50"));
+    TEST_ASSERT_NOT_NULL(cJSON_GetObjectItem(object, "key_51"));
+    cJSON_Delete(item);
+    cJSON_DeleteItemFromObjectCaseSensitive(object, "key_0");
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "key_0"));
+    TEST_ASSERT_EQUAL_INT(1, cJSON_GetObjectItem(object, "key_1")->valueint);
+
+    /* replace */
+    TEST_ASSERT_TRUE(cJSON_ReplaceItemInObject(object, "key_10", cJSON_CreateString("replaced")));
+    TEST_ASSERT_EQUAL_STRING("replaced", cJSON_GetObjectItem(object, "key_10")->valuestring);
+
+    /* insert a member at the front */
+    item = cJSON_CreateString("inserted");
+    item->string = (char*)cJSON_malloc(sizeof("front"));
+    strcpy(item->string, "front");
+    TEST_ASSERT_TRUE(cJSON_InsertItemInArray(object, 0, item));
+    TEST_ASSERT_EQUAL_STRING("inserted", cJSON_GetObjectItem(object, "front")->valuestring);
+
+    /* unlink the last member by hand, then tell cJSON about it */
+    item = object->child->prev;
+    item->prev->next = NULL;
+    object->child->prev = item->prev;
+    item->prev = NULL;
+    cJSON_InvalidateIndex(object);
+    TEST_ASSERT_NULL(cJSON_GetObjectItem(object, "appended"));
+    cJSON_Delete(item);
+
+    assert_all_keys_found(object, 0);
+    TEST_ASSERT_EQUAL_INT(99, cJSON_GetObjectItem(object, "key_99")->valueint);
+
+    cJSON_Delete(object);
+}
+
+static void object_lookup_should_work_on_parsed_and_duplicated_objects(void)
+{
+    cJSON *object = create_object_with_keys(300);
+    cJSON *parsed = NULL;
+    cJSON *duplicate = NULL;
+    char *printed = NULL;
+
+    /* make sure the source has an index that must not be shared */
+    assert_all_keys_found(object, 300);
+
+    printed = cJSON_PrintUnformatted(object);
+    TEST_ASSERT_NOT_NULL(printed);
+    parsed = cJSON_Parse(printed);
+    TEST_ASSERT_NOT_NULL(parsed);
+    assert_all_keys_found(parsed, 300);
+
+    duplicate = cJSON_Duplicate(object, true);
+    TEST_ASSERT_NOT_NULL(duplicate);
+    cJSON_Delete(object);
+    assert_all_keys_found(duplicate, 300);
+
+    cJSON_free(printed);
+    cJSON_Delete(parsed);
+    cJSON_Delete(duplicate);
+}
+
+static void object_lookup_should_survive_deleting_a_reference(void)
+{
+    cJSON *object = create_object_with_keys(20);
+    cJSON *holder = cJSON_CreateArray();
+    cJSON *reference = NULL;
+
+    TEST_ASSERT_NOT_NULL(holder);
+    /* build the index before the reference copies the object */
+    TEST_ASSERT_EQUAL_INT(19, cJSON_GetObjectItem(object, "key_19")->valueint);
+#ifdef CJSON_OBJECT_INDEX
+    TEST_ASSERT_NOT_NULL(object->index);
+#endif
+
+    TEST_ASSERT_TRUE(cJSON_AddItemReferenceToArray(holder, object));
+    reference = cJSON_GetArrayItem(holder, 0);
+    assert_all_keys_found(reference, 20);
+#ifdef CJSON_OBJECT_INDEX
+    TEST_ASSERT_NULL(reference->index);
+#endif
+    cJSON_Delete(holder);
+
+    assert_all_keys_found(object, 20);
+    cJSON_Delete(object);
+}
+
+/* Look up every member of objects of growing size and report the cost per lookup. */
+static void object_lookup_benchmark(void)
+{
+    int counts[] = { 8, 32, 128, 512, 2048 };
+    char name[32];
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        cJSON *object = create_object_with_keys(counts[i]);
+        int rounds = (8192 / counts[i]) + 1;
+        int round = 0;
+        int key = 0;
+        long found = 0;
+        clock_t start = 0;
+        double elapsed = 0.0;
+
+        start = clock();
+        for (round = 0; round < rounds; round++)
+        {
+            for (key = 0; key < counts[i]; key++)
+            {
+                sprintf(name, "key_%d", key);
+                found += (cJSON_GetObjectItem(object, name) != NULL);
+            }
+        }
+        elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+        TEST_ASSERT_EQUAL_INT((long)rounds * counts[i], found);
+        printf("%5d members: %8.1f ns per lookup\n", counts[i], (elapsed * 1e9) / ((double)rounds * counts[i]));
+
+        cJSON_Delete(object);
+    }
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(object_lookup_should_find_all_members);
+    RUN_TEST(object_lookup_should_return_first_duplicate);
+    RUN_TEST(object_lookup_should_follow_mutations);
+    RUN_TEST(object_lookup_should_work_on_parsed_and_duplicated_objects);
+    RUN_TEST(object_lookup_should_survive_deleting_a_reference);
+    RUN_TEST(object_lookup_benchmark);
+
+    return UNITY_END();
+}
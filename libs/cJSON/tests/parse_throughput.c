@@ -0,0 +1,220 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* Parse a document over and over in a few runs of about this long each and report the best run in MB/s. */
+#define MEASURE_SECONDS 0.04
+#define MEASURE_RUNS 5
+
+static double parse_throughput(const char *json, size_t length)
+{
+    double best = 0.0;
+    int run = 0;
+
+    for (run = 0; run < MEASURE_RUNS; run++)
+    {
+        clock_t start = clock();
+        clock_t end = start + (clock_t)(MEASURE_SECONDS * CLOCKS_PER_SEC);
+        clock_t now = start;
+        long rounds = 0;
+        double throughput = 0.0;
+
+        do
+        {
+            cJSON *parsed = cJSON_ParseWithLength(json, length);
+            TEST_ASSERT_NOT_NULL(parsed);
+            cJSON_Delete(parsed);
+            rounds++;
+            now = clock();
+        } while (now < end);
+
+        throughput = ((double)rounds * (double)length) / ((double)(now - start) / CLOCKS_PER_SEC) / 1e6;
+        if (throughput > best)
+        {
+            best = throughput;
+        }
+    }
+
+    return best;
+}
+
+static void parse_throughput_on_inputs(void)
+{
+    const char *files[] = { "test1", "test2", "test3", "test4", "test5", "test7", "test8", "test9", "test10", "test11" };
+    char path[64];
+    size_t total_length = 0;
+    double total_seconds = 0.0;
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(files) / sizeof(files[0]); i++)
+    {
+        char *json = NULL;
+        size_t length = 0;
+        double throughput = 0.0;
+
+        sprintf(path, "inputs/%s", files[i]);
+        json = read_file(path);
+        TEST_ASSERT_NOT_NULL_MESSAGE(json, path);
+        length = strlen(json);
+
+        throughput = parse_throughput(json, length);
+        printf("%-7s %6lu bytes: %8.1f MB/s\n", files[i], (unsigned long)length, throughput);
+        total_length += length;
+        total_seconds += (double)length / (throughput * 1e6);
+
+        free(json);
+    }
+
+    printf("inputs  %6lu bytes: %8.1f MB/s\n", (unsigned long)total_length, ((double)total_length / total_seconds) / 1e6);
+}
+
+/* Long string values with an escaped sentence every now and then, where most of the time goes to scanning. */
+static void parse_throughput_on_long_strings(void)
+{
+    const char *escaped = "The quick brown fox jumps over the lazy dog, \\\"twice\\\" and then \\u00e9 once more.\\n ";
+    const char *sentence = "The quick brown fox jumps over the lazy dog, once and then once more. ";
+    const char *decoded = "The quick brown fox jumps over the lazy dog, \"twice\" and then \xc3\xa9 once more.\n The quick";
+    size_t escaped_length = strlen(escaped);
+    size_t sentence_length = strlen(sentence);
+    size_t capacity = 64 * 1024;
+    char *json = (char*)malloc(capacity);
+    size_t length = 0;
+    int value = 0;
+    int repeat = 0;
+    cJSON *parsed = NULL;
+
+    TEST_ASSERT_NOT_NULL(json);
+    json[length++] = '[';
+    for (value = 0; (length + escaped_length + (20 * sentence_length) + 16) < capacity; value++)
+    {
+        length += (size_t)sprintf(json + length, "%s\n    \"", (value == 0) ? "" : ",");
+        memcpy(json + length, escaped, escaped_length);
+        length += escaped_length;
+        for (repeat = 0; repeat < 20; repeat++)
+        {
+            memcpy(json + length, sentence, sentence_length);
+            length += sentence_length;
+        }
+        json[length++] = '\"';
+    }
+    json[length++] = ']';
+    json[length] = '\0';
+
+    parsed = cJSON_Parse(json);
+    TEST_ASSERT_NOT_NULL(parsed);
+    TEST_ASSERT_EQUAL_INT(value, cJSON_GetArraySize(parsed));
+    TEST_ASSERT_EQUAL_STRING_LEN(decoded, cJSON_GetArrayItem(parsed, value - 1)->valuestring, strlen(decoded));
+    cJSON_Delete(parsed);
+
+    printf("strings %6lu bytes: %8.1f MB/s\n", (unsigned long)length, parse_throughput(json, length));
+
+    free(json);
+}
+
+/* Same as parse_throughput for printing an item into a preallocated buffer, in MB/s of output. */
+static double print_throughput(cJSON *item, char *buffer, size_t capacity)
+{
+    size_t length = 0;
+    double best = 0.0;
+    int run = 0;
+
+    TEST_ASSERT_TRUE(cJSON_PrintPreallocated(item, buffer, (int)capacity, false));
+    length = strlen(buffer);
+
+    for (run = 0; run < MEASURE_RUNS; run++)
+    {
+        clock_t start = clock();
+        clock_t end = start + (clock_t)(MEASURE_SECONDS * CLOCKS_PER_SEC);
+        clock_t now = start;
+        long rounds = 0;
+        double throughput = 0.0;
+
+        do
+        {
+            TEST_ASSERT_TRUE(cJSON_PrintPreallocated(item, buffer, (int)capacity, false));
+            rounds++;
+            now = clock();
+        } while (now < end);
+
+        throughput = ((double)rounds * (double)length) / ((double)(now - start) / CLOCKS_PER_SEC) / 1e6;
+        if (throughput > best)
+        {
+            best = throughput;
+        }
+    }
+
+    return best;
+}
+
+/* Arrays of sensor readings like the firmware sends, where most of the time goes to converting numbers. */
+static void parse_throughput_on_numbers(void)
+{
+    size_t capacity = 64 * 1024;
+    char *json = (char*)malloc(capacity);
+    char *printed = (char*)malloc(capacity);
+    size_t length = 0;
+    int value = 0;
+    double throughput = 0.0;
+    cJSON *parsed = NULL;
+
+    TEST_ASSERT_NOT_NULL(json);
+    TEST_ASSERT_NOT_NULL(printed);
+    json[length++] = '[';
+    for (value = 0; (length + 64) < capacity; value++)
+    {
+        length += (size_t)sprintf(json + length, "%s%d.%02d,%.17g,%d", (value == 0) ? "" : ",", 20 + (value % 15), (value * 37) % 100, 1.0 / (value + 3), value * 1009);
+    }
+    json[length++] = ']';
+    json[length] = '\0';
+
+    parsed = cJSON_Parse(json);
+    TEST_ASSERT_NOT_NULL(parsed);
+    TEST_ASSERT_EQUAL_INT(3 * value, cJSON_GetArraySize(parsed));
+    TEST_ASSERT_EQUAL_DOUBLE(1.0 / 3, cJSON_GetArrayItem(parsed, 1)->valuedouble);
+
+    printf("numbers %6lu bytes: %8.1f MB/s\n", (unsigned long)length, parse_throughput(json, length));
+    throughput = print_throughput(parsed, printed, capacity);
+    printf("printed %6lu bytes: %8.1f MB/s\n", (unsigned long)strlen(printed), throughput);
+
+    cJSON_Delete(parsed);
+    free(printed);
+    free(json);
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(parse_throughput_on_inputs);
+    RUN_TEST(parse_throughput_on_long_strings);
+    RUN_TEST(parse_throughput_on_numbers);
+
+    return UNITY_END();
+}
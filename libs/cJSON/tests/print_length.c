@@ -0,0 +1,312 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* allocation statistics collected through the hooks */
+static size_t allocations = 0;
+static size_t reallocations = 0;
+static size_t bytes_in_use = 0;
+static size_t peak_bytes = 0;
+static size_t baseline_bytes = 0;
+
+static void *CJSON_CDECL counting_malloc(size_t size)
+{
+    size_t *block = (size_t*)malloc(sizeof(size_t) + size);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    allocations++;
+    block[0] = size;
+    bytes_in_use += size;
+    if (bytes_in_use > peak_bytes)
+    {
+        peak_bytes = bytes_in_use;
+    }
+
+    return block + 1;
+}
+
+static void CJSON_CDECL counting_free(void *pointer)
+{
+    size_t *block = NULL;
+    if (pointer == NULL)
+    {
+        return;
+    }
+
+    block = ((size_t*)pointer) - 1;
+    bytes_in_use -= block[0];
+    free(block);
+}
+
+static void *CJSON_CDECL counting_realloc(void *pointer, size_t size)
+{
+    size_t *block = NULL;
+    size_t old_size = 0;
+
+    if (pointer != NULL)
+    {
+        old_size = ((size_t*)pointer)[-1];
+    }
+
+    block = (size_t*)realloc((pointer != NULL) ? ((size_t*)pointer) - 1 : NULL, sizeof(size_t) + size);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    reallocations++;
+    block[0] = size;
+    bytes_in_use = bytes_in_use - old_size + size;
+    if (bytes_in_use > peak_bytes)
+    {
+        peak_bytes = bytes_in_use;
+    }
+
+    return block + 1;
+}
+
+static void reset_statistics(void)
+{
+    allocations = 0;
+    reallocations = 0;
+    baseline_bytes = bytes_in_use;
+    peak_bytes = bytes_in_use;
+}
+
+static void assert_printed_length(cJSON *item, cJSON_bool format)
+{
+    char *printed = NULL;
+    char *exact = NULL;
+    char *buffer = NULL;
+    size_t length = 0;
+
+    printed = format ? cJSON_Print(item) : cJSON_PrintUnformatted(item);
+    TEST_ASSERT_NOT_NULL(printed);
+
+    length = cJSON_PrintedLength(item, format);
+    TEST_ASSERT_EQUAL_UINT(strlen(printed), length);
+
+    exact = cJSON_PrintExact(item, format);
+    TEST_ASSERT_NOT_NULL(exact);
+    TEST_ASSERT_EQUAL_STRING(printed, exact);
+
+    /* a buffer of exactly the measured size must be enough, one byte less must not */
+    buffer = (char*)malloc(length + 1);
+    TEST_ASSERT_NOT_NULL(buffer);
+    TEST_ASSERT_TRUE(cJSON_PrintPreallocated(item, buffer, (int)(length + 1), format));
+    TEST_ASSERT_EQUAL_STRING(printed, buffer);
+    TEST_ASSERT_FALSE(cJSON_PrintPreallocated(item, buffer, (int)length, format));
+
+    free(buffer);
+    cJSON_free(exact);
+    cJSON_free(printed);
+}
+
+static void assert_printed_length_of_json(const char *json)
+{
+    cJSON *item = cJSON_Parse(json);
+    TEST_ASSERT_NOT_NULL_MESSAGE(item, json);
+
+    assert_printed_length(item, false);
+    assert_printed_length(item, true);
+
+    cJSON_Delete(item);
+}
+
+/* Build an object nested depth levels deep, each level carrying arrays, numbers and strings. */
+static cJSON *create_nested_document(int depth, int width)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *level = root;
+    int i = 0;
+    int j = 0;
+
+    TEST_ASSERT_NOT_NULL(root);
+
+    for (i = 0; i < depth; i++)
+    {
+        cJSON *numbers = cJSON_AddArrayToObject(level, "numbers");
+        cJSON *records = cJSON_AddArrayToObject(level, "records");
+        TEST_ASSERT_NOT_NULL(numbers);
+        TEST_ASSERT_NOT_NULL(records);
+
+        cJSON_AddStringToObject(level, "name", "level \"quoted\"\twith\\escapes\n\x01");
+        cJSON_AddNumberToObject(level, "depth", i);
+        cJSON_AddBoolToObject(level, "odd", i % 2);
+        cJSON_AddNullToObject(level, "nothing");
+        cJSON_AddRawToObject(level, "raw", "[1,2,3]");
+
+        for (j = 0; j < width; j++)
+        {
+            cJSON *record = cJSON_CreateObject();
+            TEST_ASSERT_NOT_NULL(record);
+
+            cJSON_AddItemToArray(numbers, cJSON_CreateNumber((j * 1.37) - 20.0));
+            cJSON_AddNumberToObject(record, "id", j);
+            cJSON_AddNumberToObject(record, "value", j / 3.0);
+            cJSON_AddStringToObject(record, "label", "record");
+            cJSON_AddItemToObject(record, "empty", cJSON_CreateObject());
+            cJSON_AddItemToObject(record, "list", cJSON_CreateArray());
+            cJSON_AddItemToArray(records, record);
+        }
+
+        level = cJSON_AddObjectToObject(level, "child");
+        TEST_ASSERT_NOT_NULL(level);
+    }
+
+    return root;
+}
+
+static void printed_length_should_match_primitives(void)
+{
+    assert_printed_length_of_json("null");
+    assert_printed_length_of_json("true");
+    assert_printed_length_of_json("false");
+    assert_printed_length_of_json("0");
+    assert_printed_length_of_json("-1.5e300");
+    assert_printed_length_of_json("0.1");
+    assert_printed_length_of_json("\"\"");
+    assert_printed_length_of_json("\"\\\"\\\\\\b\\f\\n\\r\\t\\u0001\"");
+}
+
+static void printed_length_should_match_containers(void)
+{
+    assert_printed_length_of_json("[]");
+    assert_printed_length_of_json("{}");
+    assert_printed_length_of_json("[1,[2,[3,[]]],{}]");
+    assert_printed_length_of_json("{\"a\":{\"b\":{\"c\":[{\"d\":{}}]}},\"e\":[]}");
+}
+
+static void printed_length_should_match_example_files(void)
+{
+    const char *files[] = {
+        "inputs/test1", "inputs/test2", "inputs/test3", "inputs/test4", "inputs/test5",
+        "inputs/test7", "inputs/test8", "inputs/test9", "inputs/test10", "inputs/test11"
+    };
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(files) / sizeof(files[0]); i++)
+    {
+        char *content = read_file(files[i]);
+        TEST_ASSERT_NOT_NULL_MESSAGE(content, files[i]);
+        assert_printed_length_of_json(content);
+        free(content);
+    }
+}
+
+static void printed_length_should_match_large_nested_document(void)
+{
+    cJSON *document = create_nested_document(32, 64);
+
+    assert_printed_length(document, false);
+    assert_printed_length(document, true);
+
+    cJSON_Delete(document);
+}
+
+static void printed_length_should_fail_on_invalid_items(void)
+{
+    cJSON invalid[1];
+    cJSON *raw = cJSON_CreateRaw("1");
+
+    memset(invalid, 0, sizeof(invalid));
+    TEST_ASSERT_EQUAL_UINT(0, cJSON_PrintedLength(NULL, true));
+    TEST_ASSERT_EQUAL_UINT(0, cJSON_PrintedLength(invalid, true));
+    TEST_ASSERT_NULL(cJSON_PrintExact(NULL, true));
+    TEST_ASSERT_NULL(cJSON_PrintExact(invalid, false));
+
+    /* a raw item without content can not be printed */
+    TEST_ASSERT_NOT_NULL(raw);
+    cJSON_free(raw->valuestring);
+    raw->valuestring = NULL;
+    TEST_ASSERT_EQUAL_UINT(0, cJSON_PrintedLength(raw, false));
+    TEST_ASSERT_NULL(cJSON_PrintExact(raw, false));
+    cJSON_Delete(raw);
+}
+
+/* Compare the allocations of the growing printer with the exact one on a large nested document. */
+static void print_exact_should_allocate_once(void)
+{
+    cJSON_Hooks hooks = { counting_malloc, counting_free };
+    cJSON *document = NULL;
+    char *printed = NULL;
+    size_t growing_allocations = 0;
+    size_t growing_peak = 0;
+    size_t length = 0;
+    cJSON_bool format = false;
+
+    for (format = 0; format <= 1; format++)
+    {
+        cJSON_InitHooks(&hooks);
+        global_hooks.reallocate = counting_realloc;
+
+        document = create_nested_document(32, 64);
+        length = cJSON_PrintedLength(document, format);
+
+        reset_statistics();
+        printed = format ? cJSON_Print(document) : cJSON_PrintUnformatted(document);
+        TEST_ASSERT_NOT_NULL(printed);
+        growing_allocations = allocations + reallocations;
+        growing_peak = peak_bytes - baseline_bytes;
+        cJSON_free(printed);
+
+        reset_statistics();
+        printed = cJSON_PrintExact(document, format);
+        TEST_ASSERT_NOT_NULL(printed);
+        TEST_ASSERT_EQUAL_UINT(1, allocations);
+        TEST_ASSERT_EQUAL_UINT(0, reallocations);
+        TEST_ASSERT_EQUAL_UINT(length + 1, peak_bytes - baseline_bytes);
+
+        printf("%s document of %lu bytes: cJSON_Print %lu allocations, %lu bytes peak; cJSON_PrintExact 1 allocation, %lu bytes peak\n",
+               format ? "formatted" : "unformatted", (unsigned long)length,
+               (unsigned long)growing_allocations, (unsigned long)growing_peak, (unsigned long)(length + 1));
+        TEST_ASSERT_TRUE(growing_allocations > 1);
+        TEST_ASSERT_TRUE(growing_peak > length + 1);
+
+        cJSON_free(printed);
+        cJSON_Delete(document);
+        cJSON_InitHooks(NULL);
+    }
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(printed_length_should_match_primitives);
+    RUN_TEST(printed_length_should_match_containers);
+    RUN_TEST(printed_length_should_match_example_files);
+    RUN_TEST(printed_length_should_match_large_nested_document);
+    RUN_TEST(printed_length_should_fail_on_invalid_items);
+    RUN_TEST(print_exact_should_allocate_once);
+
+    return UNITY_END();
+}
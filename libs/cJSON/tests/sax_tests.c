@@ -0,0 +1,388 @@
+/*
+  Copyright (c) 2009-2017 Dave Gamble and cJSON contributors
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "common.h"
+
+/* Every event is written to a log as one line, for the streaming parser and for a walk over the tree. */
+typedef struct
+{
+    char *text;
+    size_t length;
+    size_t capacity;
+    int stop_after; /* fail the callback with this many events in the log, -1 for never */
+    int events;
+} event_log;
+
+static char token_buffer[1024];
+
+static cJSON_bool log_event(event_log *log, const char *kind, const char *text)
+{
+    size_t length = strlen(kind) + ((text != NULL) ? strlen(text) : 0) + 1;
+
+    TEST_ASSERT_TRUE(log->length + length < log->capacity);
+    sprintf(log->text + log->length, "%s%s\n", kind, (text != NULL) ? text : "");
+    log->length += length;
+    log->events++;
+
+    return log->events != log->stop_after;
+}
+
+static void log_item(event_log *log, const cJSON *item)
+{
+    char number[64];
+
+    if (cJSON_IsString(item))
+    {
+        log_event(log, "s:", item->valuestring);
+    }
+    else if (cJSON_IsNumber(item))
+    {
+        sprintf(number, "%.17g/%d", item->valuedouble, item->valueint);
+        log_event(log, "n:", number);
+    }
+    else if (cJSON_IsTrue(item))
+    {
+        log_event(log, "true", NULL);
+    }
+    else if (cJSON_IsFalse(item))
+    {
+        log_event(log, "false", NULL);
+    }
+    else
+    {
+        log_event(log, "null", NULL);
+    }
+}
+
+static cJSON_bool CJSON_CDECL on_begin_object(void *user_data)
+{
+    return log_event((event_log*)user_data, "{", NULL);
+}
+
+static cJSON_bool CJSON_CDECL on_end_object(void *user_data)
+{
+    return log_event((event_log*)user_data, "}", NULL);
+}
+
+static cJSON_bool CJSON_CDECL on_begin_array(void *user_data)
+{
+    return log_event((event_log*)user_data, "[", NULL);
+}
+
+static cJSON_bool CJSON_CDECL on_end_array(void *user_data)
+{
+    return log_event((event_log*)user_data, "]", NULL);
+}
+
+static cJSON_bool CJSON_CDECL on_key(void *user_data, const char *key, size_t length)
+{
+    TEST_ASSERT_EQUAL_UINT((unsigned int)strlen(key), (unsigned int)length);
+    return log_event((event_log*)user_data, "k:", key);
+}
+
+static cJSON_bool CJSON_CDECL on_value(void *user_data, const cJSON *item)
+{
+    event_log *log = (event_log*)user_data;
+    int events = log->events;
+
+    log_item(log, item);
+    return events + 1 != log->stop_after;
+}
+
+static const cJSON_SaxCallbacks callbacks = { on_begin_object, on_end_object, on_begin_array, on_end_array, on_key, on_value };
+
+static void log_tree(event_log *log, const cJSON *item)
+{
+    const cJSON *child = NULL;
+
+    if (cJSON_IsObject(item) || cJSON_IsArray(item))
+    {
+        log_event(log, cJSON_IsObject(item) ? "{" : "[", NULL);
+        for (child = item->child; child != NULL; child = child->next)
+        {
+            if (cJSON_IsObject(item))
+            {
+                log_event(log, "k:", child->string);
+            }
+            log_tree(log, child);
+        }
+        log_event(log, cJSON_IsObject(item) ? "}" : "]", NULL);
+    }
+    else
+    {
+        log_item(log, item);
+    }
+}
+
+static void log_init(event_log *log)
+{
+    log->capacity = 64 * 1024;
+    log->text = (char*)malloc(log->capacity);
+    TEST_ASSERT_NOT_NULL(log->text);
+    log->text[0] = '\0';
+    log->length = 0;
+    log->stop_after = -1;
+    log->events = 0;
+}
+
+/* Feed json in chunks of chunk_size bytes, the first one starting at first_chunk. */
+static cJSON_bool sax_parse_chunked(const char *json, size_t length, size_t first_chunk, size_t chunk_size, event_log *log, cJSON_SaxParser *parser)
+{
+    size_t offset = 0;
+
+    cJSON_SaxInit(parser, &callbacks, log, token_buffer, sizeof(token_buffer));
+    if (!cJSON_SaxFeed(parser, json, (first_chunk < length) ? first_chunk : length))
+    {
+        return false;
+    }
+    for (offset = first_chunk; offset < length; offset += chunk_size)
+    {
+        if (!cJSON_SaxFeed(parser, json + offset, ((length - offset) < chunk_size) ? (length - offset) : chunk_size))
+        {
+            return false;
+        }
+    }
+
+    return cJSON_SaxFinish(parser);
+}
+
+/* The streaming parser has to see the same events as a walk over the tree, split into chunks in any way. */
+static void assert_same_events_as_tree(const char *json, size_t length)
+{
+    const size_t chunk_sizes[] = { 1, 2, 3, 7, 64, 1460 };
+    event_log expected;
+    event_log actual;
+    cJSON_SaxParser parser;
+    cJSON *tree = NULL;
+    size_t i = 0;
+
+    log_init(&expected);
+    log_init(&actual);
+
+    tree = cJSON_ParseWithLength(json, length);
+    TEST_ASSERT_NOT_NULL(tree);
+    log_tree(&expected, tree);
+    cJSON_Delete(tree);
+
+    TEST_ASSERT_TRUE(cJSON_SaxParse(json, length, &callbacks, &actual, token_buffer, sizeof(token_buffer)));
+    TEST_ASSERT_EQUAL_STRING(expected.text, actual.text);
+
+    for (i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); i++)
+    {
+        actual.length = 0;
+        actual.text[0] = '\0';
+        TEST_ASSERT_TRUE(sax_parse_chunked(json, length, chunk_sizes[i], chunk_sizes[i], &actual, &parser));
+        TEST_ASSERT_EQUAL_STRING(expected.text, actual.text);
+        TEST_ASSERT_EQUAL_UINT((unsigned int)length, (unsigned int)parser.offset);
+    }
+
+    free(expected.text);
+    free(actual.text);
+}
+
+static void sax_should_match_tree_on_inputs(void)
+{
+    const char *files[] = { "test1", "test2", "test3", "test4", "test5", "test7", "test8", "test9", "test10", "test11" };
+    char path[64];
+    size_t i = 0;
+
+    for (i = 0; i < sizeof(files) / sizeof(files[0]); i++)
+    {
+        char *json = NULL;
+
+        sprintf(path, "inputs/%s", files[i]);
+        json = read_file(path);
+        TEST_ASSERT_NOT_NULL_MESSAGE(json, path);
+        assert_same_events_as_tree(json, strlen(json));
+        free(json);
+    }
+}
+
+static void sax_should_match_tree_at_every_split(void)
+{
+    const char *json = "\xEF\xBB\xBF {\"name\" : \"caf\\u00e9 \\\"\\ud83d\\ude00\\\"\\n\\/\", \"t\":[-1.5e3,0,22.75, 1e400,true,false,null,[],{}],"
+        "\"\\u0041\":{\"nested\":[[123456789012345678901234]]}, \"control\t\":\"tab\there\", \"last\":-0 } ";
+    size_t length = strlen(json);
+    event_log expected;
+    event_log actual;
+    cJSON_SaxParser parser;
+    cJSON *tree = NULL;
+    size_t split = 0;
+
+    log_init(&expected);
+    log_init(&actual);
+    tree = cJSON_ParseWithLength(json, length);
+    TEST_ASSERT_NOT_NULL(tree);
+    log_tree(&expected, tree);
+    cJSON_Delete(tree);
+
+    for (split = 0; split <= length; split++)
+    {
+        actual.length = 0;
+        actual.text[0] = '\0';
+        TEST_ASSERT_TRUE(sax_parse_chunked(json, length, split, length, &actual, &parser));
+        TEST_ASSERT_EQUAL_STRING(expected.text, actual.text);
+    }
+
+    free(expected.text);
+    free(actual.text);
+}
+
+static void sax_should_parse_scalars_at_the_root(void)
+{
+    assert_same_events_as_tree("123", 3);
+    assert_same_events_as_tree("  -0.25e-2 ", 11);
+    assert_same_events_as_tree("\"text\"", 6);
+    assert_same_events_as_tree("null", 4);
+    assert_same_events_as_tree("true\n", 5);
+}
+
+static void assert_sax_fails_at(const char *json, size_t error_offset)
+{
+    size_t length = strlen(json);
+    event_log log;
+    cJSON_SaxParser parser;
+    size_t chunk_size = 0;
+
+    log_init(&log);
+    for (chunk_size = 1; chunk_size <= length + 1; chunk_size++)
+    {
+        TEST_ASSERT_FALSE_MESSAGE(sax_parse_chunked(json, length, chunk_size, chunk_size, &log, &parser), json);
+        TEST_ASSERT_EQUAL_UINT_MESSAGE((unsigned int)error_offset, (unsigned int)parser.offset, json);
+        /* the parser stays failed */
+        TEST_ASSERT_FALSE(cJSON_SaxFeed(&parser, "1", 1));
+        TEST_ASSERT_FALSE(cJSON_SaxFinish(&parser));
+    }
+    free(log.text);
+}
+
+static void sax_should_fail_on_invalid_json(void)
+{
+    assert_sax_fails_at("", 0);
+    assert_sax_fails_at("   ", 3);
+    assert_sax_fails_at("{", 1);
+    assert_sax_fails_at("[1,]", 3);
+    assert_sax_fails_at("[1 2]", 3);
+    assert_sax_fails_at("[1}", 2);
+    assert_sax_fails_at("{\"a\" 1}", 5);
+    assert_sax_fails_at("{1:2}", 1);
+    assert_sax_fails_at("{\"a\":1,}", 7);
+    assert_sax_fails_at("[tru]", 4);
+    assert_sax_fails_at("[1.2.3]", 6);
+    assert_sax_fails_at("[-]", 2);
+    assert_sax_fails_at("\"abc", 4);
+    assert_sax_fails_at("\"\\x\"", 2);
+    assert_sax_fails_at("\"\\u12G4\"", 5);
+    assert_sax_fails_at("\"\\udc00\"", 6);
+    assert_sax_fails_at("\"\\ud800x\"", 7);
+    assert_sax_fails_at("\"\\ud800\\u0041\"", 12);
+    assert_sax_fails_at("[1] x", 4);
+    assert_sax_fails_at("{}}", 2);
+    assert_sax_fails_at("\xEF\xBB{}", 2);
+}
+
+static void sax_should_limit_nesting(void)
+{
+    char json[(CJSON_NESTING_LIMIT + 1) * 2 + 1];
+    event_log log;
+    size_t i = 0;
+
+    log_init(&log);
+    for (i = 0; i < CJSON_NESTING_LIMIT; i++)
+    {
+        json[i] = '[';
+        json[(2 * CJSON_NESTING_LIMIT) - 1 - i] = ']';
+    }
+    json[2 * CJSON_NESTING_LIMIT] = '\0';
+    TEST_ASSERT_TRUE(cJSON_SaxParse(json, strlen(json), &callbacks, &log, token_buffer, sizeof(token_buffer)));
+
+    for (i = 0; i <= CJSON_NESTING_LIMIT; i++)
+    {
+        json[i] = '[';
+        json[(2 * CJSON_NESTING_LIMIT) + 1 - i] = ']';
+    }
+    json[(2 * CJSON_NESTING_LIMIT) + 2] = '\0';
+    log.length = 0;
+    TEST_ASSERT_FALSE(cJSON_SaxParse(json, strlen(json), &callbacks, &log, token_buffer, sizeof(token_buffer)));
+
+    free(log.text);
+}
+
+static void sax_should_fail_when_tokens_dont_fit(void)
+{
+    char small[8];
+    event_log log;
+
+    log_init(&log);
+    TEST_ASSERT_TRUE(cJSON_SaxParse("[\"1234567\",1234567]", 19, &callbacks, &log, small, sizeof(small)));
+    TEST_ASSERT_FALSE(cJSON_SaxParse("[\"12345678\"]", 12, &callbacks, &log, small, sizeof(small)));
+    TEST_ASSERT_FALSE(cJSON_SaxParse("[12345678]", 10, &callbacks, &log, small, sizeof(small)));
+    TEST_ASSERT_FALSE(cJSON_SaxParse("{\"\\ud83d\\ude00\\ud83d\\ude00\":1}", 30, &callbacks, &log, small, sizeof(small)));
+    TEST_ASSERT_FALSE(cJSON_SaxParse("1", 1, &callbacks, &log, small, 0));
+    free(log.text);
+}
+
+static void sax_should_stop_when_a_callback_fails(void)
+{
+    event_log log;
+    cJSON_SaxParser parser;
+
+    log_init(&log);
+    log.stop_after = 3;
+    TEST_ASSERT_FALSE(sax_parse_chunked("{\"a\":[1,2]}", 11, 11, 11, &log, &parser));
+    TEST_ASSERT_EQUAL_INT(3, log.events);
+    TEST_ASSERT_EQUAL_STRING("{\nk:a\n[\n", log.text);
+    TEST_ASSERT_EQUAL_UINT(5, (unsigned int)parser.offset);
+    free(log.text);
+}
+
+static void sax_should_allow_null_callbacks(void)
+{
+    const cJSON_SaxCallbacks no_callbacks = { NULL, NULL, NULL, NULL, NULL, NULL };
+
+    TEST_ASSERT_TRUE(cJSON_SaxParse("{\"a\":[1,\"b\",null]}", 18, &no_callbacks, NULL, token_buffer, sizeof(token_buffer)));
+    TEST_ASSERT_FALSE(cJSON_SaxParse("{\"a\":[1,\"b\",null]}", 18, NULL, NULL, token_buffer, sizeof(token_buffer)));
+    TEST_ASSERT_FALSE(cJSON_SaxParse("{\"a\":[1,\"b\",null]}", 18, &no_callbacks, NULL, NULL, 0));
+}
+
+int CJSON_CDECL main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(sax_should_match_tree_on_inputs);
+    RUN_TEST(sax_should_match_tree_at_every_split);
+    RUN_TEST(sax_should_parse_scalars_at_the_root);
+    RUN_TEST(sax_should_fail_on_invalid_json);
+    RUN_TEST(sax_should_limit_nesting);
+    RUN_TEST(sax_should_fail_when_tokens_dont_fit);
+    RUN_TEST(sax_should_stop_when_a_callback_fails);
+    RUN_TEST(sax_should_allow_null_callbacks);
+
+    return UNITY_END();
+}
@@ -25,6 +25,8 @@ SOFTWARE.
 
 #include <pico/stdlib.h>
 #include <hardware/i2c.h>
+#include <hardware/dma.h>
+#include <hardware/irq.h>
 #include <pico/binary_info.h>
 #include <stdlib.h>
 #include <string.h>
@@ -55,9 +57,64 @@ inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src
 
 inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
     uint8_t d[2]= {0x00, val};
+    ssd1306_wait(p);
     fancy_write(p->i2c_i, p->address, d, 2, "ssd1306_write");
 }
 
+static ssd1306_t *dma_owner[NUM_DMA_CHANNELS];
+
+static void ssd1306_dma_irq_handler(void) {
+    for(uint ch=0; ch<NUM_DMA_CHANNELS; ++ch) {
+        ssd1306_t *p=dma_owner[ch];
+        if(p==NULL || !dma_channel_get_irq1_status(ch))
+            continue;
+
+        dma_channel_acknowledge_irq1(ch);
+        p->dma_busy=false;
+        if(p->done_cb)
+            p->done_cb(p->done_user_data);
+    }
+}
+
+static void ssd1306_dma_init(ssd1306_t *p) {
+    static bool irq_installed=false;
+
+    p->dma_chan=dma_claim_unused_channel(true);
+    dma_channel_config c=dma_channel_get_default_config(p->dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(p->i2c_i, true));
+    dma_channel_configure(p->dma_chan, &c, &i2c_get_hw(p->i2c_i)->data_cmd, p->dma_cmds, 0, false);
+
+    dma_owner[p->dma_chan]=p;
+    p->dma_busy=false;
+    p->done_cb=NULL;
+
+    if(!irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_1, ssd1306_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+        irq_installed=true;
+    }
+    dma_channel_set_irq1_enabled(p->dma_chan, true);
+}
+
+// one i2c transaction in the DMA command stream: the STOP bit on its last byte ends it,
+// and the controller starts the next one from the following word in the FIFO
+static uint16_t *ssd1306_stream_write(uint16_t *w, uint8_t control, const uint8_t *src, size_t len) {
+    *w++=control;
+    for(size_t i=0; i<len; ++i)
+        *w++=src[i];
+    w[-1]|=I2C_IC_DATA_CMD_STOP_BITS;
+    return w;
+}
+
+static uint16_t *ssd1306_stream_range(ssd1306_t *p, uint16_t *w, uint8_t col_start, uint8_t col_end, uint8_t page_start, uint8_t page_end) {
+    uint8_t col_offset=p->width==64?32:0;
+    uint8_t payload[]= {SET_COL_ADDR, col_offset+col_start, col_offset+col_end, SET_PAGE_ADDR, page_start, page_end};
+    return ssd1306_stream_write(w, 0x00, payload, sizeof(payload));
+}
+
 bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
     p->width=width;
     p->height=height;
@@ -68,12 +125,23 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 
 
     p->bufsize=(p->pages)*(p->width);
-    if((p->buffer=malloc(p->bufsize+1))==NULL) {
+    // buffer and shadow in one block
+    if((p->buffer=malloc(2*p->bufsize))==NULL) {
         p->bufsize=0;
         return false;
     }
 
-    ++(p->buffer);
+    // worst case: addressing and one column range on every page
+    if((p->dma_cmds=malloc(p->pages*(p->width+8)*sizeof(uint16_t)))==NULL) {
+        free(p->buffer);
+        p->bufsize=0;
+        return false;
+    }
+
+    p->shadow=p->buffer+p->bufsize;
+    p->shadow_valid=false;
+
+    ssd1306_dma_init(p);
 
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[]= {
@@ -116,7 +184,12 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 }
 
 inline void ssd1306_deinit(ssd1306_t *p) {
-    free(p->buffer-1);
+    ssd1306_wait(p);
+    dma_channel_set_irq1_enabled(p->dma_chan, false);
+    dma_owner[p->dma_chan]=NULL;
+    dma_channel_unclaim(p->dma_chan);
+    free(p->dma_cmds);
+    free(p->buffer);
 }
 
 inline void ssd1306_poweroff(ssd1306_t *p) {
@@ -174,16 +247,32 @@ void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t
     }
 }
 
+// sets or clears a rectangle one page at a time, with a mask per page instead of a call per pixel
+static void ssd1306_fill_rect(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool set) {
+    if(x>=p->width || y>=p->height || !width || !height) return;
+
+    uint32_t x_end=width>p->width-x?p->width:x+width;
+    uint32_t y_end=height>p->height-y?p->height:y+height;
+
+    for(uint32_t top=y&~7u; top<y_end; top+=8) {
+        uint32_t from=y>top?y-top:0;
+        uint32_t to=y_end-top<8?y_end-top:8;
+        uint8_t mask=(uint8_t)((0xFFu<<from)&(0xFFu>>(8-to)));
+        uint8_t *b=p->buffer+p->width*(top>>3);
+
+        if(set)
+            for(uint32_t i=x; i<x_end; ++i) b[i]|=mask;
+        else
+            for(uint32_t i=x; i<x_end; ++i) b[i]&=~mask;
+    }
+}
+
 void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_clear_pixel(p, x+i, y+j);
+    ssd1306_fill_rect(p, x, y, width, height, false);
 }
 
 void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_draw_pixel(p, x+i, y+j);
+    ssd1306_fill_rect(p, x, y, width, height, true);
 }
 
 void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
@@ -193,11 +282,37 @@ void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t wi
     ssd1306_draw_line(p, x+width, y, x+width, y+height);
 }
 
+// ORs a column of n stacked bytes (bit 0 on top) at x,y; an unaligned y spills into the page below
+static inline void ssd1306_blit_column(ssd1306_t *p, uint32_t x, uint32_t y, const uint8_t *src, uint32_t n) {
+    if(x>=p->width) return;
+
+    uint32_t page=y>>3, shift=y&7;
+    uint8_t *col=p->buffer+x;
+
+    for(uint32_t k=0; k<n; ++k, ++page) {
+        uint8_t v=src[k];
+        if(!v) continue;
+        if(page<p->pages)
+            col[p->width*page]|=(uint8_t)(v<<shift);
+        if(shift && page+1<p->pages)
+            col[p->width*(page+1)]|=(uint8_t)(v>>(8-shift));
+    }
+}
+
 void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
     if(c<font[3]||c>font[4])
         return;
 
     uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
+
+    if(scale==1) {
+        // font columns have the same layout as the display RAM: one byte per 8 rows
+        const uint8_t *line=font+5+(c-font[3])*font[1]*parts_per_line;
+        for(uint8_t w=0; w<font[1]; ++w, line+=parts_per_line)
+            ssd1306_blit_column(p, x+w, y, line, parts_per_line);
+        return;
+    }
+
     for(uint8_t w=0; w<font[1]; ++w) { // width
         uint32_t pp=(c-font[3])*font[1]*parts_per_line+w*parts_per_line+5;
         for(uint32_t lp=0; lp<parts_per_line; ++lp) {
@@ -227,6 +342,56 @@ void ssd1306_draw_string(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, c
     ssd1306_draw_string_with_font(p, x, y, scale, font_8x5, s);
 }
 
+bool ssd1306_glyph_cache_init(ssd1306_glyph_cache_t *cache, const uint8_t *font, uint32_t scale) {
+    uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
+    uint32_t chars=font[4]-font[3]+1;
+
+    cache->font=font;
+    cache->scale=scale;
+    cache->pages=parts_per_line*scale;
+    if(scale==0 || (cache->glyphs=calloc(chars*font[1], cache->pages))==NULL) {
+        cache->glyphs=NULL;
+        return false;
+    }
+
+    // every font row becomes scale rows of the cached column
+    uint8_t *dst=cache->glyphs;
+    const uint8_t *src=font+5;
+    for(uint32_t n=chars*font[1]; n; --n, src+=parts_per_line, dst+=cache->pages) {
+        for(uint32_t row=0; row<(parts_per_line<<3); ++row) {
+            if(!(src[row>>3]&(1<<(row&7))))
+                continue;
+            for(uint32_t r=row*scale; r<(row+1)*scale; ++r)
+                dst[r>>3]|=1<<(r&7);
+        }
+    }
+
+    return true;
+}
+
+void ssd1306_glyph_cache_deinit(ssd1306_glyph_cache_t *cache) {
+    free(cache->glyphs);
+    cache->glyphs=NULL;
+}
+
+void ssd1306_draw_char_cached(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_glyph_cache_t *cache, char c) {
+    const uint8_t *font=cache->font;
+    if(c<font[3]||c>font[4])
+        return;
+
+    const uint8_t *line=cache->glyphs+(c-font[3])*font[1]*cache->pages;
+    for(uint8_t w=0; w<font[1]; ++w, line+=cache->pages)
+        for(uint32_t s=0; s<cache->scale; ++s)
+            ssd1306_blit_column(p, x+w*cache->scale+s, y, line, cache->pages);
+}
+
+void ssd1306_draw_string_cached(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_glyph_cache_t *cache, const char *s) {
+    const uint8_t *font=cache->font;
+    for(int32_t x_n=x; *s; x_n+=(font[1]+font[2])*cache->scale) {
+        ssd1306_draw_char_cached(p, x_n, y, cache, *(s++));
+    }
+}
+
 static inline uint32_t ssd1306_bmp_get_val(const uint8_t *data, const size_t offset, uint8_t size) {
     switch(size) {
     case 1:
@@ -290,17 +455,88 @@ inline void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long
     ssd1306_bmp_show_image_with_offset(p, data, size, 0, 0);
 }
 
-void ssd1306_show(ssd1306_t *p) {
-    uint8_t payload[]= {SET_COL_ADDR, 0, p->width-1, SET_PAGE_ADDR, 0, p->pages-1};
-    if(p->width==64) {
-        payload[1]+=32;
-        payload[2]+=32;
+bool ssd1306_show_async(ssd1306_t *p) {
+    if(p->dma_busy)
+        return false;
+
+    i2c_hw_t *hw=i2c_get_hw(p->i2c_i);
+
+    // a NAK aborts the transfer and leaves the display RAM unknown
+    if(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        (void) hw->clr_tx_abrt;
+        p->shadow_valid=false;
     }
 
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
+    uint16_t *w=p->dma_cmds;
+
+    if(!p->shadow_valid) {
+        w=ssd1306_stream_range(p, w, 0, p->width-1, 0, p->pages-1);
+        w=ssd1306_stream_write(w, 0x40, p->buffer, p->bufsize);
+        memcpy(p->shadow, p->buffer, p->bufsize);
+        p->shadow_valid=true;
+    } else {
+        // per page, send only the range between the first and the last changed column
+        for(uint8_t page=0; page<p->pages; ++page) {
+            const uint8_t *cur=p->buffer+page*p->width;
+            uint8_t *old=p->shadow+page*p->width;
+
+            uint32_t first=0;
+            while(first<p->width && cur[first]==old[first])
+                ++first;
+            if(first==p->width)
+                continue;
+
+            uint32_t last=p->width-1;
+            while(cur[last]==old[last])
+                --last;
+
+            w=ssd1306_stream_range(p, w, first, last, page, page);
+            w=ssd1306_stream_write(w, 0x40, cur+first, last-first+1);
+            memcpy(old+first, cur+first, last-first+1);
+        }
+    }
+
+    if(w==p->dma_cmds)
+        return true;
+
+    // the target address only changes between transfers, with the bus idle
+    if(hw->tar!=p->address) {
+        ssd1306_wait(p);
+        hw->enable=0;
+        hw->tar=p->address;
+        hw->enable=1;
+    }
+
+    p->dma_busy=true;
+    dma_channel_transfer_from_buffer_now(p->dma_chan, p->dma_cmds, w-p->dma_cmds);
+    return true;
+}
+
+inline bool ssd1306_busy(ssd1306_t *p) {
+    return p->dma_busy;
+}
+
+void ssd1306_wait(ssd1306_t *p) {
+    while(p->dma_busy)
+        tight_loop_contents();
+
+    // the last bytes may still be in the TX FIFO after DMA is done
+    i2c_hw_t *hw=i2c_get_hw(p->i2c_i);
+    while(!(hw->status & I2C_IC_STATUS_TFE_BITS) || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+        tight_loop_contents();
+}
 
-    *(p->buffer-1)=0x40;
+inline void ssd1306_set_done_callback(ssd1306_t *p, void (*cb)(void *user_data), void *user_data) {
+    p->done_cb=cb;
+    p->done_user_data=user_data;
+}
+
+void ssd1306_show(ssd1306_t *p) {
+    ssd1306_wait(p);
+    ssd1306_show_async(p);
+    ssd1306_wait(p);
+}
 
-    fancy_write(p->i2c_i, p->address, p->buffer-1, p->bufsize+1, "ssd1306_show");
+inline void ssd1306_invalidate(ssd1306_t *p) {
+    p->shadow_valid=false;
 }
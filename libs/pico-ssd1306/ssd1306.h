@@ -68,8 +68,25 @@ typedef struct {
     bool external_vcc; 	/**< whether display uses external vcc */ 
     uint8_t *buffer;	/**< display buffer */
     size_t bufsize;		/**< buffer size */
+    uint8_t *shadow;	/**< copy of what was last sent to the display, to send only changed columns */
+    bool shadow_valid;	/**< whether shadow matches the display RAM */
+    uint16_t *dma_cmds;	/**< i2c commands read by DMA; drawing into buffer can go on meanwhile */
+    int dma_chan;		/**< DMA channel feeding the i2c TX FIFO */
+    volatile bool dma_busy;	/**< whether a transfer is running */
+    void (*done_cb)(void *user_data);	/**< called from the DMA interrupt when a transfer finishes */
+    void *done_user_data;	/**< passed to done_cb */
 } ssd1306_t;
 
+/**
+*	@brief font glyphs scaled once, to draw larger text without scaling every pixel
+*/
+typedef struct {
+    const uint8_t *font;	/**< font the glyphs were built from */
+    uint32_t scale;		/**< scale of the cached glyphs */
+    uint32_t pages;		/**< bytes per scaled glyph column */
+    uint8_t *glyphs;	/**< one scaled column per font column, drawn scale times side by side */
+} ssd1306_glyph_cache_t;
+
 /**
 *	@brief initialize display
 *
@@ -130,11 +147,65 @@ void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 /**
 	@brief display buffer, should be called on change
 
+	only the columns that changed since the last call are sent, as one
+	column range per page
+
 	@param[in] p : instance of display
 
 */
 void ssd1306_show(ssd1306_t *p);
 
+/**
+	@brief start sending the buffer in the background, using DMA
+
+	the changed columns are copied to a separate command buffer, so the
+	display buffer can be drawn again right away
+
+	@param[in] p : instance of display
+	@return bool.
+	@retval true if the transfer started, or nothing changed
+	@retval false if the previous transfer is still running; nothing is
+	lost, the changes are sent by the next call
+
+*/
+bool ssd1306_show_async(ssd1306_t *p);
+
+/**
+	@brief check whether a transfer started by ssd1306_show_async is running
+
+	@param[in] p : instance of display
+
+*/
+bool ssd1306_busy(ssd1306_t *p);
+
+/**
+	@brief wait until the running transfer is done and the i2c bus is idle
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_wait(ssd1306_t *p);
+
+/**
+	@brief set a function called from the DMA interrupt when a transfer finishes
+
+	@param[in] p : instance of display
+	@param[in] cb : callback, or NULL
+	@param[in] user_data : passed to cb
+
+*/
+void ssd1306_set_done_callback(ssd1306_t *p, void (*cb)(void *user_data), void *user_data);
+
+/**
+	@brief send the whole buffer on the next ssd1306_show
+
+	use when the display RAM may no longer match what was sent
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_invalidate(ssd1306_t *p);
+
 /**
 	@brief clear display buffer
 
@@ -228,6 +299,9 @@ void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long size);
 /**
 	@brief draw char with given font
 
+	at scale 1 each font column is ORed into the buffer as whole bytes;
+	for larger scales, see ssd1306_glyph_cache_init
+
 	@param[in] p : instance of display
 	@param[in] x : x starting position of char
 	@param[in] y : y starting position of char
@@ -271,4 +345,51 @@ void ssd1306_draw_string_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_
 */
 void ssd1306_draw_string(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const char *s);
 
+/**
+	@brief build a glyph cache for a font at a given scale
+
+	uses (last-first+1)*width*ceil(height/8)*scale bytes of heap,
+	950 bytes for the builtin font at scale 2
+
+	@param[out] cache : cache to fill
+	@param[in] font : pointer to font
+	@param[in] scale : scale font to n times of original size
+	@return bool.
+	@retval true for Success
+	@retval false if the memory could not be allocated
+*/
+bool ssd1306_glyph_cache_init(ssd1306_glyph_cache_t *cache, const uint8_t *font, uint32_t scale);
+
+/**
+	@brief free the memory of a glyph cache
+
+	@param[in] cache : cache built by ssd1306_glyph_cache_init
+*/
+void ssd1306_glyph_cache_deinit(ssd1306_glyph_cache_t *cache);
+
+/**
+	@brief draw char from a glyph cache
+
+	draws the same pixels as ssd1306_draw_char_with_font with the
+	cache's font and scale, a column byte at a time
+
+	@param[in] p : instance of display
+	@param[in] x : x starting position of char
+	@param[in] y : y starting position of char
+	@param[in] cache : glyph cache
+	@param[in] c : character to draw
+*/
+void ssd1306_draw_char_cached(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_glyph_cache_t *cache, char c);
+
+/**
+	@brief draw string from a glyph cache
+
+	@param[in] p : instance of display
+	@param[in] x : x starting position of text
+	@param[in] y : y starting position of text
+	@param[in] cache : glyph cache
+	@param[in] s : text to draw
+*/
+void ssd1306_draw_string_cached(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_glyph_cache_t *cache, const char *s);
+
 #endif
@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "cJSON.h"
+#include "utils/connection_manager.h"
+
+#define DEVICE_ID "e6614103e7a2b534"
+#define ROUNDS 200000
+
+static wifi_config_t config = {
+    .ssid = "rede",
+    .senha = "senha",
+    .api_host = "192.168.0.10",
+    .api_port = 3000,
+    .api_url = "/alert",
+    .telemetry_url = "/telemetry"
+};
+
+// Alocações feitas pelo cJSON, contadas pelos hooks
+static size_t allocated_bytes;
+static uint32_t allocations;
+
+static void *counting_malloc(size_t size) {
+    allocated_bytes += size;
+    allocations++;
+    return malloc(size);
+}
+
+// Buffers do caminho antigo: a entrada da fila guardava o JSON e o envio montava a requisição
+static char old_payload[768];
+static char old_request[1024];
+static int old_request_len;
+
+/**
+ * @brief Enfileiramento de um alerta como era feito antes do json_writer: árvore do cJSON,
+ * cJSON_Print, cópia para a fila e snprintf da requisição no envio
+ */
+static bool old_send_alert(int temperatura, int temp_max, int temp_min) {
+    cJSON *alert = cJSON_CreateObject();
+
+    cJSON_AddStringToObject(alert, "deviceId", DEVICE_ID);
+    cJSON_AddNumberToObject(alert, "temperature", temperatura);
+    cJSON_AddNumberToObject(alert, "maxTemperature", temp_max);
+    cJSON_AddNumberToObject(alert, "minTemperature", temp_min);
+
+    char *json_str = cJSON_Print(alert);
+    size_t len = strlen(json_str);
+    bool result = len < sizeof(old_payload);
+    if (result) {
+        memcpy(old_payload, json_str, len + 1);
+    }
+    cJSON_Delete(alert);
+    cJSON_free(json_str);
+
+    old_request_len = snprintf(old_request, sizeof(old_request),
+             "POST %s HTTP/1.1\r\n"
+             "Host: %s\r\n"
+             "Content-Type: application/json\r\n"
+             "Content-Length: %u\r\n"
+             "Connection: keep-alive\r\n"
+             "\r\n"
+             "%s",
+             config.api_url, config.api_host, (unsigned)strlen(old_payload), old_payload);
+    return result;
+}
+
+static bool new_send_alert(int temperatura, int temp_max, int temp_min) {
+    // Sem o sender rodando, a fila é esvaziada aqui para que cada alerta use uma entrada livre
+    alert_queue.count = 0;
+    return send_alert_json(&config, DEVICE_ID, temperatura, temp_max, temp_min);
+}
+
+/**
+ * @brief Lê um campo numérico de um JSON
+ */
+static int json_int_field(const char *json, size_t len, const char *key) {
+    cJSON *root = cJSON_ParseWithLength(json, len);
+    TEST_ASSERT_NOT_NULL_MESSAGE(root, json);
+    cJSON *item = cJSON_GetObjectItem(root, key);
+    TEST_ASSERT_NOT_NULL_MESSAGE(item, key);
+    int value = item->valueint;
+    cJSON_Delete(root);
+    return value;
+}
+
+static uint64_t cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+typedef struct {
+    double ns;
+    double cycles;
+    double bytes;
+    double allocations;
+} cost_t;
+
+/**
+ * @brief Custo médio por alerta no computador, com as alocações contadas pelos hooks do cJSON
+ */
+static cost_t measure(bool (*send)(int, int, int)) {
+    allocated_bytes = 0;
+    allocations = 0;
+
+    clock_t start = clock();
+    uint64_t start_cycles = cycles();
+    for (uint32_t n = 0; n < ROUNDS; n++) {
+        TEST_ASSERT_TRUE(send(20 + n % 30, 32, -8));
+    }
+    uint64_t end_cycles = cycles();
+    clock_t end = clock();
+
+    cost_t cost = {
+        .ns = (double)(end - start) * 1e9 / CLOCKS_PER_SEC / ROUNDS,
+        .cycles = (double)(end_cycles - start_cycles) / ROUNDS,
+        .bytes = (double)allocated_bytes / ROUNDS,
+        .allocations = (double)allocations / ROUNDS,
+    };
+    return cost;
+}
+
+void setUp(void) {
+    alert_queue.count = 0;
+}
+
+void tearDown(void) {
+    alert_queue.count = 0;
+}
+
+static void both_paths_should_send_the_same_alert(void) {
+    TEST_ASSERT_TRUE(old_send_alert(41, 32, -8));
+    TEST_ASSERT_TRUE(new_send_alert(41, 32, -8));
+    alert_entry_t *entry = alert_queue_at(0);
+
+    // Mesmo cabeçalho até o Content-Length, cada um com o tamanho do próprio corpo
+    const char *old_body = strstr(old_request, "\r\n\r\n") + 4;
+    TEST_ASSERT_EQUAL_UINT32(strlen(old_payload), (uint32_t)(old_request_len - (old_body - old_request)));
+    TEST_ASSERT_EQUAL_STRING_LEN(old_request, entry->head, strlen("POST /alert HTTP/1.1\r\n"));
+    char length[32];
+    snprintf(length, sizeof(length), "Content-Length: %u", entry->body_len);
+    TEST_ASSERT_NOT_NULL(strstr(entry->head, length));
+
+    // O corpo antigo era formatado com espaços; os campos são os mesmos
+    static const char *const keys[] = { "temperature", "maxTemperature", "minTemperature" };
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+        TEST_ASSERT_EQUAL_INT(json_int_field(old_body, strlen(old_body), keys[i]),
+                              json_int_field(entry->body, entry->body_len, keys[i]));
+    }
+    TEST_ASSERT_LESS_THAN_UINT32(strlen(old_payload), entry->body_len);
+}
+
+static void serialize_cost(void) {
+    cost_t old_cost = measure(old_send_alert);
+    cost_t new_cost = measure(new_send_alert);
+
+    printf("cJSON, cJSON_Print e snprintf: %7.1f ns, %7.0f ciclos, %5.1f alocações e %6.1f bytes por alerta\n",
+           old_cost.ns, old_cost.cycles, old_cost.allocations, old_cost.bytes);
+    printf("json_writer na fila:          %7.1f ns, %7.0f ciclos, %5.1f alocações e %6.1f bytes por alerta\n",
+           new_cost.ns, new_cost.cycles, new_cost.allocations, new_cost.bytes);
+
+    // O caminho novo não passa pelo heap
+    TEST_ASSERT_GREATER_THAN(0, old_cost.allocations);
+    TEST_ASSERT_EQUAL(0, new_cost.allocations);
+}
+
+int main(void) {
+    cJSON_Hooks hooks = { counting_malloc, free };
+    cJSON_InitHooks(&hooks);
+
+    UNITY_BEGIN();
+    RUN_TEST(both_paths_should_send_the_same_alert);
+    RUN_TEST(serialize_cost);
+    return UNITY_END();
+}
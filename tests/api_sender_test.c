@@ -0,0 +1,457 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "utils/connection_manager.h"
+#include "utils/telemetry.h"
+#include "stub_server.h"
+
+#define DEVICE_ID "e6614103e7a2b534"
+#define LOOP_SLEEP_US 2000                              // Espera entre iterações do loop, o sleep_ms(100) do firmware
+#define SERVER_DELAY_MS 200                             // Tempo de resposta do servidor lento
+#define RUN_TIMEOUT_MS 5000
+#define DEFAULT_TCP_SND_BUF (8 * 1460)                  // TCP_SND_BUF do lwipopts.h
+
+static wifi_config_t config = {
+    .ssid = "rede",
+    .senha = "senha",
+    .api_host = "127.0.0.1",
+    .api_url = "/alert",
+    .telemetry_url = "/telemetry"
+};
+
+static uint64_t last_real_us;
+static double work_max_us, work_total_us;             // Tempo gasto pelo loop em cada iteração
+static uint32_t iterations;
+
+static uint64_t real_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief Uma iteração do loop principal, com a parte de rede do firmware. O relógio simulado
+ * acompanha o tempo real, para que os prazos do envio valham em relação ao servidor
+ */
+static void loop_iteration(void) {
+    uint64_t start = real_us();
+    mock_time_advance_us(start - last_real_us);
+    last_real_us = start;
+
+    mock_lwip_poll();                                   // Interrupções do cyw43
+    telemetry_poll(&config, DEVICE_ID);
+    alert_sender_poll(&config);
+
+    double work = (double)(real_us() - start);
+    work_total_us += work;
+    if (work > work_max_us) {
+        work_max_us = work;
+    }
+    iterations++;
+
+    struct timespec pause = { 0, LOOP_SLEEP_US * 1000L };
+    nanosleep(&pause, NULL);
+}
+
+/**
+ * @brief Roda o loop até a condição ser atendida ou o tempo real esgotar
+ */
+static bool run_until(bool (*done)(void), uint32_t timeout_ms) {
+    uint64_t end = real_us() + (uint64_t)timeout_ms * 1000;
+
+    while (!done()) {
+        if (real_us() > end) {
+            return false;
+        }
+        loop_iteration();
+    }
+    return true;
+}
+
+static bool queue_empty(void) {
+    return !alert_sender_pending() && sender.state != SENDER_WAITING_RESPONSE;
+}
+
+static uint32_t expected_requests;
+static bool server_got_expected(void) {
+    return stub_server_requests() >= expected_requests;
+}
+
+/**
+ * @brief Lê um campo numérico do corpo JSON de uma requisição recebida pelo servidor
+ */
+static int body_int(const stub_request_t *req, const char *key) {
+    cJSON *json = cJSON_ParseWithLength(req->body, req->body_len);
+    TEST_ASSERT_NOT_NULL_MESSAGE(json, req->body);
+    cJSON *item = cJSON_GetObjectItem(json, key);
+    TEST_ASSERT_NOT_NULL_MESSAGE(item, key);
+    int value = item->valueint;
+    cJSON_Delete(json);
+    return value;
+}
+
+void setUp(void) {
+    stub_config_t normal = { 0 };
+    stub_server_configure(&normal);
+    work_max_us = work_total_us = 0;
+    iterations = 0;
+    last_real_us = real_us();
+}
+
+void tearDown(void) {
+    stub_config_t normal = { 0 };
+    stub_server_configure(&normal);
+    mock_wifi_link = CYW43_LINK_UP;
+    mock_tcp_snd_buf = DEFAULT_TCP_SND_BUF;
+    mock_tcp_send_limit = 0;
+    // Esgota um eventual backoff e entrega o que ficou na fila
+    mock_time_advance_us((uint64_t)ALERT_RETRY_MAX_MS * 1000);
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+}
+
+static void alerts_should_reach_server(void) {
+    uint32_t connections = stub_server_connections();
+
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 40 + i, 32, -8));
+    }
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+
+    TEST_ASSERT_EQUAL_UINT32(3, stub_server_requests());
+    for (uint32_t i = 0; i < 3; i++) {
+        stub_request_t req;
+        TEST_ASSERT_TRUE(stub_server_request(i, &req));
+        TEST_ASSERT_EQUAL_STRING("/alert", req.path);
+        TEST_ASSERT_EQUAL_UINT32(req.content_length, req.body_len);
+        TEST_ASSERT_EQUAL_INT(40 + (int)i, body_int(&req, "temperature"));
+    }
+
+    // As três requisições seguem na mesma conexão
+    TEST_ASSERT_EQUAL_UINT32(connections + 1, stub_server_connections());
+}
+
+static void main_loop_should_not_wait_for_server(void) {
+    stub_config_t slow = { .delay_ms = SERVER_DELAY_MS };
+    stub_server_configure(&slow);
+
+    uint64_t start = real_us();
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 40 + i, 32, -8));
+        loop_iteration();
+    }
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+    double elapsed_ms = (real_us() - start) / 1000.0;
+
+    printf("%u iterações em %.0f ms com 4 alertas e respostas de %d ms: média %.1f us, máximo %.1f us por iteração\n",
+           iterations, elapsed_ms, SERVER_DELAY_MS, work_total_us / iterations, work_max_us);
+
+    // O loop continuou girando durante as respostas, sem nenhuma iteração presa esperando o servidor
+    TEST_ASSERT_EQUAL_UINT32(4, stub_server_requests());
+    TEST_ASSERT_GREATER_OR_EQUAL(SERVER_DELAY_MS, (uint32_t)elapsed_ms);
+    TEST_ASSERT_GREATER_THAN_UINT32(SERVER_DELAY_MS * 1000 / (LOOP_SLEEP_US * 4), iterations);
+    TEST_ASSERT_LESS_THAN(SERVER_DELAY_MS * 1000 / 10, (uint32_t)work_max_us);
+}
+
+static void silent_server_should_time_out_and_retry(void) {
+    stub_config_t silent = { .silent = true };
+    stub_server_configure(&silent);
+
+    TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 45, 32, -8));
+    expected_requests = 1;
+    TEST_ASSERT_TRUE(run_until(server_got_expected, RUN_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL(SENDER_WAITING_RESPONSE, sender.state);
+
+    // Prazo esgotado: a conexão é abortada e o alerta aguarda o backoff na fila
+    mock_time_advance_us((uint64_t)ALERT_REQUEST_TIMEOUT_MS * 1000);
+    loop_iteration();
+    TEST_ASSERT_EQUAL(SENDER_IDLE, sender.state);
+    TEST_ASSERT_EQUAL_INT(0, mock_tcp_open_pcbs());
+    TEST_ASSERT_TRUE(alert_sender_pending());
+    TEST_ASSERT_EQUAL_UINT8(1, alert_queue_at(0)->attempts);
+
+    // Antes do backoff nada é reenviado
+    stub_config_t normal = { 0 };
+    stub_server_configure(&normal);
+    for (int i = 0; i < 10; i++) {
+        loop_iteration();
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, stub_server_requests());
+
+    mock_time_advance_us((uint64_t)ALERT_RETRY_BASE_MS * 1000);
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+    stub_request_t req;
+    TEST_ASSERT_TRUE(stub_server_request(0, &req));
+    TEST_ASSERT_EQUAL_INT(45, body_int(&req, "temperature"));
+}
+
+static void closed_connections_should_be_reopened(void) {
+    stub_config_t closing = { .close_after_response = true };
+    stub_server_configure(&closing);
+    uint32_t connections = stub_server_connections();
+
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 40 + i, 32, -8));
+    }
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+
+    // Cada resposta fecha a conexão; as requisições que iam na mesma conexão são reenviadas em outra.
+    // A primeira segue na conexão que o teste anterior deixou aberta
+    TEST_ASSERT_EQUAL_UINT32(3, stub_server_requests());
+    TEST_ASSERT_EQUAL_UINT32(connections + 2, stub_server_connections());
+}
+
+static void alerts_should_wait_for_wifi(void) {
+    mock_wifi_link = CYW43_LINK_DOWN;
+    uint32_t attempts = mock_wifi_connect_attempts;
+
+    TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 41, 32, -8));
+    for (int i = 0; i < 20; i++) {
+        loop_iteration();
+    }
+    TEST_ASSERT_TRUE(alert_sender_pending());
+    TEST_ASSERT_EQUAL_UINT32(0, stub_server_requests());
+    // Reconexão iniciada uma vez a cada WIFI_RECONNECT_INTERVAL_MS, sem bloquear
+    TEST_ASSERT_UINT32_WITHIN(1, attempts + 1, mock_wifi_connect_attempts);
+
+    mock_wifi_link = CYW43_LINK_UP;
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, stub_server_requests());
+}
+
+static void only_config_limits_should_be_applied(void) {
+    static const struct {
+        const char *body;
+        bool applied;
+        int max, min;
+    } cases[] = {
+        { "{\"config\":{\"maxTemperature\":30,\"minTemperature\":-5}}", true, 30, -5 },
+        // Eco do alerta: as chaves do objeto principal são as que o dispositivo envia
+        { "{\"deviceId\":\"" DEVICE_ID "\",\"temperature\":45,\"maxTemperature\":10,\"minTemperature\":5}", false, 0, 0 },
+        { "{\"data\":{\"config\":{\"maxTemperature\":30,\"minTemperature\":-5}}}", false, 0, 0 },
+        { "{\"config\":[{\"maxTemperature\":30,\"minTemperature\":-5}]}", false, 0, 0 },
+        { "{\"config\":{\"maxTemperature\":30},\"minTemperature\":-5}", false, 0, 0 },
+        { "{\"config\":{\"maxTemperature\":10,\"minTemperature\":20}}", false, 0, 0 },
+        { "{\"config\":{\"maxTemperature\":60,\"minTemperature\":-5}}", false, 0, 0 },
+        { "{\"config\":{\"limits\":{\"maxTemperature\":30}},\"maxTemperature\":28,\"minTemperature\":-2}", false, 0, 0 },
+    };
+
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        stub_config_t replying = { .body = cases[k].body };
+        stub_server_configure(&replying);
+
+        TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 45, 32, -8));
+        TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+
+        int temp_max = 32, temp_min = -8;
+        TEST_ASSERT_EQUAL_MESSAGE(cases[k].applied, api_take_remote_limits(&temp_max, &temp_min), cases[k].body);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(cases[k].applied ? cases[k].max : 32, temp_max, cases[k].body);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(cases[k].applied ? cases[k].min : -8, temp_min, cases[k].body);
+        // Os limites são entregues uma vez só
+        TEST_ASSERT_FALSE(api_take_remote_limits(&temp_max, &temp_min));
+    }
+}
+
+/**
+ * @brief Derruba o link wifi junto com a conexão que os testes anteriores deixaram aberta
+ */
+static void wifi_down(void) {
+    mock_wifi_link = CYW43_LINK_DOWN;
+    mock_tcp_reset_all();
+    TEST_ASSERT_EQUAL(SENDER_IDLE, sender.state);
+}
+
+/**
+ * @brief Registra leituras suficientes para lotes completos e espera que entrem na fila sem conexão
+ */
+static void queue_telemetry_batches(uint8_t batches) {
+    uint8_t queued = alert_queue.count;
+
+    for (int i = 0; i < batches * TELEMETRY_BATCH_SIZE; i++) {
+        telemetry_record(20 + i % 10);
+    }
+    for (int i = 0; i < 10 * batches && alert_queue.count < queued + batches; i++) {
+        loop_iteration();
+    }
+    TEST_ASSERT_EQUAL_UINT8(queued + batches, alert_queue.count);
+}
+
+static void alerts_should_jump_ahead_of_telemetry(void) {
+    wifi_down();
+    queue_telemetry_batches(3);
+    TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 46, 32, -8));
+    TEST_ASSERT_EQUAL(MESSAGE_ALERT, alert_queue_at(0)->kind);
+
+    mock_wifi_link = CYW43_LINK_UP;
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+
+    TEST_ASSERT_EQUAL_UINT32(4, stub_server_requests());
+    for (uint32_t i = 0; i < 4; i++) {
+        stub_request_t req;
+        TEST_ASSERT_TRUE(stub_server_request(i, &req));
+        TEST_ASSERT_EQUAL_STRING(i == 0 ? "/alert" : "/telemetry", req.path);
+    }
+}
+
+static void failed_telemetry_should_wait_behind_alerts(void) {
+    stub_config_t silent = { .silent = true };
+    stub_server_configure(&silent);
+
+    // O lote já está sendo enviado quando o alerta chega: o alerta vai logo atrás dele
+    for (int i = 0; i < TELEMETRY_BATCH_SIZE; i++) {
+        telemetry_record(25);
+    }
+    expected_requests = 1;
+    TEST_ASSERT_TRUE(run_until(server_got_expected, RUN_TIMEOUT_MS));
+    TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 47, 32, -8));
+    TEST_ASSERT_EQUAL(MESSAGE_TELEMETRY, alert_queue_at(0)->kind);
+    TEST_ASSERT_EQUAL(MESSAGE_ALERT, alert_queue_at(1)->kind);
+
+    // Sem resposta, o lote que falhou volta para trás do alerta
+    mock_time_advance_us((uint64_t)ALERT_REQUEST_TIMEOUT_MS * 1000);
+    loop_iteration();
+    TEST_ASSERT_EQUAL(SENDER_IDLE, sender.state);
+    TEST_ASSERT_EQUAL(MESSAGE_ALERT, alert_queue_at(0)->kind);
+    TEST_ASSERT_EQUAL(MESSAGE_TELEMETRY, alert_queue_at(1)->kind);
+    TEST_ASSERT_EQUAL_UINT8(1, alert_queue_at(1)->attempts);
+
+    stub_config_t normal = { 0 };
+    stub_server_configure(&normal);
+    mock_time_advance_us((uint64_t)ALERT_RETRY_BASE_MS * 1000);
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+
+    stub_request_t req;
+    TEST_ASSERT_EQUAL_UINT32(2, stub_server_requests());
+    TEST_ASSERT_TRUE(stub_server_request(0, &req));
+    TEST_ASSERT_EQUAL_STRING("/alert", req.path);
+    TEST_ASSERT_TRUE(stub_server_request(1, &req));
+    TEST_ASSERT_EQUAL_STRING("/telemetry", req.path);
+}
+
+static void full_queue_should_drop_telemetry_first(void) {
+    wifi_down();
+    uint32_t dropped = alert_queue.dropped;
+
+    // O telemetry_poll deixa espaço para dois alertas; o terceiro descarta o lote mais antigo
+    queue_telemetry_batches(ALERT_QUEUE_SIZE - 2);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 40 + i, 32, -8));
+    }
+    TEST_ASSERT_EQUAL_UINT8(ALERT_QUEUE_SIZE, alert_queue.count);
+    TEST_ASSERT_EQUAL_UINT32(dropped + 1, alert_queue.dropped);
+    for (uint8_t i = 0; i < ALERT_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL(i < 3 ? MESSAGE_ALERT : MESSAGE_TELEMETRY, alert_queue_at(i)->kind);
+    }
+
+    // Com a fila cheia de alertas, um lote não entra no lugar de nenhum
+    for (int i = 3; i < ALERT_QUEUE_SIZE + 3; i++) {
+        TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 40 + i, 32, -8));
+    }
+    json_writer_t w;
+    api_message_begin(&w, &config, MESSAGE_TELEMETRY);
+    json_begin_object(&w);
+    json_end_object(&w);
+    TEST_ASSERT_FALSE(api_message_end(&w));
+    for (uint8_t i = 0; i < ALERT_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL(MESSAGE_ALERT, alert_queue_at(i)->kind);
+    }
+
+    mock_wifi_link = CYW43_LINK_UP;
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+    stub_request_t req;
+    TEST_ASSERT_EQUAL_UINT32(ALERT_QUEUE_SIZE, stub_server_requests());
+    TEST_ASSERT_TRUE(stub_server_request(0, &req));
+    TEST_ASSERT_EQUAL_INT(40 + 3, body_int(&req, "temperature"));
+}
+
+static void requests_should_stream_through_small_send_buffer(void) {
+    // Com o TCP_SND_BUF do firmware uma entrada sempre cabe inteira; aqui cada requisição
+    // é entregue ao lwIP em partes, conforme o buffer esvazia
+    mock_tcp_snd_buf = 200;
+    mock_tcp_send_limit = 64;
+
+    for (int i = 0; i < TELEMETRY_BATCH_SIZE; i++) {
+        telemetry_record(-10 + i);
+    }
+    loop_iteration();
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 40 + i, 32, -8));
+    }
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+
+    TEST_ASSERT_EQUAL_UINT32(3, stub_server_requests());
+    bool batch_seen = false;
+    for (uint32_t n = 0; n < 3; n++) {
+        stub_request_t req;
+        TEST_ASSERT_TRUE(stub_server_request(n, &req));
+        TEST_ASSERT_EQUAL_UINT32(req.content_length, req.body_len);
+
+        cJSON *json = cJSON_ParseWithLength(req.body, req.body_len);
+        TEST_ASSERT_NOT_NULL_MESSAGE(json, req.body);
+        if (strcmp(req.path, "/telemetry") == 0) {
+            cJSON *samples = cJSON_GetObjectItem(json, "samples");
+            TEST_ASSERT_GREATER_THAN_UINT32(mock_tcp_snd_buf, req.body_len);
+            TEST_ASSERT_EQUAL_INT(TELEMETRY_BATCH_SIZE, cJSON_GetArraySize(samples));
+            for (int i = 0; i < TELEMETRY_BATCH_SIZE; i++) {
+                TEST_ASSERT_EQUAL_INT(-10 + i, cJSON_GetArrayItem(cJSON_GetArrayItem(samples, i), 1)->valueint);
+            }
+            batch_seen = true;
+        }
+        cJSON_Delete(json);
+    }
+    TEST_ASSERT_TRUE(batch_seen);
+}
+
+static void oversized_message_should_not_evict(void) {
+    wifi_down();
+    uint32_t dropped = alert_queue.dropped;
+
+    for (int i = 0; i < ALERT_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(send_alert_json(&config, DEVICE_ID, 40 + i, 32, -8));
+    }
+
+    // Corpo maior que uma entrada: recusado antes de descartar qualquer alerta da fila cheia
+    json_writer_t w;
+    api_message_begin(&w, &config, MESSAGE_ALERT);
+    json_begin_array(&w);
+    for (int i = 0; i < API_BODY_MAX; i++) {
+        json_int(&w, i);
+    }
+    json_end_array(&w);
+    TEST_ASSERT_FALSE(api_message_end(&w));
+    TEST_ASSERT_EQUAL_UINT8(ALERT_QUEUE_SIZE, alert_queue.count);
+    TEST_ASSERT_EQUAL_UINT32(dropped, alert_queue.dropped);
+
+    mock_wifi_link = CYW43_LINK_UP;
+    TEST_ASSERT_TRUE(run_until(queue_empty, RUN_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_UINT32(ALERT_QUEUE_SIZE, stub_server_requests());
+    for (uint32_t i = 0; i < ALERT_QUEUE_SIZE; i++) {
+        stub_request_t req;
+        TEST_ASSERT_TRUE(stub_server_request(i, &req));
+        TEST_ASSERT_EQUAL_INT(40 + (int)i, body_int(&req, "temperature"));
+    }
+}
+
+int main(void) {
+    config.api_port = stub_server_start();
+
+    UNITY_BEGIN();
+    RUN_TEST(alerts_should_reach_server);
+    RUN_TEST(main_loop_should_not_wait_for_server);
+    RUN_TEST(silent_server_should_time_out_and_retry);
+    RUN_TEST(closed_connections_should_be_reopened);
+    RUN_TEST(alerts_should_wait_for_wifi);
+    RUN_TEST(only_config_limits_should_be_applied);
+    RUN_TEST(alerts_should_jump_ahead_of_telemetry);
+    RUN_TEST(failed_telemetry_should_wait_behind_alerts);
+    RUN_TEST(full_queue_should_drop_telemetry_first);
+    RUN_TEST(requests_should_stream_through_small_send_buffer);
+    RUN_TEST(oversized_message_should_not_evict);
+    int result = UNITY_END();
+
+    stub_server_stop();
+    return result;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "utils/dashboard.h"
+
+static uint8_t live_buffer[128 * 8];
+static uint8_t full_buffer[128 * 8];
+static ssd1306_t live = { .width = 128, .height = 64, .pages = 8, .buffer = live_buffer, .bufsize = sizeof(live_buffer) };
+static ssd1306_t full = { .width = 128, .height = 64, .pages = 8, .buffer = full_buffer, .bufsize = sizeof(full_buffer) };
+
+static dashboard_t dash;
+
+/**
+ * @brief Confere o quadro desenhado aos poucos contra o mesmo painel desenhado do zero
+ */
+static void assert_matches_full_redraw(int temperature, int temp_min, int temp_max) {
+    dashboard_t copy = dash;
+
+    dashboard_invalidate(&copy);
+    ssd1306_clear(&full);
+    dashboard_render(&copy, &full, temperature, temp_min, temp_max);
+    for (uint32_t page = 0; page < full.pages; page++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(full.buffer + page * full.width, live.buffer + page * live.width, full.width);
+    }
+}
+
+void setUp(void) {
+    memset(&dash, 0, sizeof(dash));
+    ssd1306_clear(&live);
+}
+
+void tearDown(void) {
+}
+
+static void assert_format(int temperature, uint8_t a, uint8_t b, uint8_t c) {
+    uint8_t segments[DASHBOARD_DIGITS];
+    uint8_t expected[DASHBOARD_DIGITS] = { a, b, c };
+
+    dashboard_format(temperature, segments);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, segments, DASHBOARD_DIGITS);
+}
+
+static void temperatures_should_be_right_aligned(void) {
+    const uint8_t *d = dashboard_digit_segments;
+
+    assert_format(0, 0, 0, d[0]);
+    assert_format(25, 0, d[2], d[5]);
+    assert_format(-8, 0, SEGMENTS_MINUS, d[8]);
+    assert_format(-12, SEGMENTS_MINUS, d[1], d[2]);
+    assert_format(100, d[1], d[0], d[0]);
+    assert_format(-100, SEGMENTS_MINUS, SEGMENTS_MINUS, SEGMENTS_MINUS);
+    assert_format(1000, SEGMENTS_MINUS, SEGMENTS_MINUS, SEGMENTS_MINUS);
+}
+
+static void digit_change_should_touch_only_its_position(void) {
+    uint8_t before[sizeof(live_buffer)];
+
+    dashboard_render(&dash, &live, 25, -8, 32);
+    memcpy(before, live_buffer, sizeof(before));
+
+    TEST_ASSERT_TRUE(dashboard_render(&dash, &live, 26, -8, 32));
+    for (uint32_t page = 0; page < live.pages; page++) {
+        for (uint32_t x = 0; x < live.width; x++) {
+            uint32_t i = page * live.width + x;
+            bool last_digit = x >= DASHBOARD_DIGIT_X + 2 * DASHBOARD_DIGIT_STEP
+                              && x < DASHBOARD_DIGIT_X + 2 * DASHBOARD_DIGIT_STEP + DASHBOARD_DIGIT_WIDTH;
+            if (!last_digit) {
+                TEST_ASSERT_EQUAL_UINT8(before[i], live_buffer[i]);
+            }
+        }
+    }
+    assert_matches_full_redraw(26, -8, 32);
+
+    // Nada mudou: nada é desenhado
+    TEST_ASSERT_FALSE(dashboard_render(&dash, &live, 26, -8, 32));
+}
+
+static void graph_should_shift_one_column_per_sample(void) {
+    for (int i = 0; i < 40; i++) {
+        dashboard_record(&dash, 20 + i % 5);
+    }
+    dashboard_render(&dash, &live, 24, -8, 32);
+
+    uint8_t before[sizeof(live_buffer)];
+    memcpy(before, live_buffer, sizeof(before));
+
+    dashboard_record(&dash, 30);
+    dashboard_render(&dash, &live, 30, -8, 32);
+
+    // Exceto a nova coluna, o gráfico é o anterior deslocado uma coluna para a esquerda
+    for (uint32_t page = DASHBOARD_GRAPH_PAGE; page < live.pages; page++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(before + page * live.width + 1, live_buffer + page * live.width, live.width - 1);
+    }
+    assert_matches_full_redraw(30, -8, 32);
+}
+
+static void incremental_graph_should_match_full_redraw(void) {
+    int temperature = 20, temp_min = -8, temp_max = 32;
+
+    srand(42);
+    for (int frame = 0; frame < 2000; frame++) {
+        // Às vezes nenhuma leitura entre quadros, às vezes várias, às vezes mais que a largura do gráfico
+        int samples = rand() % 8 == 0 ? 0 : rand() % 50 == 0 ? 130 + rand() % 200 : 1 + rand() % 3;
+        for (int i = 0; i < samples; i++) {
+            temperature += rand() % 5 - 2;
+            if (temperature < -40) temperature = -40;
+            if (temperature > 80) temperature = 80;
+            dashboard_record(&dash, temperature);
+        }
+
+        // Novos limites mudam a escala e redesenham o gráfico
+        if (rand() % 100 == 0) {
+            temp_min = -20 + rand() % 30;
+            temp_max = temp_min + 2 + rand() % 40;
+        }
+
+        dashboard_render(&dash, &live, temperature, temp_min, temp_max);
+        assert_matches_full_redraw(temperature, temp_min, temp_max);
+    }
+}
+
+static void render_cost(void) {
+    const int rounds = 20000;
+    int temperature = 20;
+
+    for (int i = 0; i < DASHBOARD_SAMPLES; i++) {
+        dashboard_record(&dash, temperature);
+    }
+    dashboard_render(&dash, &live, temperature, -8, 32);
+
+    clock_t start = clock();
+    for (int i = 0; i < rounds; i++) {
+        temperature = 20 + i % 10;
+        dashboard_record(&dash, temperature);
+        dashboard_render(&dash, &live, temperature, -8, 32);
+    }
+    double us = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC / rounds;
+
+    printf("painel: %.2f us por leitura no computador\n", us);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(temperatures_should_be_right_aligned);
+    RUN_TEST(digit_change_should_touch_only_its_position);
+    RUN_TEST(graph_should_shift_one_column_per_sample);
+    RUN_TEST(incremental_graph_should_match_full_redraw);
+    RUN_TEST(render_cost);
+    return UNITY_END();
+}
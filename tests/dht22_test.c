@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "utils/dht22_funcs.h"
+
+#define DHT_PIN 8
+
+// Larguras dos pulsos altos capturadas do sensor, em microssegundos: resposta de ~80 us,
+// bits 0 de ~26 us e bits 1 de ~70 us
+
+// Umidade 55,2%, temperatura 23,4 °C
+static const uint32_t trace_23_4[DHT22_PULSE_COUNT] = {
+    80, 24, 26, 28, 23, 23, 29, 72, 23, 25, 27, 68, 27, 69, 23, 23, 26, 26, 23, 24, 23,
+    27, 26, 23, 29, 72, 68, 69, 28, 73, 27, 68, 27, 27, 26, 23, 69, 23, 72, 29, 24
+};
+
+// Umidade 40,0%, temperatura -1,0 °C
+static const uint32_t trace_minus_1_0[DHT22_PULSE_COUNT] = {
+    80, 26, 24, 27, 23, 27, 25, 27, 74, 73, 24, 23, 72, 27, 28, 24, 25, 68, 27, 28, 23,
+    27, 23, 27, 24, 26, 28, 27, 26, 74, 25, 71, 27, 26, 25, 25, 69, 74, 24, 73, 74
+};
+
+// Umidade 81,5%, temperatura -12,7 °C
+static const uint32_t trace_minus_12_7[DHT22_PULSE_COUNT] = {
+    79, 23, 27, 25, 27, 26, 25, 73, 71, 25, 27, 68, 23, 72, 71, 69, 74, 70, 24, 26, 26,
+    23, 28, 23, 29, 27, 72, 74, 74, 70, 70, 73, 70, 27, 26, 72, 74, 26, 23, 29, 68
+};
+
+// A mesma leitura de 23,4 °C com o último bit do checksum trocado por ruído na linha
+static const uint32_t trace_bad_checksum[DHT22_PULSE_COUNT] = {
+    80, 26, 28, 28, 23, 23, 28, 73, 25, 28, 27, 73, 29, 71, 25, 28, 26, 28, 25, 23, 26,
+    25, 24, 27, 23, 71, 68, 69, 29, 70, 24, 73, 24, 26, 26, 29, 71, 23, 69, 26, 71
+};
+
+/**
+ * @brief Inicia uma leitura e entrega ao state machine simulado as primeiras larguras do traço
+ */
+static void capture(const uint32_t *trace, size_t count) {
+    mock_time_advance_us(DHT22_MIN_INTERVAL_US);
+    TEST_ASSERT_TRUE(dht22_start());
+    for (size_t i = 0; i < count; i++) {
+        mock_pio_rx_push(dht22.pio, dht22.sm, trace[i]);
+    }
+    mock_dma_finish();
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+    // Descarta uma leitura que tenha ficado pela metade
+    mock_time_advance_us(DHT22_READ_TIMEOUT_US);
+    int temperature;
+    dht22_poll(&temperature);
+}
+
+static void decode_should_read_positive_temperature(void) {
+    int temperature = 0;
+
+    TEST_ASSERT_EQUAL(DHT22_OK, dht22_decode(trace_23_4, DHT22_PULSE_COUNT, &temperature));
+    TEST_ASSERT_EQUAL_INT(23, temperature);
+}
+
+static void decode_should_read_negative_temperatures(void) {
+    int temperature = 0;
+
+    TEST_ASSERT_EQUAL(DHT22_OK, dht22_decode(trace_minus_1_0, DHT22_PULSE_COUNT, &temperature));
+    TEST_ASSERT_EQUAL_INT(-1, temperature);
+
+    TEST_ASSERT_EQUAL(DHT22_OK, dht22_decode(trace_minus_12_7, DHT22_PULSE_COUNT, &temperature));
+    TEST_ASSERT_EQUAL_INT(-12, temperature);
+}
+
+static void decode_should_reject_bad_checksum(void) {
+    int temperature = 99;
+
+    TEST_ASSERT_EQUAL(DHT22_ERROR_CHECKSUM, dht22_decode(trace_bad_checksum, DHT22_PULSE_COUNT, &temperature));
+    TEST_ASSERT_EQUAL_INT(99, temperature);
+}
+
+static void decode_should_reject_short_capture(void) {
+    int temperature = 99;
+
+    TEST_ASSERT_EQUAL(DHT22_ERROR_TIMEOUT, dht22_decode(trace_23_4, DHT22_PULSE_COUNT - 8, &temperature));
+    TEST_ASSERT_EQUAL_INT(99, temperature);
+}
+
+static void poll_should_report_minus_one_as_reading(void) {
+    int temperature = 0;
+
+    capture(trace_minus_1_0, DHT22_PULSE_COUNT);
+    TEST_ASSERT_EQUAL(DHT22_OK, dht22_poll(&temperature));
+    TEST_ASSERT_EQUAL_INT(-1, temperature);
+    TEST_ASSERT_EQUAL(DHT22_IDLE, dht22_poll(&temperature));
+}
+
+static void poll_should_keep_temperature_on_errors(void) {
+    int temperature = 0;
+
+    capture(trace_23_4, DHT22_PULSE_COUNT);
+    TEST_ASSERT_EQUAL(DHT22_OK, dht22_poll(&temperature));
+    TEST_ASSERT_EQUAL_INT(23, temperature);
+
+    capture(trace_bad_checksum, DHT22_PULSE_COUNT);
+    TEST_ASSERT_EQUAL(DHT22_ERROR_CHECKSUM, dht22_poll(&temperature));
+    TEST_ASSERT_EQUAL_INT(23, temperature);
+
+    // O sensor para de responder no meio da leitura: o DMA espera até o prazo
+    capture(trace_minus_12_7, 20);
+    TEST_ASSERT_EQUAL(DHT22_BUSY, dht22_poll(&temperature));
+    mock_time_advance_us(DHT22_READ_TIMEOUT_US);
+    TEST_ASSERT_EQUAL(DHT22_ERROR_TIMEOUT, dht22_poll(&temperature));
+    TEST_ASSERT_EQUAL_INT(23, temperature);
+
+    // A leitura seguinte não é afetada pelos pulsos da leitura interrompida
+    capture(trace_minus_12_7, DHT22_PULSE_COUNT);
+    TEST_ASSERT_EQUAL(DHT22_OK, dht22_poll(&temperature));
+    TEST_ASSERT_EQUAL_INT(-12, temperature);
+}
+
+static void start_should_respect_min_interval(void) {
+    int temperature = 0;
+
+    capture(trace_23_4, DHT22_PULSE_COUNT);
+    TEST_ASSERT_EQUAL(DHT22_OK, dht22_poll(&temperature));
+    TEST_ASSERT_FALSE(dht22_start());
+    mock_time_advance_us(DHT22_MIN_INTERVAL_US);
+    TEST_ASSERT_TRUE(dht22_start());
+    TEST_ASSERT_FALSE(dht22_start());
+}
+
+int main(void) {
+    dht22_init(pio1, DHT_PIN);
+
+    UNITY_BEGIN();
+    RUN_TEST(decode_should_read_positive_temperature);
+    RUN_TEST(decode_should_read_negative_temperatures);
+    RUN_TEST(decode_should_reject_bad_checksum);
+    RUN_TEST(decode_should_reject_short_capture);
+    RUN_TEST(poll_should_report_minus_one_as_reading);
+    RUN_TEST(poll_should_keep_temperature_on_errors);
+    RUN_TEST(start_should_respect_min_interval);
+    return UNITY_END();
+}
@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "hardware/dma.h"
+#include "utils/display_funcs.h"
+
+static uint32_t report_bytes(const char *frame, uint32_t before) {
+    mock_dma_finish();
+    uint32_t bytes = mock_i2c.bytes - before;
+    printf("%-32s %5lu bytes no barramento\n", frame, (unsigned long)bytes);
+    return bytes;
+}
+
+/**
+ * @brief Envia o quadro atual e retorna os bytes que passaram pelo barramento
+ */
+static uint32_t commit_bytes(const char *frame) {
+    uint32_t before = mock_i2c.bytes;
+    oled_commit();
+    return report_bytes(frame, before);
+}
+
+/**
+ * @brief Termina o envio em andamento e confere se a RAM do display simulado é igual ao buffer desenhado
+ */
+static void assert_panel_matches(void) {
+    mock_dma_finish();
+    for (uint32_t page = 0; page < display.pages; page++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(display.buffer + page * display.width, mock_i2c.ram[page], display.width);
+    }
+}
+
+static void draw_monitoring_frame(int temperature, int temp_min, int temp_max) {
+    char buffer[30];
+
+    sprintf(buffer, "Temperatura: %d graus", temperature);
+    oled_write(buffer, 0, 32);
+    sprintf(buffer, "Limites: %d a %d graus", temp_min, temp_max);
+    oled_write_no_clear(buffer, 0, 12);
+}
+
+void setUp(void) {
+    memset(mock_i2c.ram, 0xA5, sizeof(mock_i2c.ram));
+    oled_pending = false;
+    TEST_ASSERT_EQUAL_INT(0, oled_display_init());
+}
+
+void tearDown(void) {
+    ssd1306_deinit(&display);
+}
+
+static void first_frame_should_send_whole_buffer(void) {
+    int temp_min = -8, temp_max = 32;
+
+    uint32_t before = mock_i2c.bytes;
+
+    // Conteúdo do display desconhecido: endereçamento e o buffer inteiro em uma transferência cada
+    draw_main_menu(&temp_min, &temp_max, 1);
+    TEST_ASSERT_EQUAL_UINT(1 + 7 + 1 + 1 + 128 * 8, report_bytes("menu: primeiro quadro", before));
+    assert_panel_matches();
+}
+
+static void unchanged_frame_should_send_nothing(void) {
+    int temp_min = -8, temp_max = 32;
+
+    draw_main_menu(&temp_min, &temp_max, 1);
+    uint32_t transfers = mock_i2c.transfers;
+
+    draw_main_menu(&temp_min, &temp_max, 1);
+    TEST_ASSERT_EQUAL_UINT(transfers, mock_i2c.transfers);
+}
+
+static void menu_frames_should_send_only_changed_columns(void) {
+    int temp_min = -8, temp_max = 32;
+
+    draw_main_menu(&temp_min, &temp_max, 1);
+    assert_panel_matches();
+
+    // Só o cursor muda, nas páginas das duas opções
+    uint32_t before = mock_i2c.bytes;
+    draw_main_menu_selection(0);
+    uint32_t bytes = report_bytes("menu: troca de opção", before);
+    TEST_ASSERT_LESS_THAN_UINT(64, bytes);
+    assert_panel_matches();
+
+    before = mock_i2c.bytes;
+    temp_max = 33;
+    draw_main_menu(&temp_min, &temp_max, 0);
+    bytes = report_bytes("menu: novo limite máximo", before);
+    TEST_ASSERT_LESS_THAN_UINT(64, bytes);
+    assert_panel_matches();
+}
+
+static void monitoring_frames_should_send_only_changed_columns(void) {
+    draw_monitoring_frame(25, -8, 32);
+    commit_bytes("monitoramento: primeiro quadro");
+    assert_panel_matches();
+
+    draw_monitoring_frame(25, -8, 32);
+    TEST_ASSERT_EQUAL_UINT(0, commit_bytes("monitoramento: sem mudança"));
+
+    draw_monitoring_frame(26, -8, 32);
+    uint32_t bytes = commit_bytes("monitoramento: 25 -> 26");
+    TEST_ASSERT_LESS_THAN_UINT(40, bytes);
+    assert_panel_matches();
+
+    oled_write_no_clear("Temperatura ALTA!", 0, 44);
+    commit_bytes("monitoramento: alarme");
+    assert_panel_matches();
+}
+
+static void dashboard_sample_should_send_graph_and_changed_digit(void) {
+    for (int i = 0; i < 200; i++) {
+        oled_record_sample(20 + i % 7);
+    }
+
+    uint32_t before = mock_i2c.bytes;
+    draw_dashboard(25, -8, 32);
+    report_bytes("painel: primeiro quadro", before);
+    assert_panel_matches();
+
+    before = mock_i2c.bytes;
+    draw_dashboard(25, -8, 32);
+    TEST_ASSERT_EQUAL_UINT(0, report_bytes("painel: sem nova leitura", before));
+
+    // O gráfico desloca uma coluna (3 pages) e só o último dígito muda (4 pages)
+    before = mock_i2c.bytes;
+    oled_record_sample(26);
+    draw_dashboard(26, -8, 32);
+    uint32_t bytes = report_bytes("painel: nova leitura", before);
+    TEST_ASSERT_LESS_THAN_UINT(3 * 128 + 4 * DASHBOARD_DIGIT_WIDTH + 64, bytes);
+    assert_panel_matches();
+}
+
+static int frames_done;
+
+static void count_frame(void *user_data) {
+    (void)user_data;
+    frames_done++;
+}
+
+static void drawing_should_continue_while_frame_is_sent(void) {
+    frames_done = 0;
+    ssd1306_set_done_callback(&display, count_frame, NULL);
+
+    draw_monitoring_frame(25, -8, 32);
+    oled_commit();
+    TEST_ASSERT_TRUE(ssd1306_busy(&display));
+    TEST_ASSERT_EQUAL_UINT(1, mock_dma_pending());
+
+    // O próximo quadro é desenhado durante o envio, sem alterar o que está sendo enviado
+    uint8_t sent[128 * 8];
+    memcpy(sent, display.buffer, sizeof(sent));
+    draw_monitoring_frame(26, -8, 32);
+    oled_commit();
+    TEST_ASSERT_TRUE(oled_pending);
+
+    mock_dma_finish();
+    TEST_ASSERT_EQUAL_INT(1, frames_done);
+    TEST_ASSERT_FALSE(ssd1306_busy(&display));
+    for (uint32_t page = 0; page < display.pages; page++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(sent + page * display.width, mock_i2c.ram[page], display.width);
+    }
+
+    // O quadro que aguardava sai na próxima chamada do loop principal
+    uint32_t before = mock_i2c.bytes;
+    oled_poll();
+    TEST_ASSERT_FALSE(oled_pending);
+    report_bytes("monitoramento: quadro pendente", before);
+    TEST_ASSERT_EQUAL_INT(2, frames_done);
+    assert_panel_matches();
+}
+
+static void blocking_show_should_wait_for_transfer(void) {
+    draw_monitoring_frame(25, -8, 32);
+    ssd1306_show(&display);
+    TEST_ASSERT_FALSE(ssd1306_busy(&display));
+    TEST_ASSERT_EQUAL_UINT(0, mock_dma_pending());
+    assert_panel_matches();
+}
+
+static void random_frames_should_keep_panel_in_sync(void) {
+    char text[8];
+
+    srand(1234);
+    oled_commit();
+    mock_dma_finish();
+    for (int frame = 0; frame < 500; frame++) {
+        if (rand() % 4 == 0) {
+            ssd1306_clear(&display);
+        }
+        for (int i = rand() % 4; i > 0; i--) {
+            sprintf(text, "%d", rand() % 1000);
+            ssd1306_draw_string(&display, rand() % 128, rand() % 64, 1 + rand() % 2, text);
+        }
+        if (rand() % 8 == 0) {
+            ssd1306_clear_square(&display, rand() % 128, rand() % 64, rand() % 64, rand() % 32);
+        }
+
+        oled_commit();
+        mock_dma_finish();
+        assert_panel_matches();
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(first_frame_should_send_whole_buffer);
+    RUN_TEST(unchanged_frame_should_send_nothing);
+    RUN_TEST(menu_frames_should_send_only_changed_columns);
+    RUN_TEST(monitoring_frames_should_send_only_changed_columns);
+    RUN_TEST(dashboard_sample_should_send_graph_and_changed_digit);
+    RUN_TEST(drawing_should_continue_while_frame_is_sent);
+    RUN_TEST(blocking_show_should_wait_for_transfer);
+    RUN_TEST(random_frames_should_keep_panel_in_sync);
+    return UNITY_END();
+}
@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "ssd1306.h"
+
+// A fonte embutida já é definida em ssd1306.c; o nome muda para não duplicar o símbolo
+#define font_8x5 test_font_8x5
+#include "font.h"
+#undef font_8x5
+
+// Fonte de 12 linhas, com duas partes por coluna, para cobrir fontes maiores que uma página
+static const uint8_t tall_font[] = {
+    12, 3, 1, 'A', 'B',
+    0xFF, 0x0F, 0x81, 0x08, 0x5A, 0x05,
+    0x3C, 0x00, 0x00, 0x0C, 0xA5, 0x0A,
+};
+
+static uint8_t fast_buffer[128 * 8];
+static uint8_t slow_buffer[128 * 8];
+static ssd1306_t fast = { .width = 128, .height = 64, .pages = 8, .buffer = fast_buffer, .bufsize = sizeof(fast_buffer) };
+static ssd1306_t slow = { .width = 128, .height = 64, .pages = 8, .buffer = slow_buffer, .bufsize = sizeof(slow_buffer) };
+
+/**
+ * @brief Desenho de referência, pixel a pixel, como o driver desenhava antes dos caminhos rápidos
+ */
+static void reference_draw_char(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
+    if (c < font[3] || c > font[4]) {
+        return;
+    }
+
+    uint32_t parts_per_line = (font[0] >> 3) + ((font[0] & 7) > 0);
+    for (uint8_t w = 0; w < font[1]; ++w) {
+        uint32_t pp = (c - font[3]) * font[1] * parts_per_line + w * parts_per_line + 5;
+        for (uint32_t lp = 0; lp < parts_per_line; ++lp, ++pp) {
+            uint8_t line = font[pp];
+            for (int8_t j = 0; j < 8; ++j, line >>= 1) {
+                if (!(line & 1)) {
+                    continue;
+                }
+                for (uint32_t i = 0; i < scale; i++) {
+                    for (uint32_t k = 0; k < scale; k++) {
+                        ssd1306_draw_pixel(p, x + w * scale + i, y + ((lp << 3) + j) * scale + k);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Preenche os dois buffers com o mesmo conteúdo aleatório, para conferir que o desenho só acende pixels
+ */
+static void fill_both(void) {
+    for (size_t i = 0; i < sizeof(fast_buffer); i++) {
+        fast_buffer[i] = slow_buffer[i] = (uint8_t)(rand() & rand());
+    }
+}
+
+static void assert_buffers_equal(void) {
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(slow_buffer, fast_buffer, sizeof(fast_buffer));
+}
+
+// Posições alinhadas, desalinhadas e cortadas pelas bordas do display
+static const uint32_t xs[] = { 0, 3, 61, 122, 125, 127, 128, 300 };
+static const uint32_t ys[] = { 0, 1, 4, 7, 8, 12, 28, 44, 56, 57, 59, 63, 64, 200 };
+
+static void assert_font_matches(const uint8_t *font, uint32_t scale, const ssd1306_glyph_cache_t *cache) {
+    for (int c = font[3] - 1; c <= font[4] + 1; c++) {
+        for (size_t i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+            for (size_t j = 0; j < sizeof(ys) / sizeof(ys[0]); j++) {
+                fill_both();
+                reference_draw_char(&slow, xs[i], ys[j], scale, font, (char)c);
+                if (cache) {
+                    ssd1306_draw_char_cached(&fast, xs[i], ys[j], cache, (char)c);
+                } else {
+                    ssd1306_draw_char_with_font(&fast, xs[i], ys[j], scale, font, (char)c);
+                }
+                assert_buffers_equal();
+            }
+        }
+    }
+}
+
+static void unscaled_chars_should_match_reference(void) {
+    assert_font_matches(test_font_8x5, 1, NULL);
+    assert_font_matches(tall_font, 1, NULL);
+}
+
+static void scaled_chars_should_match_reference(void) {
+    for (uint32_t scale = 2; scale <= 4; scale++) {
+        assert_font_matches(test_font_8x5, scale, NULL);
+        assert_font_matches(tall_font, scale, NULL);
+    }
+}
+
+static void cached_chars_should_match_reference(void) {
+    ssd1306_glyph_cache_t cache;
+
+    for (uint32_t scale = 1; scale <= 4; scale++) {
+        TEST_ASSERT_TRUE(ssd1306_glyph_cache_init(&cache, test_font_8x5, scale));
+        assert_font_matches(test_font_8x5, scale, &cache);
+        ssd1306_glyph_cache_deinit(&cache);
+
+        TEST_ASSERT_TRUE(ssd1306_glyph_cache_init(&cache, tall_font, scale));
+        assert_font_matches(tall_font, scale, &cache);
+        ssd1306_glyph_cache_deinit(&cache);
+    }
+
+    TEST_ASSERT_FALSE(ssd1306_glyph_cache_init(&cache, test_font_8x5, 0));
+}
+
+static void cached_strings_should_match_scaled_strings(void) {
+    ssd1306_glyph_cache_t cache;
+
+    TEST_ASSERT_TRUE(ssd1306_glyph_cache_init(&cache, test_font_8x5, 3));
+    fill_both();
+    ssd1306_draw_string_with_font(&slow, 5, 13, 3, test_font_8x5, "-12 C");
+    ssd1306_draw_string_cached(&fast, 5, 13, &cache, "-12 C");
+    assert_buffers_equal();
+    ssd1306_glyph_cache_deinit(&cache);
+}
+
+static void squares_should_match_pixels(void) {
+    for (int n = 0; n < 2000; n++) {
+        uint32_t x = rand() % 140, y = rand() % 72;
+        uint32_t width = rand() % 40, height = rand() % 40;
+        bool set = rand() & 1;
+
+        fill_both();
+        for (uint32_t i = 0; i < width; i++) {
+            for (uint32_t j = 0; j < height; j++) {
+                if (set) {
+                    ssd1306_draw_pixel(&slow, x + i, y + j);
+                } else {
+                    ssd1306_clear_pixel(&slow, x + i, y + j);
+                }
+            }
+        }
+        if (set) {
+            ssd1306_draw_square(&fast, x, y, width, height);
+        } else {
+            ssd1306_clear_square(&fast, x, y, width, height);
+        }
+        assert_buffers_equal();
+    }
+}
+
+/**
+ * @brief Mede quantos caracteres por segundo cada caminho desenha no computador
+ */
+static double glyphs_per_second(void (*draw)(uint32_t x, uint32_t y, char c)) {
+    const int rounds = 200;
+    uint32_t glyphs = 0;
+
+    clock_t start = clock();
+    for (int r = 0; r < rounds; r++) {
+        for (char c = ' '; c <= '~'; c++, glyphs++) {
+            draw((glyphs % 21) * 6, (glyphs % 7) * 9, c);
+        }
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    return seconds > 0 ? glyphs / seconds : 0;
+}
+
+static ssd1306_glyph_cache_t bench_cache;
+
+static void draw_reference_1(uint32_t x, uint32_t y, char c) { reference_draw_char(&fast, x, y, 1, test_font_8x5, c); }
+static void draw_font_1(uint32_t x, uint32_t y, char c) { ssd1306_draw_char(&fast, x, y, 1, c); }
+static void draw_reference_3(uint32_t x, uint32_t y, char c) { reference_draw_char(&fast, x, y, 3, test_font_8x5, c); }
+static void draw_font_3(uint32_t x, uint32_t y, char c) { ssd1306_draw_char(&fast, x, y, 3, c); }
+static void draw_cached_3(uint32_t x, uint32_t y, char c) { ssd1306_draw_char_cached(&fast, x, y, &bench_cache, c); }
+
+static void glyph_throughput(void) {
+    TEST_ASSERT_TRUE(ssd1306_glyph_cache_init(&bench_cache, test_font_8x5, 3));
+
+    printf("escala 1, pixel a pixel:      %10.0f caracteres/s\n", glyphs_per_second(draw_reference_1));
+    printf("escala 1, colunas inteiras:   %10.0f caracteres/s\n", glyphs_per_second(draw_font_1));
+    printf("escala 3, pixel a pixel:      %10.0f caracteres/s\n", glyphs_per_second(draw_reference_3));
+    printf("escala 3, quadrados por page: %10.0f caracteres/s\n", glyphs_per_second(draw_font_3));
+    printf("escala 3, cache de glifos:    %10.0f caracteres/s\n", glyphs_per_second(draw_cached_3));
+
+    ssd1306_glyph_cache_deinit(&bench_cache);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+int main(void) {
+    srand(1);
+    UNITY_BEGIN();
+    RUN_TEST(unscaled_chars_should_match_reference);
+    RUN_TEST(scaled_chars_should_match_reference);
+    RUN_TEST(cached_chars_should_match_reference);
+    RUN_TEST(cached_strings_should_match_scaled_strings);
+    RUN_TEST(squares_should_match_pixels);
+    RUN_TEST(glyph_throughput);
+    return UNITY_END();
+}
@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "utils/http_response.h"
+
+// Respostas gravadas de um servidor, cada uma com o resumo esperado da leitura
+typedef struct {
+    const char *name;
+    const char *data;
+    const char *expected;
+} recorded_response_t;
+
+static const recorded_response_t recorded[] = {
+    {
+        "content-length",
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: 55\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n"
+        "{\"status\":\"ok\",\"maxTemperature\":30,\"minTemperature\":-5}",
+        "200 json ok { k:status s:ok k:maxTemperature n:30 k:minTemperature n:-5 } |"
+    },
+    {
+        "chunked",
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/json; charset=utf-8\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n"
+        "F;name=value\r\n"
+        "{\"ack\":[1,2,3],\r\n"
+        "E\r\n"
+        "\"note\":\"a\\nb\"}\r\n"
+        "0\r\n"
+        "X-Checksum: 1234\r\n"
+        "\r\n",
+        "200 json ok { k:ack [ n:1 n:2 n:3 ] k:note s:a\nb } |"
+    },
+    {
+        "continue",
+        "HTTP/1.1 100 Continue\r\n"
+        "\r\n"
+        "HTTP/1.1 201 Created\r\n"
+        "content-type: application/json\r\n"
+        "content-length: 2\r\n"
+        "\r\n"
+        "[]",
+        "201 json ok [ ] |"
+    },
+    {
+        "pipelined",
+        "HTTP/1.1 204 No Content\r\n"
+        "\r\n"
+        "HTTP/1.1 500 Internal Server Error\r\n"
+        "Content-Type: text/html\r\n"
+        "Set-Cookie: session=0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef; Path=/\r\n"
+        "Content-Length: 9\r\n"
+        "\r\n"
+        "<h1>x</h1"
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: 8\r\n"
+        "\r\n"
+        "{\"a\":tru",
+        "204 | 500 | 200 json error { k:a |"
+    },
+    {
+        "until-close",
+        "HTTP/1.0 200 OK\r\n"
+        "Content-Type: application/json\r\n"
+        "Connection: close\r\n"
+        "\r\n"
+        "{\"minTemperature\":2.5}",
+        "200 json ok { k:minTemperature n:2.5 } | close"
+    },
+    {
+        "bad-status",
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 0\r\n"
+        "\r\n"
+        "SMTP 220 ready\r\n",
+        "200 | malformed"
+    },
+    {
+        "bad-chunk",
+        "HTTP/1.1 200 OK\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n"
+        "3\r\n"
+        "abcX\r\n",
+        "malformed"
+    },
+};
+
+static char summary[512];     // Resumo de todas as respostas lidas
+static char events[256];      // Eventos do JSON da resposta atual, entram no resumo após o status
+
+static void append(char *buffer, size_t size, const char *text) {
+    size_t len = strlen(buffer);
+    TEST_ASSERT_TRUE(len + strlen(text) + 2 < size);
+    sprintf(buffer + len, "%s%s", len > 0 ? " " : "", text);
+}
+
+static void summary_append(const char *text) {
+    append(summary, sizeof(summary), text);
+}
+
+static void event_append(const char *text) {
+    append(events, sizeof(events), text);
+}
+
+static cJSON_bool CJSON_CDECL on_begin_object(void *user_data) {
+    (void)user_data;
+    event_append("{");
+    return true;
+}
+
+static cJSON_bool CJSON_CDECL on_end_object(void *user_data) {
+    (void)user_data;
+    event_append("}");
+    return true;
+}
+
+static cJSON_bool CJSON_CDECL on_begin_array(void *user_data) {
+    (void)user_data;
+    event_append("[");
+    return true;
+}
+
+static cJSON_bool CJSON_CDECL on_end_array(void *user_data) {
+    (void)user_data;
+    event_append("]");
+    return true;
+}
+
+static cJSON_bool CJSON_CDECL on_key(void *user_data, const char *key, size_t length) {
+    char text[HTTP_JSON_TOKEN_MAX + 2];
+    (void)user_data;
+    (void)length;
+    sprintf(text, "k:%s", key);
+    event_append(text);
+    return true;
+}
+
+static cJSON_bool CJSON_CDECL on_value(void *user_data, const cJSON *item) {
+    char text[HTTP_JSON_TOKEN_MAX + 2];
+    (void)user_data;
+    if (cJSON_IsString(item)) {
+        sprintf(text, "s:%s", item->valuestring);
+    } else {
+        sprintf(text, "n:%g", item->valuedouble);
+    }
+    event_append(text);
+    return true;
+}
+
+static const cJSON_SaxCallbacks callbacks = {
+    on_begin_object, on_end_object, on_begin_array, on_end_array, on_key, on_value
+};
+
+static void summary_response(const http_response_t *res) {
+    char text[32];
+    sprintf(text, "%d", res->status_code);
+    summary_append(text);
+    if (res->json) {
+        summary_append(res->json_ok ? "json ok" : "json error");
+    }
+    if (events[0] != '\0') {
+        summary_append(events);
+        events[0] = '\0';
+    }
+    summary_append("|");
+}
+
+/**
+ * @brief Entrega um trecho recebido, como faria o callback de recepção do TCP com um pbuf
+ */
+static void deliver(http_response_t *res, const char *data, size_t len, bool *failed) {
+    size_t offset = 0;
+
+    while (offset < len && !*failed) {
+        offset += http_response_feed(res, data + offset, len - offset);
+
+        if (res->state == HTTP_PARSE_ERROR) {
+            summary_append("malformed");
+            *failed = true;
+        } else if (res->state == HTTP_PARSE_DONE) {
+            summary_response(res);
+            http_response_reset(res);
+        }
+    }
+}
+
+/**
+ * @brief Lê uma resposta gravada dividida em segmentos nas posições indicadas
+ */
+static void read_split(const char *data, const size_t *splits, size_t split_count) {
+    http_response_t res;
+    bool failed = false;
+    size_t start = 0;
+
+    summary[0] = '\0';
+    events[0] = '\0';
+    http_response_init(&res, &callbacks, NULL);
+
+    for (size_t i = 0; i <= split_count; i++) {
+        size_t end = i < split_count ? splits[i] : strlen(data);
+        deliver(&res, data + start, end - start, &failed);
+        start = end;
+    }
+
+    if (!failed && http_response_close(&res)) {
+        summary_response(&res);
+        summary_append("close");
+    }
+}
+
+static void assert_summary(const recorded_response_t *response, const char *context) {
+    char message[96];
+
+    snprintf(message, sizeof(message), "%s, %s", response->name, context);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(response->expected, summary, message);
+}
+
+static void http_response_should_read_whole_responses(void) {
+    for (size_t r = 0; r < sizeof(recorded) / sizeof(recorded[0]); r++) {
+        read_split(recorded[r].data, NULL, 0);
+        assert_summary(&recorded[r], "whole");
+    }
+}
+
+static void http_response_should_read_responses_split_at_every_byte(void) {
+    for (size_t r = 0; r < sizeof(recorded) / sizeof(recorded[0]); r++) {
+        size_t len = strlen(recorded[r].data);
+        for (size_t split = 0; split <= len; split++) {
+            char context[32];
+            snprintf(context, sizeof(context), "split at %u", (unsigned)split);
+            read_split(recorded[r].data, &split, 1);
+            assert_summary(&recorded[r], context);
+        }
+    }
+}
+
+static void http_response_should_read_responses_one_byte_at_a_time(void) {
+    static size_t splits[1024];
+
+    for (size_t r = 0; r < sizeof(recorded) / sizeof(recorded[0]); r++) {
+        size_t len = strlen(recorded[r].data);
+        TEST_ASSERT_TRUE(len <= sizeof(splits) / sizeof(splits[0]));
+        for (size_t i = 0; i < len; i++) {
+            splits[i] = i;
+        }
+        read_split(recorded[r].data, splits, len);
+        assert_summary(&recorded[r], "byte by byte");
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(http_response_should_read_whole_responses);
+    RUN_TEST(http_response_should_read_responses_split_at_every_byte);
+    RUN_TEST(http_response_should_read_responses_one_byte_at_a_time);
+
+    return UNITY_END();
+}
@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "hardware/dma.h"
+#include "utils/led_matrix_funcs.h"
+
+#define LOOP_US 100000                                  // sleep_ms(100) do loop principal
+#define SLICE_US 1000
+#define SETTLE_US 5000000                               // Mais que um ciclo de dithering na matriz 5x5
+
+static uint32_t frames;                                 // Quadros recebidos pela matriz
+
+/**
+ * @brief Avança o relógio em fatias, concluindo o DMA como a matriz faria
+ */
+static void run_us(uint64_t us) {
+    for (uint64_t t = 0; t < us; t += SLICE_US) {
+        mock_time_advance_us(SLICE_US);
+        mock_dma_finish();
+        frames += mock_pio0.count[0] / 25;
+        mock_pio_reset(pio0);
+    }
+}
+
+/**
+ * @brief Iterações do loop principal em STATE_MONITORING com a temperatura normal:
+ * check_temperature() pinta a matriz de verde a cada iteração
+ */
+static void monitoring_loop(uGRB32_t color, uint64_t us) {
+    for (uint64_t t = 0; t < us; t += LOOP_US) {
+        led_matrix_colorize(color);
+        run_us(LOOP_US);
+    }
+}
+
+void setUp(void) {
+    frames = 0;
+}
+
+void tearDown(void) {
+}
+
+static void idle_matrix_should_not_wake_cpu(void) {
+    monitoring_loop(GRB_GREEN, SETTLE_US);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, frames);
+
+    // Tela parada: nenhum alarme nem quadro, embora o loop continue pintando a matriz
+    uint32_t wakeups = mock_time_wakeups();
+    frames = 0;
+    monitoring_loop(GRB_GREEN, 60000000);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_time_wakeups() - wakeups);
+    TEST_ASSERT_EQUAL_UINT32(0, frames);
+}
+
+static void color_change_should_be_shown_then_settle(void) {
+    monitoring_loop(GRB_GREEN, SETTLE_US);
+
+    // Alarme: a matriz fica vermelha e volta a ficar parada
+    frames = 0;
+    monitoring_loop(GRB_RED, SETTLE_US);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, frames);
+
+    uint32_t wakeups = mock_time_wakeups();
+    frames = 0;
+    monitoring_loop(GRB_RED, 10000000);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_time_wakeups() - wakeups);
+    TEST_ASSERT_EQUAL_UINT32(0, frames);
+}
+
+int main(void) {
+    led_matrix_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(idle_matrix_should_not_wake_cpu);
+    RUN_TEST(color_change_should_be_shown_then_settle);
+    return UNITY_END();
+}
@@ -0,0 +1,17 @@
+// Substitui o header gerado pelo pico_generate_pio_header a partir do dht22.pio
+#ifndef MOCK_DHT22_PIO_H
+#define MOCK_DHT22_PIO_H
+
+#include "hardware/pio.h"
+
+static const pio_program_t dht22_program = { NULL, 0, -1 };
+
+static inline void dht22_program_init(PIO pio, uint sm, uint offset, uint pin, float freq) {
+    (void)pio;
+    (void)sm;
+    (void)offset;
+    (void)pin;
+    (void)freq;
+}
+
+#endif // MOCK_DHT22_PIO_H
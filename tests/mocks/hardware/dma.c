@@ -0,0 +1,153 @@
+#include <stdlib.h>
+
+#include "hardware/dma.h"
+#include "hardware/i2c.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+
+static bool claimed[NUM_DMA_CHANNELS];
+static bool irq1_enabled[NUM_DMA_CHANNELS];
+static bool irq1_status[NUM_DMA_CHANNELS];
+static const volatile void *read_addr[NUM_DMA_CHANNELS];
+static volatile void *write_addr[NUM_DMA_CHANNELS];
+static enum dma_channel_transfer_size data_size[NUM_DMA_CHANNELS];
+static bool write_increment[NUM_DMA_CHANNELS];
+static uint32_t remaining[NUM_DMA_CHANNELS];
+static irq_handler_t dma_irq1_handler;
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)num;
+    (void)order_priority;
+    dma_irq1_handler = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    (void)num;
+    (void)enabled;
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (int ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (!claimed[ch]) {
+            claimed[ch] = true;
+            return ch;
+        }
+    }
+    if (required) {
+        abort();
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    claimed[channel] = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    dma_channel_config c = { channel, DMA_SIZE_32, false };
+    return c;
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) { c->size = size; }
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) { c->write_increment = incr; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) { (void)c; (void)dreq; }
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write,
+                           const volatile void *read, uint transfer_count, bool trigger) {
+    write_addr[channel] = write;
+    data_size[channel] = config->size;
+    write_increment[channel] = config->write_increment;
+    read_addr[channel] = read;
+    remaining[channel] = trigger ? transfer_count : 0;
+}
+
+void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read, uint32_t transfer_count) {
+    read_addr[channel] = read;
+    remaining[channel] = transfer_count;
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write, bool trigger) {
+    write_addr[channel] = write;
+    (void)trigger;
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger) {
+    if (trigger) {
+        remaining[channel] = trans_count;
+    }
+}
+
+void dma_channel_abort(uint channel) {
+    remaining[channel] = 0;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return remaining[channel] > 0;
+}
+
+void dma_channel_set_irq1_enabled(uint channel, bool enabled) {
+    irq1_enabled[channel] = enabled;
+}
+
+bool dma_channel_get_irq1_status(uint channel) {
+    return irq1_status[channel];
+}
+
+void dma_channel_acknowledge_irq1(uint channel) {
+    irq1_status[channel] = false;
+}
+
+uint32_t mock_dma_pending(void) {
+    uint32_t pending = 0;
+    for (int ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        pending += remaining[ch] > 0;
+    }
+    return pending;
+}
+
+void mock_dma_finish(void) {
+    for (int ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (remaining[ch] == 0) {
+            continue;
+        }
+
+        // Origem: uma RX FIFO do PIO simulado, enquanto houver palavras nela, ou a memória.
+        // Destino: a memória, uma TX FIFO do PIO simulado ou, senão, o data_cmd do I2C simulado
+        while (remaining[ch] > 0) {
+            uint32_t word;
+            if (mock_pio_is_rxf(read_addr[ch])) {
+                if (!mock_pio_rxf_read(read_addr[ch], &word)) {
+                    break;
+                }
+            } else if (data_size[ch] == DMA_SIZE_32) {
+                word = *(const volatile uint32_t *)read_addr[ch];
+                read_addr[ch] = (const volatile uint32_t *)read_addr[ch] + 1;
+            } else if (data_size[ch] == DMA_SIZE_16) {
+                word = *(const volatile uint16_t *)read_addr[ch];
+                read_addr[ch] = (const volatile uint16_t *)read_addr[ch] + 1;
+            } else {
+                word = *(const volatile uint8_t *)read_addr[ch];
+                read_addr[ch] = (const volatile uint8_t *)read_addr[ch] + 1;
+            }
+
+            if (write_increment[ch]) {
+                *(volatile uint32_t *)write_addr[ch] = word;
+                write_addr[ch] = (volatile uint32_t *)write_addr[ch] + 1;
+            } else if (!mock_pio_txf_write(write_addr[ch], word)) {
+                mock_i2c_data_cmd(&mock_i2c, (uint16_t)word);
+            }
+            remaining[ch]--;
+        }
+
+        // Ainda esperando palavras da RX FIFO
+        if (remaining[ch] > 0) {
+            continue;
+        }
+
+        if (irq1_enabled[ch]) {
+            irq1_status[ch] = true;
+            dma_irq1_handler();
+        }
+    }
+}
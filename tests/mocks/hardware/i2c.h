@@ -0,0 +1,46 @@
+// I2C simulado para os testes no computador: conta os bytes no barramento e
+// reproduz a RAM de um SSD1306 em modo de endereçamento horizontal
+#ifndef MOCK_HARDWARE_I2C_H
+#define MOCK_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+typedef struct {
+    uint32_t transfers;
+    uint32_t bytes;             // Bytes no barramento, incluindo o endereço de cada transferência
+    uint8_t ram[8][128];        // RAM do display, por página e coluna
+    uint8_t col_start, col_end, page_start, page_end;
+    uint8_t col, page;
+    uint8_t pending[3];         // Comando com argumentos ainda incompleto
+    uint8_t pending_len;
+    uint8_t fifo[2048];         // Transação recebida pelo registrador data_cmd, até o STOP
+    size_t fifo_len;
+} i2c_inst_t;
+
+// Registradores usados pelo envio por DMA; as transferências simuladas terminam na hora
+typedef struct {
+    uint32_t data_cmd;
+    uint32_t tar;
+    uint32_t enable;
+    uint32_t status;
+    uint32_t raw_intr_stat;
+    uint32_t clr_tx_abrt;
+} i2c_hw_t;
+
+#define I2C_IC_DATA_CMD_STOP_BITS 0x00000200
+#define I2C_IC_STATUS_TFE_BITS 0x00000004
+#define I2C_IC_STATUS_MST_ACTIVITY_BITS 0x00000020
+#define I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS 0x00000040
+
+extern i2c_inst_t mock_i2c;
+#define i2c1 (&mock_i2c)
+
+unsigned int i2c_init(i2c_inst_t *i2c, unsigned int baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c);
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx);
+
+// Recebe uma palavra escrita no registrador data_cmd, como o DMA faz
+void mock_i2c_data_cmd(i2c_inst_t *i2c, uint16_t word);
+
+#endif // MOCK_HARDWARE_I2C_H
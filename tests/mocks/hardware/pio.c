@@ -0,0 +1,98 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "hardware/pio.h"
+
+pio_hw_t mock_pio0, mock_pio1;
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    for (int sm = 0; sm < 4; sm++) {
+        if (!pio->claimed[sm]) {
+            pio->claimed[sm] = true;
+            return sm;
+        }
+    }
+    if (required) {
+        abort();
+    }
+    return -1;
+}
+
+uint pio_add_program(PIO pio, const pio_program_t *program) {
+    (void)pio;
+    (void)program;
+    return 0;
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return (pio == pio1 ? 8 : 0) + (is_tx ? 0 : 4) + sm;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data) {
+    if (pio->count[sm] < MOCK_PIO_WORDS) {
+        pio->words[sm][pio->count[sm]] = data;
+    }
+    pio->count[sm]++;
+}
+
+void pio_sm_clear_fifos(PIO pio, uint sm) {
+    pio->rx_count[sm] = 0;
+    pio->rx_read[sm] = 0;
+}
+
+bool mock_pio_txf_write(volatile void *addr, uint32_t word) {
+    PIO pios[] = { pio0, pio1 };
+
+    for (int i = 0; i < 2; i++) {
+        for (uint sm = 0; sm < 4; sm++) {
+            if (addr == &pios[i]->txf[sm]) {
+                pio_sm_put_blocking(pios[i], sm, word);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Procura a RX FIFO correspondente ao endereço, ou NULL se não for de uma
+ */
+static PIO rxf_owner(const volatile void *addr, uint *sm) {
+    PIO pios[] = { pio0, pio1 };
+
+    for (int i = 0; i < 2; i++) {
+        for (uint s = 0; s < 4; s++) {
+            if (addr == &pios[i]->rxf[s]) {
+                *sm = s;
+                return pios[i];
+            }
+        }
+    }
+    return NULL;
+}
+
+bool mock_pio_is_rxf(const volatile void *addr) {
+    uint sm;
+    return rxf_owner(addr, &sm) != NULL;
+}
+
+bool mock_pio_rxf_read(const volatile void *addr, uint32_t *word) {
+    uint sm;
+    PIO pio = rxf_owner(addr, &sm);
+
+    if (pio == NULL || pio->rx_read[sm] == pio->rx_count[sm]) {
+        return false;
+    }
+    *word = pio->rx_words[sm][pio->rx_read[sm]++];
+    return true;
+}
+
+void mock_pio_rx_push(PIO pio, uint sm, uint32_t word) {
+    if (pio->rx_count[sm] < MOCK_PIO_RX_WORDS) {
+        pio->rx_words[sm][pio->rx_count[sm]++] = word;
+    }
+}
+
+void mock_pio_reset(PIO pio) {
+    memset(pio->count, 0, sizeof(pio->count));
+}
@@ -0,0 +1,70 @@
+// PIO simulado para os testes no computador: guarda as palavras escritas na TX FIFO
+// de cada state machine, como a fita de LEDs as receberia, e entrega na RX FIFO
+// as palavras que o teste enfileirar, como um sensor as mediria
+#ifndef MOCK_HARDWARE_PIO_H
+#define MOCK_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+#define MOCK_PIO_WORDS 4096
+#define MOCK_PIO_RX_WORDS 64
+
+typedef struct {
+    volatile uint32_t txf[4];   // Endereços de destino do DMA
+    volatile uint32_t rxf[4];   // Endereços de origem do DMA
+    uint32_t words[4][MOCK_PIO_WORDS];  // Palavras recebidas por state machine
+    uint32_t count[4];
+    uint32_t rx_words[4][MOCK_PIO_RX_WORDS];    // Palavras ainda não lidas da RX FIFO
+    uint32_t rx_count[4];
+    uint32_t rx_read[4];
+    bool claimed[4];
+} pio_hw_t;
+
+enum pio_src_dest {
+    pio_pins = 0,
+    pio_x = 1,
+    pio_y = 2,
+    pio_null = 3,
+    pio_pindirs = 4
+};
+
+typedef pio_hw_t *PIO;
+
+typedef struct {
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+extern pio_hw_t mock_pio0, mock_pio1;
+#define pio0 (&mock_pio0)
+#define pio1 (&mock_pio1)
+
+int pio_claim_unused_sm(PIO pio, bool required);
+uint pio_add_program(PIO pio, const pio_program_t *program);
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+void pio_sm_clear_fifos(PIO pio, uint sm);
+
+static inline void pio_sm_put(PIO pio, uint sm, uint32_t data) { pio_sm_put_blocking(pio, sm, data); }
+static inline void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) { (void)pio; (void)sm; (void)enabled; }
+static inline void pio_sm_restart(PIO pio, uint sm) { (void)pio; (void)sm; }
+static inline void pio_sm_exec(PIO pio, uint sm, uint instr) { (void)pio; (void)sm; (void)instr; }
+static inline uint pio_encode_set(enum pio_src_dest dest, uint value) { return 0xe000u | ((uint)dest << 5) | value; }
+static inline uint pio_encode_jmp(uint addr) { return addr; }
+
+// Recebe uma palavra escrita em um registrador txf, como o DMA faz; false se o endereço não for de uma TX FIFO
+bool mock_pio_txf_write(volatile void *addr, uint32_t word);
+
+// Entrega a palavra de um registrador rxf, como o DMA faz; false se o endereço não for de uma RX FIFO
+// ou se ela estiver vazia
+bool mock_pio_rxf_read(const volatile void *addr, uint32_t *word);
+bool mock_pio_is_rxf(const volatile void *addr);
+
+// Enfileira uma palavra na RX FIFO, como o programa do state machine faria com push
+void mock_pio_rx_push(PIO pio, uint sm, uint32_t word);
+
+// Descarta as palavras recebidas
+void mock_pio_reset(PIO pio);
+
+#endif // MOCK_HARDWARE_PIO_H
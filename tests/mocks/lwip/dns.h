@@ -0,0 +1,11 @@
+// Substitui o lwip/dns.h nos testes no computador: resolve endereços IPv4 e "localhost" na hora
+#ifndef MOCK_LWIP_DNS_H
+#define MOCK_LWIP_DNS_H
+
+#include "lwip/ip_addr.h"
+
+typedef void (*dns_found_callback)(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+
+err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg);
+
+#endif // MOCK_LWIP_DNS_H
@@ -0,0 +1,14 @@
+// Substitui o lwip/ip_addr.h nos testes no computador: só endereços IPv4
+#ifndef MOCK_LWIP_IP_ADDR_H
+#define MOCK_LWIP_IP_ADDR_H
+
+#include "lwip/err.h"
+
+typedef struct {
+    u32_t addr;     // Na ordem de bytes da rede
+} ip_addr_t;
+
+#define IPADDR_TYPE_V4 0
+#define IP_GET_TYPE(ipaddr) IPADDR_TYPE_V4
+
+#endif // MOCK_LWIP_IP_ADDR_H
@@ -0,0 +1,17 @@
+// Substitui o lwip/pbuf.h nos testes no computador
+#ifndef MOCK_LWIP_PBUF_H
+#define MOCK_LWIP_PBUF_H
+
+#include "lwip/err.h"
+
+struct pbuf {
+    struct pbuf *next;
+    void *payload;
+    u16_t tot_len;      // Bytes deste pbuf e dos seguintes da cadeia
+    u16_t len;
+};
+
+// Libera a cadeia inteira, como o lwIP faz com um pbuf de referência única
+u8_t pbuf_free(struct pbuf *p);
+
+#endif // MOCK_LWIP_PBUF_H
@@ -0,0 +1,361 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "lwip/dns.h"
+#include "lwip/tcp.h"
+
+#define MOCK_TCP_PCBS 4
+#define MOCK_TCP_QUEUELEN 33        // TCP_SND_QUEUELEN do lwipopts.h: trechos aguardando envio por PCB
+#define MOCK_PBUF_LEN 536           // Bytes por pbuf recebido, o MSS padrão: respostas maiores chegam em cadeias
+
+struct tcp_pcb {
+    int fd;
+    uint32_t id;
+    void *arg;
+    tcp_connected_fn connected;
+    tcp_recv_fn recv;
+    tcp_sent_fn sent;
+    tcp_err_fn errf;
+    bool connecting;
+    bool eof;
+    // Trechos entregues por tcp_write(), lidos dos buffers do chamador só no envio
+    struct {
+        const uint8_t *data;
+        u16_t len;
+    } queue[MOCK_TCP_QUEUELEN];
+    uint8_t queue_head;
+    uint8_t queue_count;
+    u16_t queue_offset;             // Bytes do primeiro trecho já enviados
+    u32_t queued;                   // Bytes entregues por tcp_write() e ainda não enviados
+};
+
+u16_t mock_tcp_snd_buf = 8 * 1460;
+u16_t mock_tcp_send_limit;
+
+static struct tcp_pcb *pcbs[MOCK_TCP_PCBS];
+static uint32_t next_id = 1;
+
+u8_t pbuf_free(struct pbuf *p) {
+    u8_t count = 0;
+
+    while (p != NULL) {
+        struct pbuf *next = p->next;
+        free(p);
+        p = next;
+        count++;
+    }
+    return count;
+}
+
+err_t dns_gethostbyname(const char *hostname, ip_addr_t *addr, dns_found_callback found, void *callback_arg) {
+    struct in_addr in;
+
+    (void)found;
+    (void)callback_arg;
+    if (strcmp(hostname, "localhost") == 0) {
+        hostname = "127.0.0.1";
+    }
+    if (inet_pton(AF_INET, hostname, &in) != 1) {
+        return ERR_ARG;
+    }
+    addr->addr = in.s_addr;
+    return ERR_OK;
+}
+
+struct tcp_pcb *tcp_new_ip_type(u8_t type) {
+    (void)type;
+
+    for (int i = 0; i < MOCK_TCP_PCBS; i++) {
+        if (pcbs[i] != NULL) {
+            continue;
+        }
+
+        struct tcp_pcb *pcb = calloc(1, sizeof(struct tcp_pcb));
+        int one = 1;
+        pcb->fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (pcb->fd < 0) {
+            free(pcb);
+            return NULL;
+        }
+        fcntl(pcb->fd, F_SETFL, fcntl(pcb->fd, F_GETFL) | O_NONBLOCK);
+        setsockopt(pcb->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        pcb->id = next_id++;
+        pcbs[i] = pcb;
+        return pcb;
+    }
+    return NULL;
+}
+
+void tcp_arg(struct tcp_pcb *pcb, void *arg) { pcb->arg = arg; }
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv) { pcb->recv = recv; }
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent) { pcb->sent = sent; }
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err) { pcb->errf = err; }
+
+err_t tcp_connect(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port, tcp_connected_fn connected) {
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(port) };
+
+    addr.sin_addr.s_addr = ipaddr->addr;
+    pcb->connected = connected;
+    if (connect(pcb->fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 && errno != EINPROGRESS) {
+        return ERR_RTE;
+    }
+    pcb->connecting = true;
+    return ERR_OK;
+}
+
+u16_t tcp_sndbuf(const struct tcp_pcb *pcb) {
+    return pcb->queued >= mock_tcp_snd_buf ? 0 : mock_tcp_snd_buf - pcb->queued;
+}
+
+err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags) {
+    if (pcb->connecting || len > tcp_sndbuf(pcb) || pcb->queue_count == MOCK_TCP_QUEUELEN) {
+        return ERR_MEM;
+    }
+    if (apiflags & TCP_WRITE_FLAG_COPY) {
+        return ERR_VAL;     // O código testado só usa escritas sem cópia
+    }
+
+    uint8_t slot = (pcb->queue_head + pcb->queue_count++) % MOCK_TCP_QUEUELEN;
+    pcb->queue[slot].data = dataptr;
+    pcb->queue[slot].len = len;
+    pcb->queued += len;
+    return ERR_OK;
+}
+
+err_t tcp_output(struct tcp_pcb *pcb) {
+    (void)pcb;
+    return ERR_OK;
+}
+
+void tcp_recved(struct tcp_pcb *pcb, u16_t len) {
+    (void)pcb;
+    (void)len;
+}
+
+/**
+ * @brief Fecha o socket e libera o PCB; a posição pode ser reutilizada por um novo PCB
+ */
+static void pcb_release(struct tcp_pcb *pcb, bool reset) {
+    for (int i = 0; i < MOCK_TCP_PCBS; i++) {
+        if (pcbs[i] == pcb) {
+            pcbs[i] = NULL;
+        }
+    }
+
+    if (reset) {
+        // Descarta os dados não enviados e manda RST, como um abort
+        struct linger linger = { .l_onoff = 1, .l_linger = 0 };
+        setsockopt(pcb->fd, SOL_SOCKET, SO_LINGER, &linger, sizeof(linger));
+    }
+    close(pcb->fd);
+    free(pcb);
+}
+
+err_t tcp_close(struct tcp_pcb *pcb) {
+    pcb_release(pcb, false);
+    return ERR_OK;
+}
+
+void tcp_abort(struct tcp_pcb *pcb) {
+    tcp_err_fn errf = pcb->errf;
+    void *arg = pcb->arg;
+
+    pcb_release(pcb, true);
+    if (errf) {
+        errf(arg, ERR_ABRT);
+    }
+}
+
+/**
+ * @brief Falha na conexão: libera o PCB e avisa a aplicação, como o lwIP faz ao receber um RST
+ */
+static void pcb_fail(struct tcp_pcb *pcb) {
+    tcp_err_fn errf = pcb->errf;
+    void *arg = pcb->arg;
+
+    pcb_release(pcb, true);
+    if (errf) {
+        errf(arg, ERR_RST);
+    }
+}
+
+/**
+ * @brief Verifica se o PCB continua aberto depois de um callback, que pode ter fechado ou abortado a conexão
+ */
+static bool pcb_alive(int slot, uint32_t id) {
+    return pcbs[slot] != NULL && pcbs[slot]->id == id;
+}
+
+/**
+ * @brief Entrega ao socket os trechos pendentes, lendo dos buffers do chamador
+ * @return Bytes enviados, ou -1 se a conexão falhou
+ */
+static long pcb_send(struct tcp_pcb *pcb) {
+    long total = 0;
+
+    while (pcb->queue_count > 0 && (mock_tcp_send_limit == 0 || total < mock_tcp_send_limit)) {
+        const uint8_t *data = pcb->queue[pcb->queue_head].data + pcb->queue_offset;
+        size_t len = pcb->queue[pcb->queue_head].len - pcb->queue_offset;
+        if (mock_tcp_send_limit != 0 && len > (size_t)(mock_tcp_send_limit - total)) {
+            len = mock_tcp_send_limit - total;
+        }
+
+        ssize_t n = send(pcb->fd, data, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? total : -1;
+        }
+
+        total += n;
+        pcb->queue_offset += n;
+        if (pcb->queue_offset == pcb->queue[pcb->queue_head].len) {
+            pcb->queue_head = (pcb->queue_head + 1) % MOCK_TCP_QUEUELEN;
+            pcb->queue_count--;
+            pcb->queue_offset = 0;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Lê o que chegou no socket em uma cadeia de pbufs
+ * @return A cadeia, NULL se não há nada para ler; eof indica que o servidor fechou a conexão
+ */
+static struct pbuf *pcb_receive(struct tcp_pcb *pcb, bool *eof, bool *failed) {
+    struct pbuf *first = NULL, *last = NULL;
+
+    *eof = false;
+    *failed = false;
+    for (int i = 0; i < 4; i++) {
+        struct pbuf *p = malloc(sizeof(struct pbuf) + MOCK_PBUF_LEN);
+        ssize_t n = recv(pcb->fd, p + 1, MOCK_PBUF_LEN, 0);
+        if (n <= 0) {
+            free(p);
+            *eof = n == 0;
+            *failed = n < 0 && errno != EAGAIN && errno != EWOULDBLOCK;
+            break;
+        }
+
+        p->next = NULL;
+        p->payload = p + 1;
+        p->len = n;
+        p->tot_len = 0;
+        if (last) {
+            last->next = p;
+        } else {
+            first = p;
+        }
+        last = p;
+    }
+
+    // tot_len de cada pbuf inclui os seguintes
+    u16_t tot_len = 0;
+    for (struct pbuf *p = first; p != NULL; p = p->next) {
+        tot_len += p->len;
+    }
+    for (struct pbuf *p = first; p != NULL; p = p->next) {
+        p->tot_len = tot_len;
+        tot_len -= p->len;
+    }
+    return first;
+}
+
+void mock_lwip_poll(void) {
+    for (int i = 0; i < MOCK_TCP_PCBS; i++) {
+        struct tcp_pcb *pcb = pcbs[i];
+        if (pcb == NULL) {
+            continue;
+        }
+        uint32_t id = pcb->id;
+
+        if (pcb->connecting) {
+            struct pollfd pfd = { .fd = pcb->fd, .events = POLLOUT };
+            int error = 0;
+            socklen_t size = sizeof(error);
+
+            if (poll(&pfd, 1, 0) <= 0) {
+                continue;
+            }
+            getsockopt(pcb->fd, SOL_SOCKET, SO_ERROR, &error, &size);
+            if (error != 0) {
+                pcb_fail(pcb);
+                continue;
+            }
+
+            pcb->connecting = false;
+            if (pcb->connected) {
+                pcb->connected(pcb->arg, pcb, ERR_OK);
+                if (!pcb_alive(i, id)) {
+                    continue;
+                }
+            }
+        }
+
+        long sent = pcb_send(pcb);
+        if (sent < 0) {
+            pcb_fail(pcb);
+            continue;
+        }
+        if (sent > 0) {
+            // Como no loopback não há perdas, o que foi entregue ao socket conta como confirmado
+            pcb->queued -= sent;
+            if (pcb->sent) {
+                pcb->sent(pcb->arg, pcb, (u16_t)sent);
+                if (!pcb_alive(i, id)) {
+                    continue;
+                }
+            }
+        }
+
+        if (pcb->eof) {
+            continue;
+        }
+
+        bool eof, failed;
+        struct pbuf *p = pcb_receive(pcb, &eof, &failed);
+        if (p != NULL) {
+            if (pcb->recv) {
+                pcb->recv(pcb->arg, pcb, p, ERR_OK);
+                if (!pcb_alive(i, id)) {
+                    continue;
+                }
+            } else {
+                pbuf_free(p);
+            }
+        }
+
+        if (failed) {
+            pcb_fail(pcb);
+        } else if (eof) {
+            pcb->eof = true;
+            if (pcb->recv) {
+                pcb->recv(pcb->arg, pcb, NULL, ERR_OK);
+            } else {
+                tcp_close(pcb);
+            }
+        }
+    }
+}
+
+void mock_tcp_reset_all(void) {
+    for (int i = 0; i < MOCK_TCP_PCBS; i++) {
+        if (pcbs[i] != NULL) {
+            pcb_fail(pcbs[i]);
+        }
+    }
+}
+
+int mock_tcp_open_pcbs(void) {
+    int open = 0;
+    for (int i = 0; i < MOCK_TCP_PCBS; i++) {
+        open += pcbs[i] != NULL;
+    }
+    return open;
+}
@@ -0,0 +1,52 @@
+// Substitui o lwip/tcp.h nos testes no computador. Cada PCB é um socket TCP de verdade, sem
+// bloquear, e os callbacks são chamados por mock_lwip_poll(), no lugar das interrupções do cyw43.
+// Como no lwIP, tcp_write() não copia os dados: o socket lê direto dos buffers do chamador quando
+// mock_lwip_poll() os envia, e só então o espaço volta para tcp_sndbuf() e tcp_sent() é chamado
+#ifndef MOCK_LWIP_TCP_H
+#define MOCK_LWIP_TCP_H
+
+#include <stdbool.h>
+#include "lwip/err.h"
+#include "lwip/ip_addr.h"
+#include "lwip/pbuf.h"
+
+#define TCP_WRITE_FLAG_COPY 0x01
+#define TCP_WRITE_FLAG_MORE 0x02
+
+struct tcp_pcb;
+
+typedef err_t (*tcp_connected_fn)(void *arg, struct tcp_pcb *tpcb, err_t err);
+typedef err_t (*tcp_recv_fn)(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
+typedef err_t (*tcp_sent_fn)(void *arg, struct tcp_pcb *tpcb, u16_t len);
+typedef void (*tcp_err_fn)(void *arg, err_t err);
+
+struct tcp_pcb *tcp_new_ip_type(u8_t type);
+void tcp_arg(struct tcp_pcb *pcb, void *arg);
+void tcp_recv(struct tcp_pcb *pcb, tcp_recv_fn recv);
+void tcp_sent(struct tcp_pcb *pcb, tcp_sent_fn sent);
+void tcp_err(struct tcp_pcb *pcb, tcp_err_fn err);
+err_t tcp_connect(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port, tcp_connected_fn connected);
+err_t tcp_write(struct tcp_pcb *pcb, const void *dataptr, u16_t len, u8_t apiflags);
+err_t tcp_output(struct tcp_pcb *pcb);
+u16_t tcp_sndbuf(const struct tcp_pcb *pcb);
+void tcp_recved(struct tcp_pcb *pcb, u16_t len);
+err_t tcp_close(struct tcp_pcb *pcb);
+void tcp_abort(struct tcp_pcb *pcb);
+
+// Tamanho do buffer de envio de cada PCB, TCP_SND_BUF do lwipopts.h por padrão
+extern u16_t mock_tcp_snd_buf;
+
+// Maior quantidade de bytes entregue ao socket em cada chamada de mock_lwip_poll(), 0 para sem limite.
+// Com um limite, o espaço do buffer de envio volta aos poucos, como nas confirmações do servidor
+extern u16_t mock_tcp_send_limit;
+
+// Trata os eventos dos sockets e chama os callbacks, como o lwIP faria nas interrupções
+void mock_lwip_poll(void);
+
+// Derruba as conexões abertas com ERR_RST, como quando o link wifi cai
+void mock_tcp_reset_all(void);
+
+// PCBs ainda não fechados nem abortados
+int mock_tcp_open_pcbs(void);
+
+#endif // MOCK_LWIP_TCP_H
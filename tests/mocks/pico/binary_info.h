@@ -0,0 +1 @@
+// Substitui o pico/binary_info.h do SDK nos testes no computador
@@ -0,0 +1,14 @@
+#include <arpa/inet.h>
+
+#include "pico/cyw43_arch.h"
+
+cyw43_t cyw43_state;
+static struct netif loopback = { { 0x0100007f } };
+struct netif *netif_list = &loopback;
+int mock_wifi_link = CYW43_LINK_UP;
+uint32_t mock_wifi_connect_attempts;
+
+const char *ip4addr_ntoa(const ip_addr_t *addr) {
+    struct in_addr in = { .s_addr = addr->addr };
+    return inet_ntoa(in);
+}
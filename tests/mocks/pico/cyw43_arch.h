@@ -0,0 +1,57 @@
+// Substitui o pico/cyw43_arch.h nos testes no computador: o WiFi está sempre conectado, a não ser
+// que o teste mude mock_wifi_link, e a pilha TCP é a do lwip/tcp.h simulado
+#ifndef MOCK_PICO_CYW43_ARCH_H
+#define MOCK_PICO_CYW43_ARCH_H
+
+#include "pico/stdlib.h"
+#include "lwip/ip_addr.h"
+
+#define CYW43_AUTH_WPA2_AES_PSK 0x00400004
+#define CYW43_ITF_STA 0
+#define CYW43_LINK_DOWN 0
+#define CYW43_LINK_UP 3
+
+typedef struct {
+    int link;
+} cyw43_t;
+
+struct netif {
+    ip_addr_t ip_addr;
+};
+
+extern cyw43_t cyw43_state;
+extern struct netif *netif_list;
+extern int mock_wifi_link;                  // Estado do link devolvido por cyw43_tcpip_link_status()
+extern uint32_t mock_wifi_connect_attempts; // Chamadas de cyw43_arch_wifi_connect_async()
+
+static inline int cyw43_arch_init(void) { return 0; }
+static inline void cyw43_arch_enable_sta_mode(void) {}
+static inline void cyw43_arch_lwip_begin(void) {}
+static inline void cyw43_arch_lwip_end(void) {}
+
+static inline int cyw43_arch_wifi_connect_timeout_ms(const char *ssid, const char *pw, uint32_t auth, uint32_t timeout) {
+    (void)ssid;
+    (void)pw;
+    (void)auth;
+    (void)timeout;
+    return mock_wifi_link == CYW43_LINK_UP ? 0 : PICO_ERROR_TIMEOUT;
+}
+
+static inline int cyw43_arch_wifi_connect_async(const char *ssid, const char *pw, uint32_t auth) {
+    (void)ssid;
+    (void)pw;
+    (void)auth;
+    mock_wifi_connect_attempts++;
+    return 0;
+}
+
+static inline int cyw43_tcpip_link_status(cyw43_t *self, int itf) {
+    (void)self;
+    (void)itf;
+    return mock_wifi_link;
+}
+
+static inline const ip_addr_t *netif_ip4_addr(const struct netif *netif) { return &netif->ip_addr; }
+const char *ip4addr_ntoa(const ip_addr_t *addr);
+
+#endif // MOCK_PICO_CYW43_ARCH_H
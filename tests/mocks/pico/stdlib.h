@@ -0,0 +1,55 @@
+// Substitui o pico/stdlib.h do SDK nos testes no computador
+#ifndef MOCK_PICO_STDLIB_H
+#define MOCK_PICO_STDLIB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PICO_ERROR_GENERIC -1
+#define PICO_ERROR_TIMEOUT -2
+
+#define GPIO_FUNC_I2C 3
+
+typedef unsigned int uint;
+
+// O DMA simulado só avança enquanto o código espera por ele
+void mock_dma_finish(void);
+static inline void tight_loop_contents(void) { mock_dma_finish(); }
+
+// Relógio e timers simulados: o tempo só avança em mock_time_advance_us(), que chama os timers vencidos
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+
+struct repeating_timer {
+    int64_t delay_us;
+    uint64_t next_us;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+uint64_t time_us_64(void);
+static inline uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+
+typedef uint64_t absolute_time_t;
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return time_us_64() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + (uint64_t)ms * 1000; }
+static inline bool time_reached(absolute_time_t t) { return time_us_64() >= t; }
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t alarm_id);
+void mock_time_advance_us(uint64_t us);
+uint32_t mock_time_wakeups(void);               // Timers e alarmes chamados desde o início
+
+static inline void gpio_set_function(uint gpio, int fn) { (void)gpio; (void)fn; }
+static inline void gpio_pull_up(uint gpio) { (void)gpio; }
+
+#endif // MOCK_PICO_STDLIB_H
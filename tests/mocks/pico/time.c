@@ -0,0 +1,127 @@
+#include "pico/stdlib.h"
+
+#define MOCK_TIMERS 8
+
+typedef struct {
+    uint64_t at_us;
+    alarm_callback_t callback;
+    void *user_data;
+} mock_alarm_t;
+
+static uint64_t now_us;
+static repeating_timer_t *timers[MOCK_TIMERS];
+static mock_alarm_t alarms[MOCK_TIMERS];
+static uint32_t wakeups;
+
+uint64_t time_us_64(void) {
+    return now_us;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data, repeating_timer_t *out) {
+    for (int i = 0; i < MOCK_TIMERS; i++) {
+        if (timers[i] == NULL) {
+            out->delay_us = (int64_t)delay_ms * 1000;
+            out->next_us = now_us + out->delay_us;
+            out->callback = callback;
+            out->user_data = user_data;
+            timers[i] = out;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    for (int i = 0; i < MOCK_TIMERS; i++) {
+        if (timers[i] == timer) {
+            timers[i] = NULL;
+            return true;
+        }
+    }
+    return false;
+}
+
+// O identificador de um alarme é a posição mais um; 0 indica falha, como no SDK
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    (void)fire_if_past;
+
+    for (int i = 0; i < MOCK_TIMERS; i++) {
+        if (alarms[i].callback == NULL) {
+            alarms[i].at_us = now_us + us;
+            alarms[i].callback = callback;
+            alarms[i].user_data = user_data;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return add_alarm_in_us((uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    if (alarm_id <= 0 || alarm_id > MOCK_TIMERS || alarms[alarm_id - 1].callback == NULL) {
+        return false;
+    }
+    alarms[alarm_id - 1].callback = NULL;
+    return true;
+}
+
+/**
+ * @brief Avança o relógio simulado, chamando na ordem do tempo os timers e alarmes que vencerem
+ */
+void mock_time_advance_us(uint64_t us) {
+    uint64_t end = now_us + us;
+
+    for (;;) {
+        // Próximo evento até o fim do intervalo
+        uint64_t next = end + 1;
+        repeating_timer_t *timer = NULL;
+        int alarm = -1;
+
+        for (int i = 0; i < MOCK_TIMERS; i++) {
+            if (timers[i] && timers[i]->next_us < next) {
+                next = timers[i]->next_us;
+                timer = timers[i];
+                alarm = -1;
+            }
+            if (alarms[i].callback && alarms[i].at_us < next) {
+                next = alarms[i].at_us;
+                timer = NULL;
+                alarm = i;
+            }
+        }
+
+        if (next > end) {
+            break;
+        }
+        now_us = next;
+        wakeups++;
+
+        if (timer) {
+            timer->next_us += timer->delay_us;
+            if (!timer->callback(timer)) {
+                cancel_repeating_timer(timer);
+            }
+        } else {
+            // Como no SDK, o alarme continua ocupando sua posição enquanto o callback roda
+            alarms[alarm].at_us = UINT64_MAX;
+            int64_t again = alarms[alarm].callback(alarm + 1, alarms[alarm].user_data);
+            // Valor positivo: reagenda em microssegundos a partir de agora, se não foi cancelado
+            if (alarms[alarm].callback && alarms[alarm].at_us == UINT64_MAX) {
+                if (again > 0) {
+                    alarms[alarm].at_us = now_us + again;
+                } else {
+                    alarms[alarm].callback = NULL;
+                }
+            }
+        }
+    }
+
+    now_us = end;
+}
+
+uint32_t mock_time_wakeups(void) {
+    return wakeups;
+}
@@ -0,0 +1,235 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "stub_server.h"
+
+#define STUB_BUFFER_SIZE (STUB_BODY_MAX + 1024)
+
+static pthread_t thread;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile bool stopping;
+static int listen_fd = -1;
+
+static stub_config_t config;
+static stub_request_t *requests;
+static uint32_t request_count;
+static uint32_t connections;
+
+/**
+ * @brief Procura o fim do cabeçalho de uma requisição no buffer
+ * @return Tamanho do cabeçalho, incluindo a linha vazia, ou 0 se ainda não chegou inteiro
+ */
+static size_t header_length(const char *buf, size_t len) {
+    for (size_t i = 3; i < len; i++) {
+        if (memcmp(buf + i - 3, "\r\n\r\n", 4) == 0) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Lê o valor de Content-Length do cabeçalho
+ */
+static size_t content_length(const char *header, size_t len) {
+    const char *name = "\r\nContent-Length:";
+    size_t name_len = strlen(name);
+
+    for (size_t i = 0; i + name_len < len; i++) {
+        if (strncasecmp(header + i, name, name_len) == 0) {
+            return strtoul(header + i + name_len, NULL, 10);
+        }
+    }
+    return 0;
+}
+
+static void respond(int fd, const stub_config_t *cfg) {
+    const char *body = cfg->body ? cfg->body : "{}";
+    char response[1024];
+
+    if (cfg->delay_ms) {
+        struct timespec delay = { cfg->delay_ms / 1000, (cfg->delay_ms % 1000) * 1000000L };
+        nanosleep(&delay, NULL);
+    }
+
+    int len = snprintf(response, sizeof(response),
+                       "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n%s\r\n%s",
+                       cfg->status ? cfg->status : 200, (cfg->status == 0 || cfg->status == 200) ? "OK" : "Error",
+                       strlen(body), cfg->close_after_response ? "Connection: close\r\n" : "", body);
+    send(fd, response, len, MSG_NOSIGNAL);
+}
+
+/**
+ * @brief Trata as requisições completas do buffer, respondendo na ordem de chegada
+ * @return Bytes consumidos, -1 se a conexão deve ser fechada ou -2 se a resposta pediu o fechamento
+ */
+static long serve(int fd, const char *buf, size_t len) {
+    size_t used = 0;
+
+    for (;;) {
+        size_t head = header_length(buf + used, len - used);
+        if (head == 0) {
+            return used;
+        }
+        size_t body = content_length(buf + used, head);
+        if (len - used < head + body) {
+            return used;
+        }
+
+        pthread_mutex_lock(&lock);
+        stub_config_t cfg = config;
+        if (request_count < STUB_MAX_REQUESTS) {
+            stub_request_t *req = &requests[request_count];
+            const char *path = memchr(buf + used, ' ', head);
+            size_t path_len = 0;
+            if (path) {
+                path++;
+                while (path + path_len < buf + used + head && path[path_len] != ' ' && path_len < sizeof(req->path) - 1) {
+                    path_len++;
+                }
+                memcpy(req->path, path, path_len);
+            }
+            req->path[path_len] = '\0';
+            req->content_length = body;
+            req->body_len = body < STUB_BODY_MAX ? body : STUB_BODY_MAX;
+            memcpy(req->body, buf + used + head, req->body_len);
+        }
+        request_count++;
+        pthread_mutex_unlock(&lock);
+
+        used += head + body;
+        if (!cfg.silent) {
+            respond(fd, &cfg);
+            if (cfg.close_after_response) {
+                return -2;
+            }
+        }
+    }
+}
+
+static void *server_thread(void *arg) {
+    static char buf[STUB_BUFFER_SIZE];
+    size_t len = 0;
+    int client = -1;
+    bool draining = false;      // Resposta com "Connection: close" enviada, aguardando o fim da conexão
+
+    (void)arg;
+    while (!stopping) {
+        struct pollfd fds[2] = { { .fd = listen_fd, .events = POLLIN }, { .fd = client, .events = POLLIN } };
+        if (poll(fds, client >= 0 ? 2 : 1, 10) <= 0) {
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            // O dispositivo usa uma conexão por vez: uma nova substitui a anterior
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0) {
+                if (client >= 0) {
+                    close(client);
+                }
+                client = fd;
+                len = 0;
+                draining = false;
+                pthread_mutex_lock(&lock);
+                connections++;
+                pthread_mutex_unlock(&lock);
+            }
+            continue;
+        }
+
+        if (client >= 0 && (fds[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+            ssize_t n = recv(client, buf + len, sizeof(buf) - len, 0);
+            if (draining && n > 0) {
+                continue;   // Requisições enviadas depois do fechamento são descartadas, como num servidor real
+            }
+            long used = n > 0 ? serve(client, buf, len + n) : -1;
+            if (used == -2) {
+                // Fechamento gracioso: um close() com requisições não lidas mandaria RST, e o
+                // cliente poderia perder a resposta já enviada
+                shutdown(client, SHUT_WR);
+                draining = true;
+                len = 0;
+                continue;
+            }
+            if (used < 0 || (len + n == sizeof(buf) && used == 0)) {
+                close(client);
+                client = -1;
+                len = 0;
+                continue;
+            }
+            len += n - used;
+            memmove(buf, buf + used, len);
+        }
+    }
+
+    if (client >= 0) {
+        close(client);
+    }
+    return NULL;
+}
+
+uint16_t stub_server_start(void) {
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    socklen_t size = sizeof(addr);
+
+    requests = calloc(STUB_MAX_REQUESTS, sizeof(stub_request_t));
+    listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd < 0 || bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listen_fd, 4) != 0) {
+        perror("stub_server");
+        exit(1);
+    }
+    getsockname(listen_fd, (struct sockaddr *)&addr, &size);
+
+    stopping = false;
+    pthread_create(&thread, NULL, server_thread, NULL);
+    return ntohs(addr.sin_port);
+}
+
+void stub_server_stop(void) {
+    stopping = true;
+    pthread_join(thread, NULL);
+    close(listen_fd);
+    free(requests);
+}
+
+void stub_server_configure(const stub_config_t *cfg) {
+    pthread_mutex_lock(&lock);
+    config = *cfg;
+    request_count = 0;
+    pthread_mutex_unlock(&lock);
+}
+
+uint32_t stub_server_requests(void) {
+    pthread_mutex_lock(&lock);
+    uint32_t count = request_count;
+    pthread_mutex_unlock(&lock);
+    return count;
+}
+
+bool stub_server_request(uint32_t n, stub_request_t *out) {
+    bool found = false;
+
+    pthread_mutex_lock(&lock);
+    if (n < request_count && n < STUB_MAX_REQUESTS) {
+        *out = requests[n];
+        found = true;
+    }
+    pthread_mutex_unlock(&lock);
+    return found;
+}
+
+uint32_t stub_server_connections(void) {
+    pthread_mutex_lock(&lock);
+    uint32_t count = connections;
+    pthread_mutex_unlock(&lock);
+    return count;
+}
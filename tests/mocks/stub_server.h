@@ -0,0 +1,44 @@
+// Servidor HTTP mínimo no loopback, no lugar da API, para os testes do envio de alertas no computador.
+// Roda em uma thread própria, atende uma conexão por vez e guarda as requisições recebidas
+#ifndef STUB_SERVER_H
+#define STUB_SERVER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define STUB_MAX_REQUESTS 256
+#define STUB_BODY_MAX 8192
+
+// Requisição recebida pelo servidor
+typedef struct {
+    char path[64];
+    char body[STUB_BODY_MAX];
+    size_t body_len;
+    size_t content_length;      // Valor do cabeçalho Content-Length
+} stub_request_t;
+
+// Comportamento das respostas
+typedef struct {
+    int status;                 // Código de status, 200 se zero
+    uint32_t delay_ms;          // Atraso, em tempo real, antes de cada resposta
+    bool silent;                // Recebe as requisições e nunca responde
+    bool close_after_response;  // Responde com "Connection: close" e fecha a conexão
+    const char *body;           // Corpo JSON das respostas, "{}" se NULL
+} stub_config_t;
+
+// Inicia o servidor em uma porta livre do 127.0.0.1 e retorna a porta
+uint16_t stub_server_start(void);
+void stub_server_stop(void);
+
+// Troca o comportamento das próximas respostas e descarta as requisições guardadas
+void stub_server_configure(const stub_config_t *config);
+
+// Requisições recebidas desde stub_server_configure()
+uint32_t stub_server_requests(void);
+bool stub_server_request(uint32_t n, stub_request_t *out);
+
+// Conexões aceitas desde o início
+uint32_t stub_server_connections(void);
+
+#endif // STUB_SERVER_H
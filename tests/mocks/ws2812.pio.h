@@ -0,0 +1,18 @@
+// Substitui o header gerado pelo pico_generate_pio_header a partir do ws2812.pio
+#ifndef MOCK_WS2812_PIO_H
+#define MOCK_WS2812_PIO_H
+
+#include "hardware/pio.h"
+
+static const pio_program_t ws2812_program = { NULL, 0, -1 };
+
+static inline void ws2812_program_init(PIO pio, uint sm, uint offset, uint pin, float freq, bool rgbw) {
+    (void)pio;
+    (void)sm;
+    (void)offset;
+    (void)pin;
+    (void)freq;
+    (void)rgbw;
+}
+
+#endif // MOCK_WS2812_PIO_H
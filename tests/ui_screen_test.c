@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "hardware/dma.h"
+#include "utils/display_funcs.h"
+
+// Framebuffer de referência, desenhado com chamadas diretas ao driver como as telas eram desenhadas antes
+static uint8_t golden_buffer[128 * 8];
+static ssd1306_t golden = { .width = 128, .height = 64, .pages = 8, .buffer = golden_buffer, .bufsize = sizeof(golden_buffer) };
+
+static void golden_text(const char *text, uint32_t x, uint32_t y) {
+    ssd1306_draw_string(&golden, x, y, 1, text);
+}
+
+static void assert_matches_golden(void) {
+    for (uint32_t page = 0; page < golden.pages; page++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(golden.buffer + page * golden.width, display.buffer + page * display.width, golden.width);
+    }
+}
+
+static void golden_main_menu(int temp_min, int temp_max, int select_max) {
+    char text[32];
+
+    ssd1306_clear(&golden);
+    golden_text("=== MENU PRINCIPAL ===", 0, 0);
+    golden_text(select_max ? "> Ajustar Temp. MAX" : "  Ajustar Temp. MAX", 0, 16);
+    golden_text(select_max ? "  Ajustar Temp. MIN" : "> Ajustar Temp. MIN", 0, 28);
+    golden_text("Atual MAX: ", 0, 44);
+    sprintf(text, "%d C", temp_max);
+    golden_text(text, 80, 44);
+    golden_text("Atual MIN: ", 0, 56);
+    sprintf(text, "%d C", temp_min);
+    golden_text(text, 80, 56);
+}
+
+static void golden_set_temp(const char *title, int value) {
+    char text[32];
+
+    ssd1306_clear(&golden);
+    golden_text(title, 0, 0);
+    golden_text("Use joystick p/ ajustar", 0, 16);
+    sprintf(text, "Valor atual: %d C", value);
+    golden_text(text, 0, 28);
+    golden_text("ENTER para confirmar", 0, 44);
+    golden_text("BACK para cancelar", 0, 56);
+}
+
+static void golden_monitoring(int temperature, int temp_min, int temp_max, const char *status) {
+    char text[48];
+
+    ssd1306_clear(&golden);
+    sprintf(text, "Temperatura: %d graus", temperature);
+    golden_text(text, 0, 32);
+    sprintf(text, "Limites: %d a %d graus", temp_min, temp_max);
+    golden_text(text, 0, 12);
+    golden_text(status, 0, 44);
+}
+
+void setUp(void) {
+    TEST_ASSERT_EQUAL_INT(0, oled_display_init());
+    oled_pending = false;
+}
+
+void tearDown(void) {
+    ssd1306_deinit(&display);
+}
+
+static void main_menu_should_match_golden(void) {
+    static const int values[][2] = { {-8, 32}, {-20, 50}, {9, 10}, {-1, 0} };
+
+    for (int select = 1; select >= 0; select--) {
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            int temp_min = values[i][0], temp_max = values[i][1];
+
+            draw_main_menu(&temp_min, &temp_max, select);
+            golden_main_menu(temp_min, temp_max, select);
+            assert_matches_golden();
+        }
+    }
+}
+
+static void set_temp_screens_should_match_golden(void) {
+    for (int value = -20; value <= 50; value += 7) {
+        draw_set_temp_max(value);
+        golden_set_temp("== AJUSTE TEMP. MAX ==", value);
+        assert_matches_golden();
+
+        draw_set_temp_min(value);
+        golden_set_temp("== AJUSTE TEMP. MIN ==", value);
+        assert_matches_golden();
+    }
+}
+
+static void monitoring_screens_should_match_golden(void) {
+    draw_monitoring(25, -8, 32, "");
+    golden_monitoring(25, -8, 32, "");
+    assert_matches_golden();
+
+    draw_monitoring(-12, -8, 32, "Temperatura BAIXA!");
+    golden_monitoring(-12, -8, 32, "Temperatura BAIXA!");
+    assert_matches_golden();
+
+    draw_monitoring(40, -20, 35, "Temperatura ALTA!");
+    golden_monitoring(40, -20, 35, "Temperatura ALTA!");
+    assert_matches_golden();
+
+    draw_monitoring(7, -20, 35, "");
+    golden_monitoring(7, -20, 35, "");
+    assert_matches_golden();
+
+    draw_sensor_error();
+    ssd1306_clear(&golden);
+    golden_text("Erro ao ler sensor!", 0, 24);
+    golden_text("Verifique conexoes!", 0, 36);
+    assert_matches_golden();
+}
+
+static void screen_switch_should_follow_direct_writes(void) {
+    int temp_min = -8, temp_max = 32;
+
+    draw_main_menu(&temp_min, &temp_max, 1);
+    oled_write("Sistema inicializado!", 0, 24);
+
+    // A mesma tela, mas o framebuffer foi alterado fora do modelo
+    draw_main_menu(&temp_min, &temp_max, 1);
+    golden_main_menu(temp_min, temp_max, 1);
+    assert_matches_golden();
+}
+
+static void navigation_should_redraw_only_changed_cells(void) {
+    int temp_min = -8, temp_max = 32;
+
+    draw_main_menu(&temp_min, &temp_max, 1);
+
+    ui_set_text(&ui, MAIN_MENU_CURSOR_MAX, "");
+    ui_set_text(&ui, MAIN_MENU_CURSOR_MIN, ">");
+    TEST_ASSERT_EQUAL_UINT(2, ui_render(&ui, &display));
+
+    ui_set_int(&ui, MAIN_MENU_VALUE_MAX, 33, " C");
+    TEST_ASSERT_EQUAL_UINT(1, ui_render(&ui, &display));
+
+    // Valor igual ao atual não marca nada para redesenho
+    ui_set_int(&ui, MAIN_MENU_VALUE_MAX, 33, " C");
+    TEST_ASSERT_EQUAL_UINT(0, ui_render(&ui, &display));
+
+    // "9 C" -> "10 C": todas as células mudam, inclusive a que fica em branco
+    ui_set_int(&ui, MAIN_MENU_VALUE_MIN, 9, " C");
+    ui_render(&ui, &display);
+    ui_set_int(&ui, MAIN_MENU_VALUE_MIN, 10, " C");
+    TEST_ASSERT_EQUAL_UINT(4, ui_render(&ui, &display));
+
+    golden_main_menu(10, 33, 0);
+    assert_matches_golden();
+}
+
+static void navigation_cost(void) {
+    int temp_min = -8, temp_max = 32;
+    const int rounds = 10000;
+
+    draw_main_menu(&temp_min, &temp_max, 1);
+
+    clock_t start = clock();
+    for (int i = 0; i < rounds; i++) {
+        ui_set_text(&ui, MAIN_MENU_CURSOR_MAX, i & 1 ? ">" : "");
+        ui_set_text(&ui, MAIN_MENU_CURSOR_MIN, i & 1 ? "" : ">");
+        ui_render(&ui, &display);
+    }
+    double us = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC / rounds;
+
+    printf("troca de opção no menu: %.2f us por quadro no computador\n", us);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(main_menu_should_match_golden);
+    RUN_TEST(set_temp_screens_should_match_golden);
+    RUN_TEST(monitoring_screens_should_match_golden);
+    RUN_TEST(screen_switch_should_follow_direct_writes);
+    RUN_TEST(navigation_should_redraw_only_changed_cells);
+    RUN_TEST(navigation_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "hardware/dma.h"
+#include "ws2812b_animation.h"
+
+#define STEP_US 20000                                   // Passo padrão das animações, 50 fps
+
+/**
+ * @brief Conversão de referência, em float, como ws2812b_hsv() era calculada
+ */
+static uGRB32_t reference_hsv(float _h, float _s, float _v) {
+    float r = 0, g = 0, b = 0;
+
+    float h = _h / 360;
+    float s = _s / 100;
+    float v = _v / 100;
+
+    int i = h * 6;
+    float f = h * 6 - i;
+    float p = v * (1 - s);
+    float q = v * (1 - f * s);
+    float t = v * (1 - (1 - f) * s);
+
+    switch (i % 6) {
+        case 0: r = v, g = t, b = p; break;
+        case 1: r = q, g = v, b = p; break;
+        case 2: r = p, g = v, b = t; break;
+        case 3: r = p, g = q, b = v; break;
+        case 4: r = t, g = p, b = v; break;
+        case 5: r = v, g = p, b = q; break;
+    }
+
+    return ((uint32_t)(r * 255) << 8) | ((uint32_t)(g * 255) << 16) | (uint32_t)(b * 255);
+}
+
+/**
+ * @brief Maior diferença entre os canais de duas cores
+ */
+static uint32_t channel_error(uGRB32_t a, uGRB32_t b) {
+    uint32_t worst = 0;
+
+    for (int shift = 0; shift < 24; shift += 8) {
+        int d = (int)((a >> shift) & 0xff) - (int)((b >> shift) & 0xff);
+        uint32_t e = d < 0 ? -d : d;
+        if (e > worst) worst = e;
+    }
+    return worst;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static void hsv8_should_match_float_for_all_inputs(void) {
+    uint32_t worst = 0, exact = 0;
+
+    for (uint32_t h = 0; h < 256; h++) {
+        for (uint32_t s = 0; s < 256; s++) {
+            for (uint32_t v = 0; v < 256; v++) {
+                uGRB32_t expected = reference_hsv(h * 360.0f / 256, s * 100.0f / 255, v * 100.0f / 255);
+                uint32_t e = channel_error(expected, ws2812b_hsv8(h, s, v));
+                if (e > worst) worst = e;
+                exact += e == 0;
+            }
+        }
+    }
+
+    printf("ws2812b_hsv8: erro máximo %u, %.2f%% idênticas\n", worst, exact * 100.0 / (1 << 24));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1, worst);
+}
+
+static void hsv_should_match_float_for_whole_units(void) {
+    uint32_t worst = 0;
+
+    for (int h = 0; h <= 360; h++) {
+        for (int s = 0; s <= 100; s++) {
+            for (int v = 0; v <= 100; v++) {
+                uint32_t e = channel_error(reference_hsv(h, s, v), ws2812b_hsv(h, s, v));
+                if (e > worst) worst = e;
+            }
+        }
+    }
+
+    // Frações também
+    for (int n = 0; n < 1000000; n++) {
+        float h = rand() % 36000 / 100.0f, s = rand() % 10000 / 100.0f, v = rand() % 10000 / 100.0f;
+        uint32_t e = channel_error(reference_hsv(h, s, v), ws2812b_hsv(h, s, v));
+        if (e > worst) worst = e;
+    }
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1, worst);
+    TEST_ASSERT_EQUAL_HEX32(GRB_RED, ws2812b_hsv(360.0f, 100.0f, 100.0f));
+    TEST_ASSERT_EQUAL_HEX32(0, ws2812b_hsv(-5.0f, 100.0f, -1.0f));
+}
+
+static void random_colors_should_be_saturated(void) {
+    for (int n = 0; n < 10000; n++) {
+        uGRB32_t c = ws2812b_random_color(100.0f);
+        uint8_t g = (c >> 16) & 0xff, r = (c >> 8) & 0xff, b = c & 0xff;
+
+        // Saturação máxima: um canal no máximo e outro apagado
+        TEST_ASSERT_TRUE(r == 255 || g == 255 || b == 255);
+        TEST_ASSERT_TRUE(r == 0 || g == 0 || b == 0);
+    }
+}
+
+static void fade_should_match_percent_scaling(void) {
+    for (uint32_t c = 0; c < 256; c += 3) {
+        uint8_t r = c, g = 255 - c, b = (c + 1) % 256;
+        const uGRB32_t colors[8] = { ws2812b_rgb(r, g, b) };
+
+        ws2812b_animate(0, 0, FX_FADE, colors, 1, 0);
+        // O quadro de cada passo sai logo depois do passo
+        mock_time_advance_us(2000);
+        for (uint32_t brightness = 0; brightness <= 100; brightness++) {
+            mock_pio_reset(pio0);
+            mock_time_advance_us(STEP_US);
+            mock_dma_finish();
+
+            uGRB32_t expected = ws2812b_rgb(r * brightness / 100, g * brightness / 100, b * brightness / 100);
+            TEST_ASSERT_EQUAL_UINT32(1, mock_pio0.count[0]);
+            TEST_ASSERT_EQUAL_HEX32(expected << 8, mock_pio0.words[0][0]);
+        }
+        mock_time_advance_us(5 * STEP_US);
+        mock_dma_finish();
+    }
+}
+
+/**
+ * @brief Tempo por conversão no computador, em nanossegundos
+ */
+static double ns_per_color(uGRB32_t (*convert)(uint32_t n)) {
+    const uint32_t rounds = 5000000;
+    volatile uGRB32_t sink = 0;
+
+    clock_t start = clock();
+    for (uint32_t n = 0; n < rounds; n++) {
+        sink = convert(n);
+    }
+    (void)sink;
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / rounds;
+}
+
+static uGRB32_t convert_reference(uint32_t n) { return reference_hsv(n % 360, 100.0f, 50.0f); }
+static uGRB32_t convert_float_api(uint32_t n) { return ws2812b_hsv(n % 360, 100.0f, 50.0f); }
+static uGRB32_t convert_hsv8(uint32_t n) { return ws2812b_hsv8(n, 255, 128); }
+
+static void hsv_cost(void) {
+    printf("HSV em float (antes):         %6.2f ns por cor no computador\n", ns_per_color(convert_reference));
+    printf("ws2812b_hsv, ponto fixo:      %6.2f ns por cor no computador\n", ns_per_color(convert_float_api));
+    printf("ws2812b_hsv8, só inteiros:    %6.2f ns por cor no computador\n", ns_per_color(convert_hsv8));
+}
+
+int main(void) {
+    ws2812b_init(pio0, 7, 1);
+    srand(1);
+
+    UNITY_BEGIN();
+    RUN_TEST(hsv8_should_match_float_for_all_inputs);
+    RUN_TEST(hsv_should_match_float_for_whole_units);
+    RUN_TEST(random_colors_should_be_saturated);
+    RUN_TEST(fade_should_match_percent_scaling);
+    RUN_TEST(hsv_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "hardware/dma.h"
+#include "ws2812b_animation.h"
+
+#define NUM_PIXELS 25                                   // Matriz 5x5 da placa
+#define STEP_US 20000                                   // Passo padrão das animações, 50 fps
+#define SLICE_US 1000
+
+static uGRB32_t shown[NUM_PIXELS];                      // Último quadro recebido pela fita
+static uint32_t frames;                                 // Quadros recebidos desde o início do teste
+static FX_t *running[MAX_EFFECTS];
+
+/**
+ * @brief Avança o relógio em fatias, concluindo o DMA como a fita faria e guardando o último quadro
+ */
+static void run_us(uint64_t us) {
+    for (uint64_t t = 0; t < us; t += SLICE_US) {
+        mock_time_advance_us(SLICE_US);
+        mock_dma_finish();
+
+        uint32_t count = mock_pio0.count[0];
+        if (count >= NUM_PIXELS) {
+            for (uint32_t i = 0; i < NUM_PIXELS; i++) {
+                shown[i] = mock_pio0.words[0][count - NUM_PIXELS + i] >> 8;
+            }
+            frames += count / NUM_PIXELS;
+            mock_pio_reset(pio0);
+        }
+    }
+}
+
+/**
+ * @brief Inicia um efeito que pinta o intervalo com uma cor fixa a cada passo, até ser cancelado
+ */
+static FX_t *solid(uint32_t from, uint32_t to, uGRB32_t grb) {
+    const uGRB32_t colors[8] = { grb, grb };
+    FX_t *FX = ws2812b_animate(from, to, FX_BLINK, colors, 0, 0);
+
+    for (int i = 0; i < MAX_EFFECTS; i++) {
+        if (running[i] == NULL) {
+            running[i] = FX;
+            break;
+        }
+    }
+    return FX;
+}
+
+void setUp(void) {
+    frames = 0;
+}
+
+void tearDown(void) {
+    for (int i = 0; i < MAX_EFFECTS; i++) {
+        if (running[i]) {
+            ws2812b_cancel(running[i]);
+            running[i] = NULL;
+        }
+    }
+    run_us(2 * STEP_US);
+    ws2812b_clear();
+    run_us(2 * STEP_US);
+    frames = 0;
+}
+
+static void overlapping_effects_should_share_frames(void) {
+    solid(0, 9, GRB_RED);
+    run_us(3000);
+    const uGRB32_t colors[8] = { GRB_GREEN, GRB_BLUE };
+    running[1] = ws2812b_animate(5, 14, FX_CHASER, colors, 0, 0);
+    run_us(3000);
+    solid(10, 24, GRB_WHITE);
+
+    frames = 0;
+    run_us(1000000);
+
+    // Um quadro por passo, com os três efeitos, e nenhum passo perdido
+    TEST_ASSERT_UINT32_WITHIN(1, 1000000 / STEP_US, frames);
+}
+
+static void blend_modes_should_composite_in_order(void) {
+    static const struct {
+        FX_blend_t blend;
+        uint8_t alpha;
+        uint8_t r, g, b;
+    } cases[] = {
+        { FX_BLEND_REPLACE, 255, 100, 100, 100 },
+        { FX_BLEND_ADD,     255, 150, 255, 100 },
+        { FX_BLEND_MAX,     255, 100, 200, 100 },
+        { FX_BLEND_ALPHA,    64,  63, 175,  25 },
+        { FX_BLEND_ALPHA,     0,  50, 200,   0 },
+    };
+
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++) {
+        ws2812b_fill_all(ws2812b_rgb(1, 2, 3));
+        solid(0, 19, ws2812b_rgb(50, 200, 0));
+        FX_t *top = solid(10, 24, ws2812b_rgb(100, 100, 100));
+        ws2812b_set_blend(top, cases[k].blend, cases[k].alpha);
+        run_us(STEP_US + SLICE_US);
+
+        TEST_ASSERT_EQUAL_HEX32(ws2812b_rgb(50, 200, 0), shown[0]);
+        TEST_ASSERT_EQUAL_HEX32(ws2812b_rgb(cases[k].r, cases[k].g, cases[k].b), shown[15]);
+        // Acima do buffer, com o que ficou abaixo do efeito de cima
+        uGRB32_t above_base = cases[k].blend == FX_BLEND_REPLACE ? ws2812b_rgb(100, 100, 100)
+                            : cases[k].blend == FX_BLEND_ADD ? ws2812b_rgb(101, 102, 103)
+                            : cases[k].blend == FX_BLEND_MAX ? ws2812b_rgb(100, 100, 100)
+                            : cases[k].alpha == 0 ? ws2812b_rgb(1, 2, 3) : ws2812b_rgb(26, 27, 27);
+        TEST_ASSERT_EQUAL_HEX32(above_base, shown[22]);
+
+        tearDown();
+    }
+}
+
+static void pool_should_run_more_than_four_effects(void) {
+    for (uint32_t i = 0; i < MAX_EFFECTS; i++) {
+        solid(i, i, ws2812b_rgb(10 * (i + 1), 0, 0));
+    }
+    run_us(STEP_US + SLICE_US);
+
+    TEST_ASSERT_GREATER_THAN(4, MAX_EFFECTS);
+    for (uint32_t i = 0; i < MAX_EFFECTS; i++) {
+        TEST_ASSERT_EQUAL_HEX32(ws2812b_rgb(10 * (i + 1), 0, 0), shown[i]);
+    }
+}
+
+static void ended_effects_should_merge_or_clear(void) {
+    const uGRB32_t base = ws2812b_rgb(0, 0, 50);
+    const uGRB32_t colors[8] = { GRB_RED, GRB_GREEN };
+
+    ws2812b_fill_all(base);
+    ws2812b_render();
+
+    // A varredura some ao terminar; o preenchimento fica no buffer
+    ws2812b_animate(0, 9, FX_SCAN, colors, 1, 0);
+    ws2812b_animate(10, 24, FX_WIPE, colors, 1, 0);
+    run_us(20 * STEP_US);
+
+    for (uint32_t i = 0; i < NUM_PIXELS; i++) {
+        TEST_ASSERT_EQUAL_HEX32(i < 10 ? base : GRB_RED, shown[i]);
+    }
+
+    // Sem efeitos rodando, nada mais acorda a CPU
+    uint32_t wakeups = mock_time_wakeups();
+    run_us(1000000);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_time_wakeups() - wakeups);
+
+    // O resultado do preenchimento continua no buffer depois de outra renderização
+    ws2812b_render();
+    run_us(STEP_US);
+    TEST_ASSERT_EQUAL_HEX32(GRB_RED, shown[24]);
+}
+
+int main(void) {
+    ws2812b_init(pio0, 7, NUM_PIXELS);
+
+    UNITY_BEGIN();
+    RUN_TEST(overlapping_effects_should_share_frames);
+    RUN_TEST(blend_modes_should_composite_in_order);
+    RUN_TEST(pool_should_run_more_than_four_effects);
+    RUN_TEST(ended_effects_should_merge_or_clear);
+    return UNITY_END();
+}
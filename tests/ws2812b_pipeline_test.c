@@ -0,0 +1,328 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "hardware/dma.h"
+#include "ws2812b_animation.h"
+
+// A biblioteca só é inicializada uma vez por processo: o tamanho da fita vem da linha de comando
+#define MAX_PIXELS 1024
+#define TICK_US 5000                                    // Intervalo entre requisições nos testes
+
+static uint16_t num_pixels = 256;
+static uint32_t frame_us;
+
+static uGRB32_t colors[MAX_PIXELS];
+static uint8_t mask[MAX_PIXELS];
+static uint32_t expected[MAX_PIXELS];
+
+/**
+ * @brief Pipeline de referência, pixel a pixel, como render() fazia antes das tabelas
+ */
+static void reference_frame(bool inverted, uint8_t dimming, const uint8_t *pixel_mask) {
+    for (uint32_t i = 0; i < num_pixels; i++) {
+        uint8_t g = (colors[i] >> 16) & 0xff, r = (colors[i] >> 8) & 0xff, b = colors[i] & 0xff;
+        if (inverted) {
+            r = 255 - r, g = 255 - g, b = 255 - b;
+        }
+        r >>= dimming, g >>= dimming, b >>= dimming;
+        expected[i] = (ws2812b_rgb(r, g, b) * (pixel_mask ? pixel_mask[i] : 1)) << 8;
+    }
+}
+
+/**
+ * @brief Renderiza o buffer e entrega o quadro inteiro à state machine simulada
+ */
+static void send_frame(void) {
+    mock_pio_reset(pio0);
+    ws2812b_render();
+    mock_time_advance_us(frame_us + TICK_US);
+    mock_dma_finish();
+}
+
+void setUp(void) {
+    mock_dma_finish();
+    mock_time_advance_us(frame_us + TICK_US);
+    mock_dma_finish();
+}
+
+void tearDown(void) {
+    ws2812b_set_brightness(255);
+    ws2812b_clear_mask();
+    ws2812b_set_global_dimming(0);
+    ws2812b_set_inverted(false);
+}
+
+static void pipeline_should_match_reference(void) {
+    for (uint32_t i = 0; i < num_pixels; i++) {
+        // Bits acima das 24 cores são ignorados
+        colors[i] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        mask[i] = rand() % 2;
+    }
+
+    for (int inverted = 0; inverted <= 1; inverted++) {
+        for (uint8_t dimming = 0; dimming <= 7; dimming++) {
+            for (int masked = 0; masked <= 1; masked++) {
+                ws2812b_set_inverted(inverted);
+                ws2812b_set_global_dimming(dimming);
+                if (masked) {
+                    ws2812b_set_mask(mask);
+                } else {
+                    ws2812b_clear_mask();
+                }
+                for (uint32_t i = 0; i < num_pixels; i++) {
+                    ws2812b_put(i, colors[i]);
+                }
+
+                send_frame();
+                reference_frame(inverted, dimming, masked ? mask : NULL);
+                TEST_ASSERT_EQUAL_UINT32(num_pixels, mock_pio0.count[0]);
+                TEST_ASSERT_EQUAL_HEX32_ARRAY(expected, mock_pio0.words[0], num_pixels);
+            }
+        }
+    }
+}
+
+static void mask_should_be_read_when_set(void) {
+    for (uint32_t i = 0; i < num_pixels; i++) {
+        mask[i] = 1;
+    }
+    ws2812b_set_mask(mask);
+    ws2812b_fill_all(GRB_WHITE);
+
+    // Alterar o array depois de ws2812b_set_mask() não muda o quadro
+    memset(mask, 0, sizeof(mask));
+    send_frame();
+    TEST_ASSERT_EQUAL_HEX32(GRB_WHITE << 8, mock_pio0.words[0][num_pixels - 1]);
+
+    ws2812b_set_mask(mask);
+    send_frame();
+    TEST_ASSERT_EQUAL_HEX32(0, mock_pio0.words[0][num_pixels - 1]);
+}
+
+/**
+ * @brief Nível de 16 bits esperado para um canal com o brilho dado
+ */
+static uint32_t expected_level(uint8_t c, uint8_t brightness) {
+    return (uint32_t)(c * 256.0f * powf(brightness / 255.0f, WS2812B_GAMMA) + 0.5f);
+}
+
+static void dithering_should_average_to_level(void) {
+    static uint32_t sums[MAX_PIXELS][3];
+    static const uint8_t brightnesses[] = { 2, 28, 40, 128, 254 };
+    const uint32_t frames = 256;
+
+    for (size_t k = 0; k < sizeof(brightnesses) / sizeof(brightnesses[0]); k++) {
+        uint8_t brightness = brightnesses[k];
+
+        for (uint32_t i = 0; i < num_pixels; i++) {
+            colors[i] = ws2812b_rgb(rand() % 256, rand() % 256, i % 8);
+            ws2812b_put(i, colors[i]);
+        }
+        ws2812b_set_brightness(brightness);
+        memset(sums, 0, sizeof(sums));
+
+        // Uma requisição só: os quadros seguintes são enviados enquanto houver frações
+        send_frame();
+        for (uint32_t f = 0; f < frames; f++) {
+            TEST_ASSERT_EQUAL_UINT32(num_pixels, mock_pio0.count[0]);
+            for (uint32_t i = 0; i < num_pixels; i++) {
+                uint32_t word = mock_pio0.words[0][i];
+                sums[i][0] += word >> 24;
+                sums[i][1] += (word >> 16) & 0xff;
+                sums[i][2] += (word >> 8) & 0xff;
+            }
+            mock_pio_reset(pio0);
+            mock_time_advance_us(frame_us + TICK_US);
+            mock_dma_finish();
+        }
+
+        // Em 256 quadros, a soma dos valores de 8 bits difere do nível de 16 bits só pelas frações pendentes
+        for (uint32_t i = 0; i < num_pixels; i++) {
+            uint8_t channels[3] = { (colors[i] >> 16) & 0xff, (colors[i] >> 8) & 0xff, colors[i] & 0xff };
+            for (int ch = 0; ch < 3; ch++) {
+                uint32_t level = expected_level(channels[ch], brightness);
+                TEST_ASSERT_UINT32_WITHIN(1, level, sums[i][ch]);
+            }
+        }
+    }
+}
+
+static void frames_should_stop_without_fractions(void) {
+    ws2812b_fill_all(GRB_WHITE);
+    ws2812b_set_brightness(40);
+    send_frame();
+    mock_pio_reset(pio0);
+    mock_time_advance_us(frame_us + TICK_US);
+    TEST_ASSERT_EQUAL_UINT32(1, mock_dma_pending());
+    mock_dma_finish();
+
+    // Brilho máximo: nada a pontilhar, só o quadro requisitado é enviado
+    ws2812b_set_brightness(255);
+    send_frame();
+    TEST_ASSERT_EQUAL_HEX32(GRB_WHITE << 8, mock_pio0.words[0][0]);
+    mock_time_advance_us(10 * (frame_us + TICK_US));
+    TEST_ASSERT_EQUAL_UINT32(0, mock_dma_pending());
+
+    // Brilho zero também não tem frações
+    ws2812b_set_brightness(0);
+    send_frame();
+    TEST_ASSERT_EQUAL_HEX32(0, mock_pio0.words[0][0]);
+    mock_time_advance_us(10 * (frame_us + TICK_US));
+    TEST_ASSERT_EQUAL_UINT32(0, mock_dma_pending());
+}
+
+static void dithering_should_stop_on_static_frame(void) {
+    // Brilho do app: o verde da matriz tem fração, mas a tela parada não pode acordar a CPU
+    ws2812b_fill_all(GRB_GREEN);
+    ws2812b_set_brightness(28);
+    send_frame();
+
+    // Um ciclo de quadros pontilhados e o quadro final com os níveis arredondados
+    uint32_t frames = 1;
+    uint32_t last = mock_pio0.words[0][0];
+    while (mock_pio0.count[0] > 0 && frames < 1000) {
+        last = mock_pio0.words[0][0];
+        mock_pio_reset(pio0);
+        mock_time_advance_us(frame_us + TICK_US);
+        mock_dma_finish();
+        frames += mock_pio0.count[0] > 0;
+    }
+    TEST_ASSERT_EQUAL_UINT32(256 + 1, frames);
+    uint32_t green = (expected_level(255, 28) + 128) >> 8;
+    TEST_ASSERT_EQUAL_HEX32(green << 24, last);
+
+    uint32_t wakeups = mock_time_wakeups();
+    mock_time_advance_us(1000000);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_time_wakeups() - wakeups);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_dma_pending());
+
+    // Cores sem fração, como o preto, nem começam o ciclo
+    ws2812b_clear();
+    send_frame();
+    mock_pio_reset(pio0);
+    wakeups = mock_time_wakeups();
+    mock_time_advance_us(1000000);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_time_wakeups() - wakeups);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_pio0.count[0]);
+
+    // Uma nova requisição recomeça o ciclo
+    ws2812b_fill_all(GRB_GREEN);
+    send_frame();
+    mock_pio_reset(pio0);
+    mock_time_advance_us(frame_us + TICK_US);
+    TEST_ASSERT_EQUAL_UINT32(1, mock_dma_pending());
+    mock_dma_finish();
+}
+
+static void repeated_requests_should_not_restart_dithering(void) {
+    ws2812b_fill_all(GRB_GREEN);
+    ws2812b_set_brightness(28);
+
+    // O loop principal pede o mesmo quadro a cada 100 ms: só o primeiro ciclo é enviado,
+    // e ele termina bem antes de 300 quadros
+    const uint32_t loop_us = 100000;
+    const uint32_t run_us = 300 * (frame_us + TICK_US);
+    uint32_t frames = 0;
+    for (uint32_t t = 0; t < run_us; t += loop_us) {
+        ws2812b_render();
+        for (uint32_t elapsed = 0; elapsed < loop_us; elapsed += TICK_US) {
+            mock_pio_reset(pio0);
+            mock_time_advance_us(TICK_US);
+            mock_dma_finish();
+            frames += mock_pio0.count[0] / num_pixels;
+        }
+    }
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(256 + 1, frames);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_dma_pending());
+
+    uint32_t wakeups = mock_time_wakeups();
+    for (int i = 0; i < 10; i++) {
+        ws2812b_render();
+        mock_time_advance_us(loop_us);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, mock_time_wakeups() - wakeups);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_dma_pending());
+}
+
+/**
+ * @brief Mede quantos pixels por microssegundo o alarme de renderização prepara no computador.
+ * O DMA não é concluído, então só a preparação dos quadros entra na medida
+ */
+static double pixels_per_us(void) {
+    const uint32_t pixels = 20000000;
+    uint32_t frames = pixels / num_pixels;
+
+    clock_t start = clock();
+    for (uint32_t i = 0; i < frames; i++) {
+        // Um pixel muda a cada quadro; requisições sem mudança não preparam quadro nenhum
+        ws2812b_put(0, i);
+        ws2812b_render();
+        mock_time_advance_us(TICK_US);
+    }
+    double us = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC;
+
+    mock_dma_finish();
+    return us > 0 ? (double)frames * num_pixels / us : 0;
+}
+
+// Resultado lido a cada quadro de referência, para que o compilador não descarte o laço
+static volatile uint32_t reference_sink;
+
+static double reference_pixels_per_us(void) {
+    const uint32_t pixels = 20000000;
+    uint32_t frames = pixels / num_pixels;
+
+    clock_t start = clock();
+    for (uint32_t i = 0; i < frames; i++) {
+        reference_frame(true, 2, mask);
+        reference_sink = expected[i % num_pixels];
+    }
+    double us = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC;
+    return us > 0 ? (double)frames * num_pixels / us : 0;
+}
+
+static void pipeline_throughput(void) {
+    for (uint32_t i = 0; i < num_pixels; i++) {
+        mask[i] = i % 2;
+    }
+
+    printf("fita de %u pixels:\n", num_pixels);
+    printf("  pixel a pixel:             %8.1f pixels/us\n", reference_pixels_per_us());
+    printf("  sem transformação:         %8.1f pixels/us\n", pixels_per_us());
+    ws2812b_set_inverted(true);
+    ws2812b_set_global_dimming(2);
+    printf("  tabelas:                   %8.1f pixels/us\n", pixels_per_us());
+    ws2812b_set_mask(mask);
+    printf("  tabelas e máscara:         %8.1f pixels/us\n", pixels_per_us());
+    ws2812b_clear_mask();
+    ws2812b_set_brightness(40);
+    printf("  brilho com dithering:      %8.1f pixels/us\n", pixels_per_us());
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        num_pixels = atoi(argv[1]);
+    }
+    if (num_pixels == 0 || num_pixels > MAX_PIXELS) {
+        fprintf(stderr, "tamanho de fita inválido: 1 a %d pixels\n", MAX_PIXELS);
+        return 1;
+    }
+    frame_us = num_pixels * 30 + WS2812B_DELAY_US;      // 30 us por pixel a 800 kHz, mais o latch
+    ws2812b_init(pio0, 7, num_pixels);
+    srand(num_pixels);
+
+    UNITY_BEGIN();
+    RUN_TEST(pipeline_should_match_reference);
+    RUN_TEST(mask_should_be_read_when_set);
+    RUN_TEST(dithering_should_average_to_level);
+    RUN_TEST(frames_should_stop_without_fractions);
+    RUN_TEST(dithering_should_stop_on_static_frame);
+    RUN_TEST(repeated_requests_should_not_restart_dithering);
+    RUN_TEST(pipeline_throughput);
+    return UNITY_END();
+}
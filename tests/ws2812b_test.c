@@ -0,0 +1,219 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "unity/examples/unity_config.h"
+#include "unity/src/unity.h"
+#include "hardware/dma.h"
+#include "ws2812b_animation.h"
+
+#define NUM_PIXELS 256
+#define FRAME_US (NUM_PIXELS * 30 + WS2812B_DELAY_US)   // 30 us por pixel a 800 kHz, mais o latch
+#define TICK_US 5000                                    // Intervalo entre requisições nos testes
+
+/**
+ * @brief Palavras recebidas pela state machine da fita (a primeira do pio0)
+ */
+static uint32_t sent_words(void) {
+    return mock_pio0.count[0];
+}
+
+static void assert_frame_sent(uGRB32_t color) {
+    TEST_ASSERT_EQUAL_UINT32(NUM_PIXELS, sent_words());
+    for (uint32_t i = 0; i < NUM_PIXELS; i++) {
+        TEST_ASSERT_EQUAL_HEX32(color << 8, mock_pio0.words[0][i]);
+    }
+}
+
+void setUp(void) {
+    // Termina o quadro em andamento e o que aguardava por ele, esperando o latch de cada um
+    for (int i = 0; i < 2; i++) {
+        mock_dma_finish();
+        mock_time_advance_us(FRAME_US + TICK_US);
+    }
+    mock_dma_finish();
+    mock_pio_reset(pio0);
+}
+
+void tearDown(void) {
+}
+
+static void frame_should_be_sent_by_dma(void) {
+    ws2812b_fill_all(GRB_RED);
+    ws2812b_render();
+    TEST_ASSERT_EQUAL_UINT32(0, sent_words());
+
+    // O alarme prepara o quadro e inicia o DMA, sem escrever na FIFO
+    mock_time_advance_us(WS2812B_COALESCE_US);
+    TEST_ASSERT_EQUAL_UINT32(1, mock_dma_pending());
+    TEST_ASSERT_EQUAL_UINT32(0, sent_words());
+
+    mock_dma_finish();
+    assert_frame_sent(GRB_RED);
+
+    // Sem nova requisição, nada mais é enviado
+    mock_time_advance_us(10 * TICK_US);
+    TEST_ASSERT_EQUAL_UINT32(NUM_PIXELS, sent_words());
+}
+
+static void requests_should_share_one_frame(void) {
+    uint32_t wakeups = mock_time_wakeups();
+
+    for (int i = 0; i < 10; i++) {
+        ws2812b_put(i, GRB_BLUE);
+        ws2812b_render();
+    }
+    mock_time_advance_us(WS2812B_COALESCE_US);
+    TEST_ASSERT_EQUAL_UINT32(1, mock_dma_pending());
+    TEST_ASSERT_EQUAL_UINT32(1, mock_time_wakeups() - wakeups);
+}
+
+static void static_strip_should_not_wake_cpu(void) {
+    ws2812b_fill_all(GRB_GREEN);
+    ws2812b_render();
+    mock_time_advance_us(FRAME_US);
+    mock_dma_finish();
+
+    // Uma hora sem requisições
+    uint32_t wakeups = mock_time_wakeups();
+    for (int i = 0; i < 3600; i++) {
+        mock_time_advance_us(1000000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, mock_time_wakeups() - wakeups);
+}
+
+static void unchanged_requests_should_be_dropped(void) {
+    ws2812b_fill_all(GRB_GREEN);
+    ws2812b_render();
+    mock_time_advance_us(FRAME_US);
+    mock_dma_finish();
+    mock_pio_reset(pio0);
+
+    // O mesmo quadro requisitado a cada iteração do loop principal
+    uint32_t wakeups = mock_time_wakeups();
+    for (int i = 0; i < 100; i++) {
+        ws2812b_fill_all(GRB_GREEN);
+        ws2812b_render();
+        mock_time_advance_us(100000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, mock_time_wakeups() - wakeups);
+    TEST_ASSERT_EQUAL_UINT32(0, sent_words());
+
+    // Mudanças nas configurações enviam o quadro de novo, mesmo com o buffer igual
+    ws2812b_set_global_dimming(1);
+    ws2812b_render();
+    mock_time_advance_us(WS2812B_COALESCE_US);
+    mock_dma_finish();
+    assert_frame_sent(ws2812b_rgb(0, 0xff >> 1, 0));
+    ws2812b_set_global_dimming(0);
+}
+
+static void frame_in_flight_should_not_change(void) {
+    ws2812b_fill_all(GRB_RED);
+    ws2812b_render();
+    mock_time_advance_us(WS2812B_COALESCE_US);
+
+    // Novo quadro preparado durante o envio, no outro buffer
+    ws2812b_fill_all(GRB_BLUE);
+    ws2812b_render();
+    mock_time_advance_us(WS2812B_COALESCE_US);
+    TEST_ASSERT_EQUAL_UINT32(1, mock_dma_pending());
+
+    mock_dma_finish();
+    assert_frame_sent(GRB_RED);
+
+    // O quadro que aguardava sai depois do latch, sem nova requisição
+    mock_pio_reset(pio0);
+    mock_time_advance_us(FRAME_US);
+    mock_dma_finish();
+    assert_frame_sent(GRB_BLUE);
+}
+
+static void next_frame_should_wait_for_latch(void) {
+    ws2812b_fill_all(GRB_GREEN);
+    ws2812b_render();
+    mock_time_advance_us(WS2812B_COALESCE_US);
+    mock_dma_finish();
+
+    // O DMA terminou, mas a fita ainda está recebendo o quadro anterior
+    ws2812b_fill_all(GRB_BLUE);
+    ws2812b_render();
+    mock_time_advance_us(FRAME_US - 1);
+    TEST_ASSERT_EQUAL_UINT32(0, mock_dma_pending());
+
+    mock_time_advance_us(1);
+    TEST_ASSERT_EQUAL_UINT32(1, mock_dma_pending());
+}
+
+static void frames_should_not_exceed_strip_rate(void) {
+    uint32_t starts = 0;
+
+    // Requisições a cada tick, por um segundo
+    for (uint32_t t = 0; t < 1000000; t += TICK_US) {
+        ws2812b_put(t / TICK_US % NUM_PIXELS, GRB_WHITE);
+        ws2812b_render();
+        mock_time_advance_us(TICK_US);
+        starts += mock_dma_pending();
+        mock_dma_finish();
+    }
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(1000000 / FRAME_US + 1, starts);
+    TEST_ASSERT_EQUAL_UINT32(starts * NUM_PIXELS, sent_words());
+}
+
+static void pipeline_should_apply_dimming_inversion_and_mask(void) {
+    static uint8_t mask[NUM_PIXELS];
+
+    for (uint32_t i = 0; i < NUM_PIXELS; i++) {
+        mask[i] = i % 2;
+    }
+    ws2812b_set_mask(mask);
+    ws2812b_set_global_dimming(1);
+    ws2812b_set_inverted(true);
+    ws2812b_fill_all(ws2812b_rgb(0x20, 0xf0, 0x0f));
+    ws2812b_render();
+    mock_time_advance_us(WS2812B_COALESCE_US);
+    mock_dma_finish();
+
+    uGRB32_t expected = ws2812b_rgb((0xff - 0x20) >> 1, (0xff - 0xf0) >> 1, (0xff - 0x0f) >> 1);
+    for (uint32_t i = 0; i < NUM_PIXELS; i++) {
+        TEST_ASSERT_EQUAL_HEX32(i % 2 ? expected << 8 : 0, mock_pio0.words[0][i]);
+    }
+
+    ws2812b_clear_mask();
+    ws2812b_set_global_dimming(0);
+    ws2812b_set_inverted(false);
+}
+
+static void render_cost(void) {
+    const int frames = 2000;
+
+    clock_t start = clock();
+    for (int i = 0; i < frames; i++) {
+        // Um pixel muda a cada quadro; requisições sem mudança não preparam quadro nenhum
+        ws2812b_put(0, i);
+        ws2812b_render();
+        mock_time_advance_us(FRAME_US + TICK_US);
+        mock_dma_finish();
+    }
+    double us = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC / frames;
+
+    printf("matriz: %.2f us de CPU por quadro de %d pixels no computador\n", us, NUM_PIXELS);
+}
+
+int main(void) {
+    ws2812b_init(pio0, 7, NUM_PIXELS);
+
+    UNITY_BEGIN();
+    RUN_TEST(frame_should_be_sent_by_dma);
+    RUN_TEST(requests_should_share_one_frame);
+    RUN_TEST(static_strip_should_not_wake_cpu);
+    RUN_TEST(unchanged_requests_should_be_dropped);
+    RUN_TEST(frame_in_flight_should_not_change);
+    RUN_TEST(next_frame_should_wait_for_latch);
+    RUN_TEST(frames_should_not_exceed_strip_rate);
+    RUN_TEST(pipeline_should_apply_dimming_inversion_and_mask);
+    RUN_TEST(render_cost);
+    return UNITY_END();
+}
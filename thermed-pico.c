@@ -10,6 +10,8 @@
 #include "utils/led_matrix_funcs.h"   // Funcoes para controlar a matriz de LEDS
 #include "utils/display_funcs.h"      // Funcoes para controlar o display OLED
 #include "utils/connection_manager.h" // Funcoes para gerenciar o envio de alertas via wi-fi
+#include "utils/dht22_funcs.h"        // Leitura do DHT22 via PIO e DMA, sem bloquear o loop principal
+#include "utils/telemetry.h"          // Envio das leituras em lotes para a API
 
 #define BUTTON_ENTER 5
 #define BUTTON_BACK 6
@@ -50,6 +52,8 @@ int button_back_pressed = 0;
 int joystick_button_pressed = 0;
 int joystick_x_value = 0;
 int joystick_y_value = 0;
+int joystick_side_held = 0;         // Joystick ainda inclinado para o lado desde a última troca de tela
+int dashboard_mode = 0;             // Monitoramento exibido como painel com dígitos grandes e gráfico
 
 // Configurações de wi-fi e API
 wifi_config_t wifi_config = {
@@ -57,7 +61,8 @@ wifi_config_t wifi_config = {
     .senha = "tcs131728",            // SENHA da sua rede WIFI
     .api_host = "192.168.0.101",      // Host da API (placeholder)
     .api_port = 8080,                 // Porta da API
-    .api_url = "/alert"               // Endpoint da API
+    .api_url = "/alert",              // Endpoint da API
+    .telemetry_url = "/telemetry"     // Endpoint para os lotes de leituras
 };
 
 // Configurações para debounce do botão
@@ -130,9 +135,16 @@ void process_menu(SystemState *current_state, int *temp_max, int *temp_min){
     // Detectando movimento do joystick
     int joystick_up = joystick_y_value > 3000;
     int joystick_down = joystick_y_value < 1000;
+    int joystick_side = joystick_x_value > 3000 || joystick_x_value < 1000;
 
     switch (*current_state){
         case STATE_MONITORING:
+            // Joystick para o lado alterna entre a tela de texto e o painel
+            if (joystick_side && !joystick_side_held){
+                dashboard_mode = !dashboard_mode;
+            }
+            joystick_side_held = joystick_side;
+
             // Troca de contexto para o menu de calibração
             if (button_enter_pressed){
                 *current_state = STATE_MENU_MAIN;
@@ -236,109 +248,19 @@ void process_menu(SystemState *current_state, int *temp_max, int *temp_min){
     }
 }
 
-/**
- * @brief Função auxiliar para aguardar um nível lógico com timeout
- * @param[in] gpio O pino gpio associado à leitura com timeout
- * @param[in] level O nível esperado após o timeout
- * @param[in] timeout O tempo necessário para o timeout
- */
-bool wait_for_level_timeout(uint gpio, int level, absolute_time_t timeout) {
-    while (gpio_get(gpio) != level) {
-        if (time_reached(timeout)) {
-            return false;
-        }
-        // Pequena pausa para evitar consumo excessivo de CPU
-        tight_loop_contents();
-    }
-    return true;
-}
-
-/**
- * @brief Realiza a leitura da temperatura no sensor DHT22
- */
-void dht22_read(int *temperature) {
-    uint32_t data = 0;
-    static uint8_t bits[5] = {0};
-    static absolute_time_t timeout;
-
-    // Resetar os bits entre leituras
-    memset(bits, 0, sizeof(bits));
-
-    // Timeout para evitar loops infinitos
-    timeout = make_timeout_time_ms(2000);
-
-    // Configura o pino do sensor como saída e manda um pulso baixo
-    gpio_set_dir(DHT_PIN, GPIO_OUT);
-    gpio_put(DHT_PIN, 0);
-    sleep_ms(18);
-    gpio_put(DHT_PIN, 1);
-    sleep_us(40);
-
-    // Muda para entrada para receber dados
-    gpio_set_dir(DHT_PIN, GPIO_IN);
-
-    // Espera o sensor enviar algum dado
-    if (!wait_for_level_timeout(DHT_PIN, 0, timeout)){
-        *temperature = -1;
-        return;
-    }
-    
-    if (!wait_for_level_timeout(DHT_PIN, 1, timeout)){
-        *temperature = -1;
-        return;
-    }
-    
-    if (!wait_for_level_timeout(DHT_PIN, 0, timeout)){
-        *temperature = -1;
-        return;
-    }
-
-    // Lê 40 bits (5 bytes) de dados com timeout
-    for (int i = 0; i < 40; i++) {
-        // Aguarda o início do bit (nivel alto)
-        if (!wait_for_level_timeout(DHT_PIN, 1, timeout)){
-            *temperature = -1;
-            return;
-        }
-
-        // Medir a duracao do pulso alto para determinar se é 0 ou 1
-        absolute_time_t start = get_absolute_time();
-        
-        if (!wait_for_level_timeout(DHT_PIN, 0, timeout)){
-            *temperature = -1;
-            return;
-        }
-
-        uint32_t duration = absolute_time_diff_us(start, get_absolute_time());
-    
-        if (duration > 40) {
-            bits[i / 8] |= (1 << (7 - (i % 8)));
-        };
-    }
-
-    // Verificar checksum
-    uint8_t checksum = bits[0] + bits[1] + bits[2] + bits[3];
-    if (checksum != bits[4]){
-        *temperature = -1;
-        return;
-    }
-
-    *temperature = bits[2];
-}
-
 /**
  * @brief Faz o controle de alarmes com base nos valores de temperatura observados.
+ * @param[in] temp Última temperatura lida
+ * @param[in] sensor_ok false se a última leitura do sensor falhou
  */
-void check_temperature(int *temp) {
-    static char temperature_buffer[30];
+void check_temperature(int *temp, bool sensor_ok) {
     static int display_updated = 0;
 
-    if (*temp == -1 ){
-        // Código de erro - exibir apenas se não tiver sido mostrado antes
+    if (!sensor_ok){
+        // Código de erro - a tela só é redesenhada na troca, e a matriz só é atualizada na primeira vez
+        draw_sensor_error();
         if (!display_updated) {
             led_matrix_colorize(GRB_YELLOW);
-            oled_write("Erro ao ler sensor!", 0, 24);
-            oled_write_no_clear("Verifique conexoes!", 0, 36);
             display_updated = 1;
         }
         
@@ -354,12 +276,19 @@ void check_temperature(int *temp) {
     display_updated = 0;
 
     // printf("Temperatura: %d°C\n", *temp);
-    sprintf(temperature_buffer, "Temperatura: %d graus", *temp);
-    oled_write(temperature_buffer, 0, 32);
-    
-    // Exibe também os limites configurados
-    sprintf(temperature_buffer, "Limites: %d a %d graus", temp_min, temp_max);
-    oled_write_no_clear(temperature_buffer, 0, 12);
+    // Exibe também os limites configurados e, em alarme, qual limite foi violado.
+    // Só as células que mudaram desde a última leitura são redesenhadas
+    const char *status = "";
+    if (*temp >= temp_max) {
+        status = "Temperatura ALTA!";
+    } else if (*temp <= temp_min) {
+        status = "Temperatura BAIXA!";
+    }
+    if (dashboard_mode) {
+        draw_dashboard(*temp, temp_min, temp_max);
+    } else {
+        draw_monitoring(*temp, temp_min, temp_max, status);
+    }
 
     int temp_alarm = (*temp >= temp_max || *temp <= temp_min);
 
@@ -373,22 +302,17 @@ void check_temperature(int *temp) {
             // Limita os alarmes para serem mandados de 10 em 10 segundos
             if (current_alarm_time - last_wifi_attempt > 10 * 1000000){
                 last_wifi_attempt = current_alarm_time;
-                wifi_reconnect_if_needed(&wifi_config);
                 send_alert_json(&wifi_config, device_id, *temp, temp_max, temp_min);
             }
+            // Envia imediatamente as leituras que antecederam o alarme
+            telemetry_request_flush();
+
             // Alarmes são disparados
             buzzer_on();
             alarm_active = true;
             add_repeating_timer_us(ALARM_PULSE_INTERVAL, alarm_toggle_callback,NULL,&alarm_timer);
             printf("Opa toaqui\n");
         }
-        
-        // Mostra qual limite foi violado, o superior ou o inferior
-        if (*temp >= temp_max) {
-            oled_write_no_clear("Temperatura ALTA!", 0, 44);
-        } else {
-            oled_write_no_clear("Temperatura BAIXA!", 0, 44);
-        }
 
     } else if (alarm_active){
         buzzer_off();
@@ -410,7 +334,7 @@ void setup() {
     buzzer_init();
 
     printf("Inicializando DHT22...\n");
-    gpio_init(DHT_PIN);
+    dht22_init(pio1, DHT_PIN);
     
     printf("Inicializando matriz de LEDs...\n");
     led_matrix_init();
@@ -421,12 +345,14 @@ void setup() {
         printf("Tentando novamente...\n");
     }
     oled_write("Display inicializado!", 0, 32);
+    oled_commit();
 
     printf("Inicializando botões e joystick...\n");
     buttons_joystick_init();
     
     oled_write("Sistema inicializado!", 0, 24);
     oled_write_no_clear("Monitorando...", 0, 36);
+    oled_commit();
 
     wifi_init(&wifi_config);
     sleep_ms(1000); // Exibe a mensagem por 2 segundos
@@ -436,16 +362,38 @@ int main() {
     setup();
     setup_device_id();
     int temperature = 0;
+    bool sensor_ok = true;  // false depois de uma leitura com falha, até a próxima bem sucedida
 
 
     while (true) {
         read_buttons();
 
         process_menu(&current_state, &temp_max, &temp_min);
+        oled_poll(); // Quadro que aguardava o fim do envio anterior
+
+        // Avança o envio dos alertas e lotes de leituras pendentes sem bloquear o loop
+        telemetry_poll(&wifi_config, device_id);
+        alert_sender_poll(&wifi_config);
+
+        // Limites enviados pela API nas respostas; não interfere com uma edição em andamento no menu
+        if (current_state == STATE_MONITORING) {
+            api_take_remote_limits(&temp_max, &temp_min);
+        }
         
         if (current_state == STATE_MONITORING){
-            dht22_read(&temperature);
-            check_temperature(&temperature);
+            // Inicia uma nova leitura assim que a anterior terminar e o sensor permitir
+            dht22_status_t status = dht22_poll(&temperature);
+            if (status == DHT22_OK){
+                sensor_ok = true;
+                telemetry_record(temperature);
+                oled_record_sample(temperature);
+            } else if (status == DHT22_ERROR_TIMEOUT || status == DHT22_ERROR_CHECKSUM){
+                sensor_ok = false;
+            }
+            if (status != DHT22_BUSY){
+                dht22_start();
+            }
+            check_temperature(&temperature, sensor_ok);
         }
 
         sleep_ms(100);
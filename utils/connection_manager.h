@@ -3,12 +3,25 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <strings.h>
 #include "pico/stdlib.h"
-#include "pico/cyw43_arch.h"    
+#include "pico/cyw43_arch.h"
 #include "lwip/pbuf.h"
 #include "lwip/tcp.h"
 #include "lwip/dns.h"
-#include "cJSON.h"
+#include "json_writer.h"
+#include "http_response.h"
+
+#define ALERT_QUEUE_SIZE 8              // Quantidade de alertas aguardando envio
+#define API_HEAD_MAX 128                // Linha da requisição e campos variáveis do cabeçalho (URL, Host, Content-Length)
+#define API_BODY_MAX 1024               // Tamanho máximo do corpo JSON de uma mensagem
+#define ALERT_REQUEST_TIMEOUT_MS 10000  // Prazo máximo de uma requisição (DNS + conexão + resposta)
+#define ALERT_RETRY_BASE_MS 1000        // Espera antes da primeira nova tentativa
+#define ALERT_RETRY_MAX_MS 60000        // Espera máxima entre tentativas
+#define ALERT_MAX_ATTEMPTS 8            // Tentativas antes de descartar um alerta
+#define WIFI_RECONNECT_INTERVAL_MS 10000 // Intervalo entre tentativas de reconexão do WiFi
+#define API_PIPELINE_DEPTH 4            // Requisições enviadas sem aguardar resposta na mesma conexão
+#define API_DNS_CACHE_TTL_MS 300000     // Validade do endereço resolvido do host da API
 
 // Estrutura para armazenar as configurações de conexão
 typedef struct {
@@ -17,21 +30,128 @@ typedef struct {
     char *api_host;
     uint16_t api_port;
     char *api_url;
+    char *telemetry_url;
 } wifi_config_t;
 
+/**
+ * @brief Tipos de mensagem enviados para a API
+ */
+typedef enum {
+    /* Alerta de temperatura fora dos limites, enviado para api_url */
+    MESSAGE_ALERT,
+
+    /* Lote de leituras de temperatura, enviado para telemetry_url */
+    MESSAGE_TELEMETRY
+} message_kind_t;
+
+/**
+ * @brief Estados da conexão persistente com a API
+ */
+typedef enum {
+    /* Sem conexão com a API */
+    SENDER_IDLE,
+
+    /* Aguardando a resolução DNS do host da API */
+    SENDER_RESOLVING,
+
+    /* Aguardando o estabelecimento da conexão TCP */
+    SENDER_CONNECTING,
+
+    /* Conexão aberta, sem requisições aguardando resposta */
+    SENDER_READY,
+
+    /* Conexão aberta, com requisições aguardando resposta */
+    SENDER_WAITING_RESPONSE
+} sender_state_t;
+
+// Contadores de uso da conexão com a API
+typedef struct {
+    uint32_t handshakes;        // Conexões TCP abertas
+    uint32_t handshakes_avoided; // Requisições enviadas em uma conexão já aberta
+    uint32_t dns_lookups;
+    uint32_t dns_cache_hits;
+    uint32_t requests_sent;
+    uint32_t responses_ok;
+} api_stats_t;
+
+/**
+ * @brief Chaves do JSON de resposta da API que interessam ao dispositivo
+ */
+typedef enum {
+    REPLY_KEY_OTHER,
+    REPLY_KEY_CONFIG,
+    REPLY_KEY_MAX_TEMPERATURE,
+    REPLY_KEY_MIN_TEMPERATURE
+} reply_key_t;
+
+// Limites de temperatura lidos do corpo JSON de uma resposta, sem montar a árvore do cJSON.
+// Só valem os que vêm no objeto "config": os alertas enviam maxTemperature e minTemperature
+// no objeto principal, e uma resposta que os repita não pode desfazer uma mudança feita no menu
+typedef struct {
+    int depth;                  // Profundidade atual no JSON
+    bool in_config;             // Dentro do objeto "config" do objeto principal
+    reply_key_t key;            // Chave do próximo valor
+    int temp_max;
+    int temp_min;
+    bool has_max;
+    bool has_min;
+} api_reply_t;
+
+// Trecho de uma requisição, entregue ao lwIP sem cópia
+typedef struct {
+    const char *data;
+    uint16_t len;
+} http_chunk_t;
+
+// Mensagem aguardando envio na fila. O lwIP envia direto destes buffers, que não podem mudar enquanto
+// a requisição estiver em andamento
+typedef struct {
+    char head[API_HEAD_MAX];            // Campos variáveis do cabeçalho
+    char body[API_BODY_MAX];            // JSON do corpo
+    uint16_t head_len;
+    uint16_t body_len;
+    message_kind_t kind;
+    uint8_t attempts;
+    absolute_time_t next_attempt;
+} alert_entry_t;
+
+// Fila de mensagens pendentes. As entradas não saem do lugar, já que o lwIP pode estar enviando
+// direto delas: a ordem de envio fica em order, onde os alertas passam à frente dos lotes de leituras
+typedef struct {
+    alert_entry_t entries[ALERT_QUEUE_SIZE + 1];   // Uma a mais para montar uma mensagem com a fila cheia
+    uint8_t order[ALERT_QUEUE_SIZE];    // Posições em entries, na ordem de envio
+    uint8_t count;
+    uint32_t dropped;
+} alert_queue_t;
+
 // Estrutura para armazenar os dados da conexão TCP
 typedef struct {
     struct tcp_pcb *pcb;
-    char *request;
-    uint16_t request_len;
-    bool complete;
-    bool success;
-    wifi_config_t *config; // Adicionado para ter acesso ao config
+    volatile sender_state_t state;
+    uint8_t inflight;           // Alertas do início da fila enviados (o último talvez em parte) e aguardando resposta
+    uint32_t tx_written;        // Bytes já entregues ao lwIP da última requisição em andamento
+    uint32_t unacked;           // Bytes entregues ao lwIP e ainda não confirmados pelo servidor
+    uint32_t conn_requests;     // Requisições enviadas na conexão atual
+    uint32_t seq;               // Identifica a conexão atual, para descartar callbacks antigos
+    absolute_time_t deadline;
+    http_response_t response;
+    ip_addr_t api_addr;         // Endereço do host da API em cache
+    bool api_addr_valid;
+    absolute_time_t api_addr_expires;
+    wifi_config_t *config;
 } tcp_connection_t;
 
+static alert_queue_t alert_queue;
+static tcp_connection_t sender;
+static api_reply_t api_reply;           // Resposta sendo lida
+static api_reply_t remote_limits;       // Limites recebidos em uma resposta bem-sucedida, ainda não aplicados
+static absolute_time_t next_wifi_attempt;
+api_stats_t api_stats;
+
 // Declaração de funções auxiliares
 static err_t tcp_connected_callback(void *arg, struct tcp_pcb *tpcb, err_t err);
 static err_t tcp_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
+static err_t tcp_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len);
 static void tcp_error_callback(void *arg, err_t err);
 
 /**
@@ -43,19 +163,19 @@ bool wifi_init(wifi_config_t *config) {
         printf("Falha ao inicializar o WiFi\n");
         return false;
     }
-    
+
     cyw43_arch_enable_sta_mode();
     printf("Tentando conectar ao WiFi: %s\n", config->ssid);
-    
-    if (cyw43_arch_wifi_connect_timeout_ms(config->ssid, config->senha, 
+
+    if (cyw43_arch_wifi_connect_timeout_ms(config->ssid, config->senha,
                                           CYW43_AUTH_WPA2_AES_PSK, 10000)) {
         printf("Falha ao conectar ao WiFi\n");
         return false;
     }
-    
-    printf("WiFi conectado! IP: %s\n", 
+
+    printf("WiFi conectado! IP: %s\n",
            ip4addr_ntoa(netif_ip4_addr(netif_list)));
-    
+
     return true;
 }
 
@@ -67,231 +187,795 @@ bool wifi_is_connected() {
 }
 
 /**
- * @brief Função para tentar reconectar o WiFi se estiver desconectado 
+ * @brief Função para tentar reconectar o WiFi se estiver desconectado
  * @param[in] *config Ponteiro para estrutura de dados que guarda informações de wifi
  */
 bool wifi_reconnect_if_needed(wifi_config_t *config) {
     if (!wifi_is_connected()) {
         printf("WiFi desconectado. Tentando reconectar...\n");
-        
+
         cyw43_arch_enable_sta_mode();
-        if (cyw43_arch_wifi_connect_timeout_ms(config->ssid, config->senha, 
+        if (cyw43_arch_wifi_connect_timeout_ms(config->ssid, config->senha,
                                               CYW43_AUTH_WPA2_AES_PSK, 5000)) {
             printf("Falha ao reconectar ao WiFi\n");
             return false;
         }
-        
+
         printf("WiFi reconectado com sucesso!\n");
     }
-    
+
+    return true;
+}
+
+/**
+ * @brief Inicia a reconexão do WiFi sem aguardar o resultado, respeitando um intervalo entre tentativas
+ * @param[in] *config Ponteiro para estrutura de dados que guarda informações de wifi
+ */
+void wifi_reconnect_async(wifi_config_t *config) {
+    if (!time_reached(next_wifi_attempt)) {
+        return;
+    }
+
+    next_wifi_attempt = make_timeout_time_ms(WIFI_RECONNECT_INTERVAL_MS);
+    printf("WiFi desconectado. Tentando reconectar...\n");
+    cyw43_arch_wifi_connect_async(config->ssid, config->senha, CYW43_AUTH_WPA2_AES_PSK);
+}
+
+static alert_entry_t *message_entry;  // Entrada da fila sendo montada por api_message_begin()
+static json_writer_t message_head;    // Campos variáveis do cabeçalho da entrada sendo montada
+
+// Campos fixos do cabeçalho, enviados direto da flash em toda requisição
+static const char http_header_template[] = "\r\n"
+                                           "Content-Type: application/json\r\n"
+                                           "Connection: keep-alive\r\n"
+                                           "\r\n";
+
+/**
+ * @brief Retorna a mensagem em uma posição da ordem de envio, 0 sendo a próxima
+ */
+static alert_entry_t *alert_queue_at(uint8_t position) {
+    return &alert_queue.entries[alert_queue.order[position]];
+}
+
+/**
+ * @brief Procura uma entrada fora da fila, onde a próxima mensagem pode ser montada
+ */
+static alert_entry_t *alert_queue_free_entry() {
+    for (uint8_t slot = 0; slot <= ALERT_QUEUE_SIZE; slot++) {
+        bool queued = false;
+        for (uint8_t i = 0; i < alert_queue.count && !queued; i++) {
+            queued = alert_queue.order[i] == slot;
+        }
+        if (!queued) {
+            return &alert_queue.entries[slot];
+        }
+    }
+    return NULL; // Não acontece: há uma entrada a mais que as posições da fila
+}
+
+/**
+ * @brief Remove a mensagem de uma posição da fila
+ */
+static void alert_queue_remove(uint8_t position) {
+    alert_queue.count--;
+    memmove(&alert_queue.order[position], &alert_queue.order[position + 1], alert_queue.count - position);
+}
+
+/**
+ * @brief Abre espaço na fila cheia descartando a mensagem mais antiga que não está em andamento.
+ * Lotes de leituras são descartados antes de alertas, e um lote nunca descarta um alerta
+ * @param[in] kind Tipo da mensagem que precisa do espaço
+ * @return false se nada pôde ser descartado
+ */
+static bool alert_queue_evict(message_kind_t kind) {
+    // Os primeiros da fila podem estar sendo enviados, então só as mensagens depois deles são candidatas
+    for (uint8_t i = sender.inflight; i < alert_queue.count; i++) {
+        if (alert_queue_at(i)->kind == MESSAGE_TELEMETRY) {
+            alert_queue_remove(i);
+            alert_queue.dropped++;
+            return true;
+        }
+    }
+
+    if (kind == MESSAGE_ALERT && sender.inflight < alert_queue.count) {
+        alert_queue_remove(sender.inflight);
+        alert_queue.dropped++;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Reordena a fila com os alertas antes dos lotes de leituras, mantendo a ordem dentro de cada tipo.
+ * Só pode ser chamada sem requisições em andamento
+ */
+static void alert_queue_alerts_first() {
+    uint8_t order[ALERT_QUEUE_SIZE];
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < alert_queue.count; i++) {
+        if (alert_queue_at(i)->kind == MESSAGE_ALERT) {
+            order[n++] = alert_queue.order[i];
+        }
+    }
+    for (uint8_t i = 0; i < alert_queue.count; i++) {
+        if (alert_queue_at(i)->kind != MESSAGE_ALERT) {
+            order[n++] = alert_queue.order[i];
+        }
+    }
+    memcpy(alert_queue.order, order, n);
+}
+
+/**
+ * @brief Começa a montar uma requisição POST diretamente em uma entrada livre da fila de envio,
+ * sem alocação nem cópias intermediárias. O JSON do corpo deve ser escrito em w em seguida
+ * e a requisição só entra na fila ao chamar api_message_end()
+ * @param[out] w Escritor posicionado no início do corpo da requisição
+ * @param[in] *config Ponteiro para estrutura de dados contendo configurações de wifi
+ * @param[in] kind Tipo da mensagem, que define o endpoint de destino e a prioridade
+ */
+void api_message_begin(json_writer_t *w, wifi_config_t *config, message_kind_t kind) {
+    // Entradas só são ocupadas pelo loop principal: esta continua livre até api_message_end()
+    cyw43_arch_lwip_begin();
+    message_entry = alert_queue_free_entry();
+    cyw43_arch_lwip_end();
+
+    message_entry->kind = kind;
+
+    const char *url = kind == MESSAGE_TELEMETRY ? config->telemetry_url : config->api_url;
+
+    // O valor do Content-Length é escrito por api_message_end(), quando o tamanho do corpo é conhecido
+    json_writer_init(&message_head, message_entry->head, sizeof(message_entry->head));
+    json_write_raw(&message_head, "POST ", 5);
+    json_write_raw(&message_head, url, strlen(url));
+    json_write_raw(&message_head, " HTTP/1.1\r\nHost: ", 17);
+    json_write_raw(&message_head, config->api_host, strlen(config->api_host));
+    json_write_raw(&message_head, "\r\nContent-Length: ", 18);
+
+    json_writer_init(w, message_entry->body, sizeof(message_entry->body));
+}
+
+/**
+ * @brief Finaliza a requisição iniciada por api_message_begin(), preenchendo o Content-Length,
+ * e a coloca na fila de envio. Alertas entram à frente dos lotes de leituras que ainda não
+ * começaram a ser enviados. Se a fila estiver cheia, a mensagem mais antiga fora de andamento
+ * é descartada, preferindo lotes de leituras
+ * @param[in] w Escritor usado para montar a requisição
+ * @return false se o cabeçalho ou o corpo não couberam em uma entrada da fila, ou se a fila
+ *         está cheia de alertas e a mensagem é um lote de leituras
+ */
+bool api_message_end(json_writer_t *w) {
+    json_uint(&message_head, w->len);
+
+    if (w->overflow || message_head.overflow) {
+        printf("Mensagem muito grande para a fila\n");
+        return false;
+    }
+
+    message_entry->head_len = message_head.len;
+    message_entry->body_len = w->len;
+    message_entry->attempts = 0;
+    message_entry->next_attempt = get_absolute_time();
+
+    cyw43_arch_lwip_begin();
+
+    if (alert_queue.count == ALERT_QUEUE_SIZE && !alert_queue_evict(message_entry->kind)) {
+        cyw43_arch_lwip_end();
+        printf("Fila de envio cheia\n");
+        return false;
+    }
+
+    uint8_t position = alert_queue.count;
+    if (message_entry->kind == MESSAGE_ALERT) {
+        position = sender.inflight;
+        while (position < alert_queue.count && alert_queue_at(position)->kind == MESSAGE_ALERT) {
+            position++;
+        }
+    }
+    memmove(&alert_queue.order[position + 1], &alert_queue.order[position], alert_queue.count - position);
+    alert_queue.order[position] = message_entry - alert_queue.entries;
+    alert_queue.count++;
+
+    cyw43_arch_lwip_end();
+
     return true;
 }
 
+/**
+ * @brief Retorna a quantidade de posições livres na fila de envio
+ */
+uint8_t alert_queue_free() {
+    return ALERT_QUEUE_SIZE - alert_queue.count;
+}
+
+/**
+ * @brief Remove a mensagem do início da fila
+ */
+static void alert_queue_pop() {
+    alert_queue_remove(0);
+}
+
+// Callbacks do parser JSON incremental para o corpo das respostas
+static cJSON_bool CJSON_CDECL api_reply_begin_object(void *user_data) {
+    api_reply_t *reply = (api_reply_t*)user_data;
+
+    if (reply->depth == 1 && reply->key == REPLY_KEY_CONFIG) {
+        reply->in_config = true;
+    }
+    reply->key = REPLY_KEY_OTHER;
+    reply->depth++;
+    return true;
+}
+
+static cJSON_bool CJSON_CDECL api_reply_begin_array(void *user_data) {
+    api_reply_t *reply = (api_reply_t*)user_data;
+
+    reply->key = REPLY_KEY_OTHER;
+    reply->depth++;
+    return true;
+}
+
+static cJSON_bool CJSON_CDECL api_reply_end(void *user_data) {
+    api_reply_t *reply = (api_reply_t*)user_data;
+
+    if (--reply->depth == 1) {
+        reply->in_config = false;
+    }
+    return true;
+}
+
+static cJSON_bool CJSON_CDECL api_reply_key(void *user_data, const char *key, size_t length) {
+    api_reply_t *reply = (api_reply_t*)user_data;
+
+    reply->key = REPLY_KEY_OTHER;
+    if (reply->depth == 1 && strcmp(key, "config") == 0) {
+        reply->key = REPLY_KEY_CONFIG;
+    } else if (reply->depth == 2 && reply->in_config && strcmp(key, "maxTemperature") == 0) {
+        reply->key = REPLY_KEY_MAX_TEMPERATURE;
+    } else if (reply->depth == 2 && reply->in_config && strcmp(key, "minTemperature") == 0) {
+        reply->key = REPLY_KEY_MIN_TEMPERATURE;
+    }
+    return true;
+}
+
+static cJSON_bool CJSON_CDECL api_reply_value(void *user_data, const cJSON *item) {
+    api_reply_t *reply = (api_reply_t*)user_data;
+
+    if (cJSON_IsNumber(item) && reply->key == REPLY_KEY_MAX_TEMPERATURE) {
+        reply->temp_max = item->valueint;
+        reply->has_max = true;
+    } else if (cJSON_IsNumber(item) && reply->key == REPLY_KEY_MIN_TEMPERATURE) {
+        reply->temp_min = item->valueint;
+        reply->has_min = true;
+    }
+    reply->key = REPLY_KEY_OTHER;
+    return true;
+}
+
+static const cJSON_SaxCallbacks api_reply_callbacks = {
+    api_reply_begin_object, api_reply_end, api_reply_begin_array, api_reply_end, api_reply_key, api_reply_value
+};
+
+/**
+ * @brief Aplica os limites de temperatura enviados pela API no objeto "config" de uma resposta,
+ * por exemplo {"config": {"maxTemperature": 30, "minTemperature": -5}}. Os dois limites precisam
+ * vir juntos e dentro das faixas aceitas pelo menu
+ * @param[in,out] *temp_max Limite máximo atual, substituído pelo recebido
+ * @param[in,out] *temp_min Limite mínimo atual, substituído pelo recebido
+ * @return true se os limites foram alterados
+ */
+bool api_take_remote_limits(int *temp_max, int *temp_min) {
+    cyw43_arch_lwip_begin();
+    api_reply_t limits = remote_limits;
+    remote_limits.has_max = false;
+    remote_limits.has_min = false;
+    cyw43_arch_lwip_end();
+
+    if (!limits.has_max && !limits.has_min) {
+        return false;
+    }
+
+    if (!limits.has_max || !limits.has_min) {
+        printf("Configuração da API ignorada: os dois limites devem vir juntos\n");
+        return false;
+    }
+
+    int max = limits.temp_max;
+    int min = limits.temp_min;
+
+    // Mesmas faixas aceitas pelo menu
+    if (max > 50 || min < -20 || min >= max) {
+        printf("Limites recebidos da API ignorados: %d a %d\n", min, max);
+        return false;
+    }
+
+    *temp_max = max;
+    *temp_min = min;
+    printf("Limites atualizados pela API: %d a %d\n", min, max);
+    return true;
+}
+
+/**
+ * @brief Libera a conexão TCP com a API
+ * @return ERR_ABRT se a conexão precisou ser abortada, o que deve ser repassado pelos callbacks do lwIP
+ */
+static err_t sender_close() {
+    err_t result = ERR_OK;
+
+    if (sender.pcb) {
+        tcp_arg(sender.pcb, NULL);
+        tcp_recv(sender.pcb, NULL);
+        tcp_sent(sender.pcb, NULL);
+        tcp_err(sender.pcb, NULL);
+
+        // Segmentos não confirmados apontam para a fila, que será reutilizada: com eles a conexão
+        // é abortada, já que um fechamento normal continuaria retransmitindo esses buffers
+        if (sender.unacked > 0 || tcp_close(sender.pcb) != ERR_OK) {
+            tcp_abort(sender.pcb);
+            result = ERR_ABRT;
+        }
+        sender.pcb = NULL;
+    }
+
+    sender.unacked = 0;
+    sender.state = SENDER_IDLE;
+    return result;
+}
+
+/**
+ * @brief Registra a falha das requisições em andamento e fecha a conexão.
+ * As mensagens sem resposta continuam na fila e a primeira delas aguarda o backoff. Um lote de
+ * leituras que falhou volta para trás dos alertas pendentes, que nunca esperam por ele
+ * @return ERR_ABRT se a conexão precisou ser abortada, o que deve ser repassado pelos callbacks do lwIP
+ */
+static err_t sender_fail() {
+    err_t result = sender_close();
+    sender.inflight = 0;
+
+    if (alert_queue.count == 0) {
+        return result;
+    }
+
+    alert_entry_t *entry = alert_queue_at(0);
+    if (++entry->attempts >= ALERT_MAX_ATTEMPTS) {
+        printf("Mensagem descartada após %d tentativas\n", entry->attempts);
+        alert_queue_pop();
+        alert_queue.dropped++;
+    } else {
+        // Backoff exponencial entre as tentativas
+        uint32_t delay = ALERT_RETRY_BASE_MS << (entry->attempts - 1);
+        if (delay > ALERT_RETRY_MAX_MS) {
+            delay = ALERT_RETRY_MAX_MS;
+        }
+        entry->next_attempt = make_timeout_time_ms(delay);
+        printf("Nova tentativa de envio em %lu ms\n", (unsigned long)delay);
+    }
+
+    // Sem requisições em andamento, todas as mensagens podem mudar de posição
+    alert_queue_alerts_first();
+
+    return result;
+}
+
+/**
+ * @brief Monta a lista de trechos de uma requisição: campos variáveis, campos fixos e corpo
+ * @return Quantidade de trechos
+ */
+static uint8_t alert_entry_chunks(const alert_entry_t *entry, http_chunk_t *chunks) {
+    chunks[0].data = entry->head;
+    chunks[0].len = entry->head_len;
+    chunks[1].data = http_header_template;
+    chunks[1].len = sizeof(http_header_template) - 1;
+    chunks[2].data = entry->body;
+    chunks[2].len = entry->body_len;
+    return 3;
+}
+
+/**
+ * @brief Verifica se a última requisição em andamento já foi entregue por inteiro ao lwIP
+ */
+static bool sender_tx_complete() {
+    if (sender.inflight == 0) {
+        return true;
+    }
+
+    alert_entry_t *entry = alert_queue_at(sender.inflight - 1);
+    return sender.tx_written == (uint32_t)entry->head_len + sizeof(http_header_template) - 1 + entry->body_len;
+}
+
+/**
+ * @brief Trata uma resposta completa, que corresponde ao alerta mais antigo em andamento
+ * @return ERR_OK se a conexão continua aberta, ERR_CLSD se foi fechada ou ERR_ABRT se foi abortada
+ */
+static err_t sender_on_response() {
+    http_response_t *res = &sender.response;
+
+    if (res->status_code < 200 || res->status_code > 299) {
+        printf("Resposta do servidor: %d\n", res->status_code);
+        return sender_fail() == ERR_ABRT ? ERR_ABRT : ERR_CLSD;
+    }
+
+    // Resposta antes do fim da requisição: o lwIP ainda usa o buffer da entrada, que não pode ser liberada
+    if (sender.inflight == 1 && !sender_tx_complete()) {
+        printf("Resposta antes do fim da requisição\n");
+        return sender_fail() == ERR_ABRT ? ERR_ABRT : ERR_CLSD;
+    }
+
+    printf("Requisição bem-sucedida\n");
+    api_stats.responses_ok++;
+
+    if (res->json_ok && (api_reply.has_max || api_reply.has_min)) {
+        remote_limits = api_reply;
+    }
+    alert_queue_pop();
+    sender.inflight--;
+
+    if (sender.inflight == 0) {
+        sender.state = SENDER_READY;
+    } else {
+        sender.deadline = make_timeout_time_ms(ALERT_REQUEST_TIMEOUT_MS);
+    }
+
+    if (res->connection_close) {
+        // As requisições restantes serão reenviadas em uma nova conexão
+        sender.inflight = 0;
+        return sender_close() == ERR_ABRT ? ERR_ABRT : ERR_CLSD;
+    }
+
+    http_response_reset(res);
+    memset(&api_reply, 0, sizeof(api_reply));
+    return ERR_OK;
+}
+
+/**
+ * @brief Entrega ao lwIP o que couber no buffer de envio da última requisição em andamento,
+ * continuando de onde a chamada anterior parou. Os dados não são copiados: o lwIP monta os
+ * segmentos apontando para os buffers da fila
+ * @return true se a requisição foi entregue por inteiro
+ */
+static bool sender_write_entry(const alert_entry_t *entry) {
+    http_chunk_t chunks[3];
+    uint8_t count = alert_entry_chunks(entry, chunks);
+    uint32_t skip = sender.tx_written;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (skip >= chunks[i].len) {
+            skip -= chunks[i].len;
+            continue;
+        }
+
+        const char *data = chunks[i].data + skip;
+        uint16_t len = chunks[i].len - skip;
+        skip = 0;
+
+        while (len > 0) {
+            // Requisições maiores que o buffer de envio seguem em tcp_sent_callback(), conforme o servidor confirma.
+            // Com o TCP_SND_BUF do lwipopts.h uma entrada cabe inteira, mas não com buffers menores
+            uint16_t space = tcp_sndbuf(sender.pcb);
+            if (space == 0) {
+                return false;
+            }
+
+            uint16_t n = len < space ? len : space;
+            bool last = i == count - 1 && n == len;
+            err_t err = tcp_write(sender.pcb, data, n, last ? 0 : TCP_WRITE_FLAG_MORE);
+            if (err != ERR_OK) {
+                // ERR_MEM: fila de segmentos do lwIP cheia, também continua após as confirmações
+                if (err != ERR_MEM) {
+                    printf("Falha no envio da requisição: %d\n", err);
+                }
+                return false;
+            }
+
+            data += n;
+            len -= n;
+            sender.tx_written += n;
+            sender.unacked += n;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Envia pela conexão aberta os alertas da fila que ainda não foram enviados,
+ * até o limite de API_PIPELINE_DEPTH requisições aguardando resposta
+ */
+static void sender_flush_queue() {
+    bool written = false;
+
+    for (;;) {
+        if (sender_tx_complete()) {
+            if (sender.inflight >= API_PIPELINE_DEPTH || sender.inflight >= alert_queue.count) {
+                break;
+            }
+
+            // Toda requisição além da primeira na mesma conexão evita um handshake
+            api_stats.requests_sent++;
+            if (sender.conn_requests++ > 0) {
+                api_stats.handshakes_avoided++;
+            }
+            sender.inflight++;
+            sender.tx_written = 0;
+        }
+
+        // A requisição já está pronta na fila, montada por api_message_begin()/api_message_end()
+        alert_entry_t *entry = alert_queue_at(sender.inflight - 1);
+        uint32_t before = sender.tx_written;
+        bool complete = sender_write_entry(entry);
+        written |= sender.tx_written != before;
+
+        if (!complete) {
+            break;
+        }
+    }
+
+    if (written) {
+        tcp_output(sender.pcb);
+    }
+
+    if (sender.inflight > 0 && sender.state == SENDER_READY) {
+        sender.state = SENDER_WAITING_RESPONSE;
+        sender.deadline = make_timeout_time_ms(ALERT_REQUEST_TIMEOUT_MS);
+    }
+}
+
 // Callbacks para a conexão TCP
 static err_t tcp_connected_callback(void *arg, struct tcp_pcb *tpcb, err_t err) {
-    tcp_connection_t *conn = (tcp_connection_t*)arg;
-    
     if (err != ERR_OK) {
         printf("Falha na conexão TCP: %d\n", err);
-        conn->success = false;
-        conn->complete = true;
-        return err;
-    }
-    
-    printf("Conexão TCP estabelecida\n");
-    
-    // Enviar a requisição HTTP
-    err = tcp_write(tpcb, conn->request, conn->request_len, TCP_WRITE_FLAG_COPY);
-    if (err != ERR_OK) {
-        printf("Falha no envio da requisição: %d\n", err);
-        conn->success = false;
-        conn->complete = true;
-        return err;
+        sender.api_addr_valid = false;
+        return sender_fail();
     }
-    
-    tcp_output(tpcb);
+
+    sender.state = SENDER_READY;
+    sender_flush_queue();
     return ERR_OK;
 }
 
 static err_t tcp_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
-    tcp_connection_t *conn = (tcp_connection_t*)arg;
-    
     if (p == NULL) {
-        // Conexão fechada
-        conn->complete = true;
-        return ERR_OK;
-    }
-    
-    if (p->tot_len > 0) {
-        // Processar a resposta HTTP
-        char *response = (char*)p->payload;
-        
-        // Verificar se a resposta foi bem-sucedida (HTTP 200 OK)
-        if (strstr(response, "HTTP/1.1 200") != NULL || 
-            strstr(response, "HTTP/1.0 200") != NULL) {
-            printf("Requisição bem-sucedida\n");
-            conn->success = true;
-        } else {
-            printf("Resposta do servidor: %s\n", response);
-            conn->success = false;
+        // Conexão fechada pelo servidor, o que pode terminar uma resposta sem Content-Length
+        if (sender.inflight > 0 && http_response_close(&sender.response)) {
+            err_t result = sender_on_response();
+            if (result == ERR_ABRT) {
+                return ERR_ABRT;
+            }
         }
-        
-        tcp_recved(tpcb, p->tot_len);
+
+        // As requisições sem resposta serão reenviadas
+        if (sender.inflight > 0) {
+            return sender_fail();
+        }
+        return sender_close();
     }
-    
+
+    tcp_recved(tpcb, p->tot_len);
+
+    // Percorre a cadeia de pbufs sem copiar: uma resposta pode chegar em vários segmentos
+    // e um segmento pode conter o fim de uma resposta e o início da próxima
+    for (struct pbuf *q = p; q != NULL; q = q->next) {
+        const char *data = (const char*)q->payload;
+        size_t offset = 0;
+
+        while (offset < q->len) {
+            if (sender.inflight == 0) {
+                // Dados inesperados, a conexão não está mais sincronizada
+                pbuf_free(p);
+                return sender_close();
+            }
+
+            offset += http_response_feed(&sender.response, data + offset, q->len - offset);
+
+            if (sender.response.state == HTTP_PARSE_ERROR) {
+                printf("Resposta HTTP malformada\n");
+                pbuf_free(p);
+                return sender_fail();
+            }
+
+            if (sender.response.state == HTTP_PARSE_DONE) {
+                err_t result = sender_on_response();
+                if (result != ERR_OK) {
+                    pbuf_free(p);
+                    return result == ERR_ABRT ? ERR_ABRT : ERR_OK;
+                }
+            }
+        }
+    }
+
     pbuf_free(p);
-    
-    // Fechar a conexão após receber a resposta
-    tcp_close(tpcb);
-    conn->complete = true;
-    
-    printf("Fechei a conexao aqui!!\n");
+    return ERR_OK;
+}
 
+static err_t tcp_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len) {
+    // Bytes confirmados pelo servidor; o espaço liberado no buffer de envio permite continuar
+    // a requisição em andamento. Chamado antes de tcp_recv_callback() para o mesmo segmento, então
+    // uma entrada já foi confirmada por inteiro quando a sua resposta chega
+    sender.unacked -= len;
+
+    if (sender.state == SENDER_WAITING_RESPONSE) {
+        sender_flush_queue();
+    }
     return ERR_OK;
 }
 
 static void tcp_error_callback(void *arg, err_t err) {
-    tcp_connection_t *conn = (tcp_connection_t*)arg;
     printf("Erro na conexão TCP: %d\n", err);
-    conn->success = false;
-    conn->complete = true;
+    sender.pcb = NULL; // O lwIP já liberou o PCB e os segmentos pendentes
+    sender.unacked = 0;
+    sender_fail();
+}
+
+/**
+ * @brief Cria o PCB e inicia a conexão TCP com o endereço do host da API
+ */
+static void sender_connect(const ip_addr_t *ipaddr) {
+    sender.pcb = tcp_new_ip_type(IP_GET_TYPE(ipaddr));
+    if (!sender.pcb) {
+        printf("Falha ao criar PCB TCP\n");
+        sender_fail();
+        return;
+    }
+
+    tcp_arg(sender.pcb, &sender);
+    tcp_recv(sender.pcb, tcp_recv_callback);
+    tcp_sent(sender.pcb, tcp_sent_callback);
+    tcp_err(sender.pcb, tcp_error_callback);
+
+    sender.state = SENDER_CONNECTING;
+    sender.conn_requests = 0;
+    sender.tx_written = 0;
+    sender.unacked = 0;
+    http_response_init(&sender.response, &api_reply_callbacks, &api_reply);
+    memset(&api_reply, 0, sizeof(api_reply));
+    api_stats.handshakes++;
+
+    err_t err = tcp_connect(sender.pcb, ipaddr, sender.config->api_port, tcp_connected_callback);
+    if (err != ERR_OK) {
+        printf("Falha ao iniciar conexão TCP: %d\n", err);
+        sender_fail();
+    }
 }
 
 // Callback para resolução DNS
 static void dns_callback(const char *name, const ip_addr_t *ipaddr, void *callback_arg) {
-    tcp_connection_t *conn = (tcp_connection_t*)callback_arg;
-    
+    // Ignora respostas de tentativas que já expiraram
+    if ((uint32_t)(uintptr_t)callback_arg != sender.seq || sender.state != SENDER_RESOLVING) {
+        return;
+    }
+
     if (ipaddr == NULL) {
         printf("Falha na resolução DNS para %s\n", name);
-        conn->success = false;
-        conn->complete = true;
+        sender_fail();
         return;
     }
-    
-    // Acessar config através da estrutura de conexão
-    wifi_config_t *config = conn->config;
-    
-    // Conectar ao servidor
-    err_t err = tcp_connect(conn->pcb, ipaddr, config->api_port, tcp_connected_callback);
-    if (err != ERR_OK) {
-        printf("Falha ao iniciar conexão TCP: %d\n", err);
-        tcp_close(conn->pcb);
-        conn->success = false;
-        conn->complete = true;
-    }
+
+    sender.api_addr = *ipaddr;
+    sender.api_addr_valid = true;
+    sender.api_addr_expires = make_timeout_time_ms(API_DNS_CACHE_TTL_MS);
+    sender_connect(ipaddr);
 }
 
 /**
- * @brief Função para enviar uma mensagem JSON para a API
+ * @brief Abre a conexão com a API, usando o endereço em cache quando ainda for válido
  * @param[in] *config Ponteiro para estrutura de dados contendo configurações de wifi
- * @param[in] *json_str Cadeia de caracteres representando um JSON
  **/
-bool send_json_to_api(wifi_config_t *config, const char *json_str) {
-    // Verificar se o WiFi está conectado
-    if (!wifi_is_connected()) {
-        if (!wifi_reconnect_if_needed(config)) {
-            return false;
-        }
-    }
-    
-    // Preparar a estrutura de conexão
-    tcp_connection_t conn;
-    conn.complete = false;
-    conn.success = false;
-    conn.config = config;  // Armazenar o ponteiro para config
-    
-    // Criar o PCB TCP
-    struct tcp_pcb *pcb = tcp_new();
-    if (!pcb) {
-        printf("Falha ao criar PCB TCP\n");
-        return false;
+static void sender_open(wifi_config_t *config) {
+    sender.config = config;
+    sender.pcb = NULL;
+    sender.inflight = 0;
+    sender.seq++;
+    sender.deadline = make_timeout_time_ms(ALERT_REQUEST_TIMEOUT_MS);
+
+    if (sender.api_addr_valid && !time_reached(sender.api_addr_expires)) {
+        api_stats.dns_cache_hits++;
+        sender_connect(&sender.api_addr);
+        return;
     }
-    
-    // Configurar a conexão
-    conn.pcb = pcb;
-    
-    // Preparar a requisição HTTP
-    char request[1024];
-    snprintf(request, sizeof(request),
-             "POST %s HTTP/1.1\r\n"
-             "Host: %s\r\n"
-             "Content-Type: application/json\r\n"
-             "Content-Length: %d\r\n"
-             "Connection: close\r\n"
-             "\r\n"
-             "%s",
-             config->api_url, config->api_host, strlen(json_str), json_str);
-    
-    conn.request = request;
-    conn.request_len = strlen(request);
-    
-    // Configurar callbacks
-    tcp_arg(pcb, &conn);
-    tcp_recv(pcb, tcp_recv_callback);
-    tcp_err(pcb, tcp_error_callback);
-    
-    // Resolver o nome do host
+
+    // Resolver o nome do host, o resultado pode vir imediatamente do cache do lwIP
     ip_addr_t remote_addr;
-    
-    // Tentar resolver o nome do host
-    err_t err = dns_gethostbyname(config->api_host, &remote_addr, 
-                                 dns_callback, &conn);
-    
-    if (err == ERR_INPROGRESS) {
-        // Aguardar a resolução DNS
-        while (!conn.complete) {
-            cyw43_arch_poll();
-            printf("Conexão ainda nao foi completa...\n");
-            sleep_ms(10);
-        }
-    } else if (err != ERR_OK) {
+    sender.state = SENDER_RESOLVING;
+    api_stats.dns_lookups++;
+    err_t err = dns_gethostbyname(config->api_host, &remote_addr, dns_callback,
+                                  (void*)(uintptr_t)sender.seq);
+
+    if (err == ERR_OK) {
+        dns_callback(config->api_host, &remote_addr, (void*)(uintptr_t)sender.seq);
+    } else if (err != ERR_INPROGRESS) {
         printf("Falha na resolução DNS: %d\n", err);
-        tcp_close(pcb);
-        return false;
-    } else {
-        // Conectar ao servidor
-        err = tcp_connect(pcb, &remote_addr, config->api_port, tcp_connected_callback);
-        if (err != ERR_OK) {
-            printf("Falha ao iniciar conexão TCP: %d\n", err);
-            tcp_close(pcb);
-            return false;
-        }
-        
-        // Aguardar a conclusão da conexão
-        while (!conn.complete) {
-            cyw43_arch_poll();
-            printf("tentando conectar ainda...\n");
-            sleep_ms(10);
-        }
+        sender_fail();
+    }
+}
+
+/**
+ * @brief Avança o envio dos alertas da fila. Deve ser chamada a cada iteração do loop principal e nunca bloqueia.
+ * A conexão com a API é mantida aberta entre os envios e reaberta quando o servidor a fecha
+ * @param[in] *config Ponteiro para estrutura de dados contendo configurações de wifi
+ */
+void alert_sender_poll(wifi_config_t *config) {
+    cyw43_arch_lwip_begin();
+
+    switch (sender.state) {
+        case SENDER_IDLE:
+            if (alert_queue.count == 0 ||
+                !time_reached(alert_queue_at(0)->next_attempt)) {
+                break;
+            }
+
+            if (!wifi_is_connected()) {
+                wifi_reconnect_async(config);
+                break;
+            }
+
+            sender_open(config);
+            break;
+
+        case SENDER_READY:
+            if (alert_queue.count > 0 &&
+                time_reached(alert_queue_at(0)->next_attempt)) {
+                sender_flush_queue();
+            }
+            break;
+
+        default:
+            // Envia os alertas que chegaram enquanto outros aguardam resposta
+            if (sender.state == SENDER_WAITING_RESPONSE) {
+                sender_flush_queue();
+            }
+
+            // Conexão ou resposta demorando demais
+            if (time_reached(sender.deadline)) {
+                printf("Tempo limite da requisição excedido\n");
+                if (sender.state == SENDER_CONNECTING) {
+                    // O endereço em cache pode não ser mais válido
+                    sender.api_addr_valid = false;
+                }
+                if (sender.pcb) {
+                    tcp_arg(sender.pcb, NULL);
+                    tcp_err(sender.pcb, NULL);
+                    tcp_abort(sender.pcb);
+                    sender.pcb = NULL;
+                }
+                sender_fail();
+            }
+            break;
     }
-    
-    return conn.success;
+
+    cyw43_arch_lwip_end();
 }
 
-// Função para enviar alerta usando cJSON
-bool send_alert_json(wifi_config_t *config, const char *device_id, 
+/**
+ * @brief Verifica se ainda há alertas aguardando envio
+ */
+bool alert_sender_pending() {
+    return alert_queue.count > 0;
+}
+
+/**
+ * @brief Monta o JSON de um alerta diretamente na fila de envio
+ * @param[in] *config Ponteiro para estrutura de dados contendo configurações de wifi
+ * @param[in] *device_id Identificador único do dispositivo
+ * @return false se o alerta não pôde ser colocado na fila
+ */
+bool send_alert_json(wifi_config_t *config, const char *device_id,
                         int temperatura, int temp_max, int temp_min) {
-    // Criar objeto JSON
-    cJSON *alert = cJSON_CreateObject();
-
-    cJSON_AddStringToObject(alert, "deviceId", device_id);
-    cJSON_AddNumberToObject(alert, "temperature", temperatura);
-    cJSON_AddNumberToObject(alert, "maxTemperature", temp_max);
-    cJSON_AddNumberToObject(alert, "minTemperature", temp_min);
-
-
-    // Converter para string
-    char *json_str = cJSON_Print(alert);
-    printf("JSON enviado: %s", json_str);
-
-    // Enviar para a API
-    bool result = send_json_to_api(config, json_str);
-    
-    // Limpar recursos, evitando sobrecarga de memória
-    cJSON_Delete(alert);
-    free(json_str);
-    
-    return result;
+    json_writer_t w;
+
+    api_message_begin(&w, config, MESSAGE_ALERT);
+    json_begin_object(&w);
+    json_key(&w, "deviceId");
+    json_string(&w, device_id);
+    json_key(&w, "temperature");
+    json_int(&w, temperatura);
+    json_key(&w, "maxTemperature");
+    json_int(&w, temp_max);
+    json_key(&w, "minTemperature");
+    json_int(&w, temp_min);
+    json_end_object(&w);
+
+    // O envio é feito por alert_sender_poll()
+    return api_message_end(&w);
 }
 
-#endif // CONNECTION_MANAGER_H
\ No newline at end of file
+#endif // CONNECTION_MANAGER_H
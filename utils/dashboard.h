@@ -0,0 +1,224 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "libs/pico-ssd1306/ssd1306.h"
+
+#define DASHBOARD_SAMPLES 128           // Uma leitura por coluna do gráfico
+#define DASHBOARD_RING (DASHBOARD_SAMPLES + 1) // Mais uma, à qual o traço da coluna mais antiga se liga
+#define DASHBOARD_DIGITS 3              // Sinal e dois dígitos, ou três dígitos
+#define DASHBOARD_DIGIT_X 18            // Início do primeiro dígito
+#define DASHBOARD_DIGIT_Y 10
+#define DASHBOARD_DIGIT_WIDTH 16
+#define DASHBOARD_DIGIT_HEIGHT 28
+#define DASHBOARD_DIGIT_STEP 20         // Dígito mais o espaço até o próximo
+#define DASHBOARD_SEGMENT 3             // Espessura dos segmentos
+#define DASHBOARD_GRAPH_PAGE 5          // O gráfico ocupa as pages 5 a 7, para deslocar bytes inteiros
+#define DASHBOARD_GRAPH_TOP (DASHBOARD_GRAPH_PAGE * 8)
+#define DASHBOARD_GRAPH_HEIGHT 24
+#define DASHBOARD_DOT_SPACING 4         // Espaçamento dos pontos das linhas de limite
+
+// Segmentos acesos de cada caractere, nos bits gfedcba
+#define SEGMENTS_MINUS 0x40
+#define SEGMENTS_C 0x39
+
+static const uint8_t dashboard_digit_segments[10] = {
+    0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F
+};
+
+// Painel de temperatura: dígitos grandes e um gráfico das últimas leituras
+typedef struct {
+    int16_t samples[DASHBOARD_RING];    // Buffer circular; a leitura n fica em samples[n % DASHBOARD_RING]
+    uint32_t seq;                       // Leituras registradas desde a inicialização
+    uint32_t drawn_seq;                 // Leituras já desenhadas no gráfico
+    int graph_lo;                       // Faixa de temperatura da escala desenhada
+    int graph_hi;
+    bool graph_valid;                   // O gráfico no framebuffer corresponde a drawn_seq e à escala
+    uint8_t shown[DASHBOARD_DIGITS];    // Segmentos desenhados em cada posição
+    bool digits_valid;
+} dashboard_t;
+
+/**
+ * @brief Informa que o framebuffer foi limpo ou alterado; o próximo dashboard_render() desenha tudo
+ */
+static void dashboard_invalidate(dashboard_t *dash) {
+    dash->graph_valid = false;
+    dash->digits_valid = false;
+}
+
+/**
+ * @brief Registra uma leitura no buffer circular. Só é desenhada no próximo dashboard_render()
+ */
+static void dashboard_record(dashboard_t *dash, int temperature) {
+    dash->samples[dash->seq % DASHBOARD_RING] = temperature;
+    dash->seq++;
+}
+
+/**
+ * @brief Desenha um caractere de 7 segmentos com retângulos
+ * @param[in] segments Segmentos acesos, nos bits gfedcba
+ */
+static void dashboard_draw_segments(ssd1306_t *disp, uint32_t x, uint32_t y, uint8_t segments) {
+    const uint32_t w = DASHBOARD_DIGIT_WIDTH, h = DASHBOARD_DIGIT_HEIGHT, t = DASHBOARD_SEGMENT;
+    const uint32_t mid = h / 2;
+
+    if (segments & 0x01) ssd1306_draw_square(disp, x + t, y, w - 2 * t, t);                            // a
+    if (segments & 0x02) ssd1306_draw_square(disp, x + w - t, y + t, t, mid - 1 - t);                  // b
+    if (segments & 0x04) ssd1306_draw_square(disp, x + w - t, y + mid + 2, t, h - t - mid - 2);        // c
+    if (segments & 0x08) ssd1306_draw_square(disp, x + t, y + h - t, w - 2 * t, t);                    // d
+    if (segments & 0x10) ssd1306_draw_square(disp, x, y + mid + 2, t, h - t - mid - 2);                // e
+    if (segments & 0x20) ssd1306_draw_square(disp, x, y + t, t, mid - 1 - t);                          // f
+    if (segments & 0x40) ssd1306_draw_square(disp, x + t, y + mid - 1, w - 2 * t, t);                  // g
+}
+
+/**
+ * @brief Converte a temperatura nos segmentos de cada posição, alinhada à direita
+ */
+static void dashboard_format(int temperature, uint8_t segments[DASHBOARD_DIGITS]) {
+    // Fora da faixa exibível: traços
+    if (temperature < -99 || temperature > 999) {
+        memset(segments, SEGMENTS_MINUS, DASHBOARD_DIGITS);
+        return;
+    }
+
+    uint32_t magnitude = temperature < 0 ? -temperature : temperature;
+    int pos = DASHBOARD_DIGITS - 1;
+
+    memset(segments, 0, DASHBOARD_DIGITS);
+    do {
+        segments[pos--] = dashboard_digit_segments[magnitude % 10];
+        magnitude /= 10;
+    } while (magnitude && pos >= 0);
+
+    if (temperature < 0) {
+        segments[pos] = SEGMENTS_MINUS;
+    }
+}
+
+/**
+ * @brief Redesenha apenas as posições cujo caractere mudou
+ * @return true se algo foi desenhado
+ */
+static bool dashboard_render_digits(dashboard_t *dash, ssd1306_t *disp, int temperature) {
+    uint8_t segments[DASHBOARD_DIGITS];
+    bool drawn = false;
+
+    dashboard_format(temperature, segments);
+
+    if (!dash->digits_valid) {
+        // Unidade, após o último dígito: um "o" pequeno como símbolo de grau e um C
+        uint32_t unit_x = DASHBOARD_DIGIT_X + DASHBOARD_DIGITS * DASHBOARD_DIGIT_STEP;
+        ssd1306_clear_square(disp, 0, DASHBOARD_DIGIT_Y, disp->width, DASHBOARD_DIGIT_HEIGHT);
+        ssd1306_draw_empty_square(disp, unit_x, DASHBOARD_DIGIT_Y, 3, 3);
+        dashboard_draw_segments(disp, unit_x + 8, DASHBOARD_DIGIT_Y, SEGMENTS_C);
+        memset(dash->shown, 0, sizeof(dash->shown));
+        dash->digits_valid = true;
+        drawn = true;
+    }
+
+    for (int i = 0; i < DASHBOARD_DIGITS; i++) {
+        if (segments[i] == dash->shown[i]) {
+            continue;
+        }
+
+        uint32_t x = DASHBOARD_DIGIT_X + i * DASHBOARD_DIGIT_STEP;
+        ssd1306_clear_square(disp, x, DASHBOARD_DIGIT_Y, DASHBOARD_DIGIT_WIDTH, DASHBOARD_DIGIT_HEIGHT);
+        dashboard_draw_segments(disp, x, DASHBOARD_DIGIT_Y, segments[i]);
+        dash->shown[i] = segments[i];
+        drawn = true;
+    }
+
+    return drawn;
+}
+
+/**
+ * @brief Linha do gráfico correspondente a uma temperatura, limitada à área do gráfico
+ */
+static uint32_t dashboard_graph_y(const dashboard_t *dash, int temperature) {
+    if (temperature < dash->graph_lo) temperature = dash->graph_lo;
+    if (temperature > dash->graph_hi) temperature = dash->graph_hi;
+
+    uint32_t offset = (uint32_t)(temperature - dash->graph_lo) * (DASHBOARD_GRAPH_HEIGHT - 1) / (dash->graph_hi - dash->graph_lo);
+    return DASHBOARD_GRAPH_TOP + DASHBOARD_GRAPH_HEIGHT - 1 - offset;
+}
+
+/**
+ * @brief Desenha a coluna de uma leitura: um traço vertical desde a leitura anterior e os pontos dos limites
+ * @param[in] n Número da leitura, que também define a posição dos pontos das linhas de limite
+ */
+static void dashboard_draw_column(const dashboard_t *dash, ssd1306_t *disp, uint32_t x, uint32_t n, int temp_min, int temp_max) {
+    uint32_t y = dashboard_graph_y(dash, dash->samples[n % DASHBOARD_RING]);
+    uint32_t y_prev = y;
+
+    // A leitura anterior só existe se ainda estiver no buffer circular
+    if (n > 0 && dash->seq - n < DASHBOARD_RING) {
+        y_prev = dashboard_graph_y(dash, dash->samples[(n - 1) % DASHBOARD_RING]);
+    }
+
+    if (n % DASHBOARD_DOT_SPACING == 0) {
+        ssd1306_draw_pixel(disp, x, dashboard_graph_y(dash, temp_min));
+        ssd1306_draw_pixel(disp, x, dashboard_graph_y(dash, temp_max));
+    }
+    ssd1306_draw_line(disp, x, y_prev, x, y);
+}
+
+/**
+ * @brief Atualiza o gráfico com as leituras registradas desde o último desenho. O gráfico é deslocado
+ * uma coluna para a esquerda por leitura e só as colunas novas são desenhadas; ele é redesenhado
+ * por inteiro apenas quando a escala muda
+ * @return true se algo foi desenhado
+ */
+static bool dashboard_render_graph(dashboard_t *dash, ssd1306_t *disp, int temp_min, int temp_max) {
+    // Escala com uma margem acima e abaixo dos limites, para que as linhas de limite fiquem visíveis
+    int margin = (temp_max - temp_min) / 4 + 1;
+    int lo = temp_min - margin, hi = temp_max + margin;
+    if (hi <= lo) {
+        hi = lo + 1;
+    }
+
+    uint32_t count = dash->seq < DASHBOARD_SAMPLES ? dash->seq : DASHBOARD_SAMPLES;
+    uint32_t fresh = dash->seq - dash->drawn_seq;
+    uint32_t width = disp->width < DASHBOARD_SAMPLES ? disp->width : DASHBOARD_SAMPLES;
+
+    if (dash->graph_valid && lo == dash->graph_lo && hi == dash->graph_hi && fresh < width) {
+        if (fresh == 0) {
+            return false;
+        }
+
+        for (uint32_t page = DASHBOARD_GRAPH_PAGE; page < disp->pages; page++) {
+            uint8_t *row = disp->buffer + page * disp->width;
+            memmove(row, row + fresh, disp->width - fresh);
+        }
+        ssd1306_clear_square(disp, disp->width - fresh, DASHBOARD_GRAPH_TOP, fresh, DASHBOARD_GRAPH_HEIGHT);
+    } else {
+        dash->graph_lo = lo;
+        dash->graph_hi = hi;
+        ssd1306_clear_square(disp, 0, DASHBOARD_GRAPH_TOP, disp->width, DASHBOARD_GRAPH_HEIGHT);
+        fresh = count < width ? count : width;
+    }
+
+    // A leitura mais recente fica na última coluna
+    for (uint32_t i = 0; i < fresh; i++) {
+        uint32_t n = dash->seq - fresh + i;
+        dashboard_draw_column(dash, disp, disp->width - fresh + i, n, temp_min, temp_max);
+    }
+
+    dash->drawn_seq = dash->seq;
+    dash->graph_valid = true;
+    return true;
+}
+
+/**
+ * @brief Desenha o painel no framebuffer: dígitos grandes com a temperatura atual e o gráfico das leituras
+ * @return true se o framebuffer mudou
+ */
+static bool dashboard_render(dashboard_t *dash, ssd1306_t *disp, int temperature, int temp_min, int temp_max) {
+    bool digits = dashboard_render_digits(dash, disp, temperature);
+    bool graph = dashboard_render_graph(dash, disp, temp_min, temp_max);
+
+    return digits || graph;
+}
+
+#endif // DASHBOARD_H
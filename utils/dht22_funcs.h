@@ -0,0 +1,176 @@
+#ifndef DHT22_FUNCS_H
+#define DHT22_FUNCS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "dht22.pio.h"
+
+#define DHT22_PIO_FREQ_HZ 2000000       // Frequência do state machine (1 unidade de contagem = 1 us)
+#define DHT22_PULSE_COUNT 41            // Pulso alto da resposta do sensor + 40 bits de dados
+#define DHT22_BIT_THRESHOLD_US 40       // Pulsos altos mais longos que isso representam o bit 1
+#define DHT22_START_PULSE_US 18000      // Duração do pulso de start enviado ao sensor
+#define DHT22_READ_TIMEOUT_US 30000     // Tempo máximo para uma leitura completa
+#define DHT22_MIN_INTERVAL_US 2000000   // Intervalo mínimo entre leituras exigido pelo sensor
+
+/**
+ * @brief Estados possíveis de uma leitura do DHT22
+ */
+typedef enum {
+    /* Nenhuma leitura em andamento */
+    DHT22_IDLE,
+
+    /* Leitura em andamento, o DMA ainda está recebendo pulsos */
+    DHT22_BUSY,
+
+    /* Leitura concluída com sucesso */
+    DHT22_OK,
+
+    /* O sensor não respondeu dentro do tempo esperado */
+    DHT22_ERROR_TIMEOUT,
+
+    /* Os dados recebidos não conferem com o checksum */
+    DHT22_ERROR_CHECKSUM
+} dht22_status_t;
+
+// Estrutura para armazenar o estado do driver do DHT22
+typedef struct {
+    PIO pio;
+    uint sm;
+    uint offset;
+    uint dma_chan;
+    uint32_t pulses[DHT22_PULSE_COUNT]; // Larguras dos pulsos altos, em microssegundos
+    bool busy;
+    absolute_time_t deadline;           // Limite para a leitura em andamento
+    absolute_time_t next_start;         // Momento a partir do qual uma nova leitura é permitida
+} dht22_t;
+
+dht22_t dht22;
+
+/**
+ * @brief Decodifica as larguras de pulso capturadas do DHT22
+ * @param[in] pulses Larguras dos pulsos altos em microssegundos, começando pelo pulso de resposta
+ * @param[in] count Quantidade de pulsos em pulses
+ * @param[out] temperature Temperatura lida, em graus Celsius
+ * @return DHT22_OK se os dados forem válidos, ou o código de erro correspondente
+ */
+dht22_status_t dht22_decode(const uint32_t *pulses, size_t count, int *temperature) {
+    uint8_t bits[5] = {0};
+
+    if (count != DHT22_PULSE_COUNT) {
+        return DHT22_ERROR_TIMEOUT;
+    }
+
+    // O primeiro pulso é a resposta do sensor, os dados começam no segundo
+    for (int i = 0; i < 40; i++) {
+        if (pulses[i + 1] > DHT22_BIT_THRESHOLD_US) {
+            bits[i / 8] |= (1 << (7 - (i % 8)));
+        }
+    }
+
+    // Verificar checksum
+    uint8_t checksum = bits[0] + bits[1] + bits[2] + bits[3];
+    if (checksum != bits[4]) {
+        return DHT22_ERROR_CHECKSUM;
+    }
+
+    // Temperatura em décimos de grau, com o bit mais significativo indicando o sinal
+    int tenths = ((bits[2] & 0x7F) << 8) | bits[3];
+    if (bits[2] & 0x80) {
+        tenths = -tenths;
+    }
+
+    *temperature = tenths / 10;
+    return DHT22_OK;
+}
+
+/**
+ * @brief Inicializa o state machine e o canal DMA usados na leitura do DHT22
+ * @param[in] pio Instância PIO a ser utilizada
+ * @param[in] pin O pino gpio onde o sensor está conectado
+ */
+void dht22_init(PIO pio, uint pin) {
+    dht22.pio = pio;
+    dht22.sm = pio_claim_unused_sm(pio, true);
+    dht22.offset = pio_add_program(pio, &dht22_program);
+    dht22_program_init(pio, dht22.sm, dht22.offset, pin, DHT22_PIO_FREQ_HZ);
+
+    dht22.dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dht22.dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, dht22.sm, false));
+    dma_channel_configure(dht22.dma_chan, &c, dht22.pulses, &pio->rxf[dht22.sm],
+                          DHT22_PULSE_COUNT, false);
+
+    dht22.busy = false;
+    dht22.next_start = get_absolute_time();
+}
+
+/**
+ * @brief Coloca o state machine de volta no início do programa, descartando leituras parciais
+ */
+static void dht22_reset_sm() {
+    pio_sm_set_enabled(dht22.pio, dht22.sm, false);
+    pio_sm_clear_fifos(dht22.pio, dht22.sm);
+    pio_sm_restart(dht22.pio, dht22.sm);
+    pio_sm_exec(dht22.pio, dht22.sm, pio_encode_set(pio_pindirs, 0)); // Libera a linha
+    pio_sm_exec(dht22.pio, dht22.sm, pio_encode_jmp(dht22.offset));
+    pio_sm_set_enabled(dht22.pio, dht22.sm, true);
+}
+
+/**
+ * @brief Inicia uma leitura assíncrona do DHT22
+ * @return true se a leitura foi iniciada, false se já houver uma em andamento
+ *         ou se o intervalo mínimo entre leituras ainda não tiver passado
+ */
+bool dht22_start() {
+    if (dht22.busy || !time_reached(dht22.next_start)) {
+        return false;
+    }
+
+    dht22_reset_sm();
+    dma_channel_set_write_addr(dht22.dma_chan, dht22.pulses, false);
+    dma_channel_set_trans_count(dht22.dma_chan, DHT22_PULSE_COUNT, true);
+
+    // Parâmetros do programa: duração do pulso de start e quantidade de pulsos
+    pio_sm_put(dht22.pio, dht22.sm, DHT22_START_PULSE_US * (DHT22_PIO_FREQ_HZ / 1000000) - 1);
+    pio_sm_put(dht22.pio, dht22.sm, DHT22_PULSE_COUNT - 1);
+
+    dht22.busy = true;
+    dht22.deadline = make_timeout_time_us(DHT22_READ_TIMEOUT_US);
+    dht22.next_start = make_timeout_time_us(DHT22_MIN_INTERVAL_US);
+    return true;
+}
+
+/**
+ * @brief Verifica o andamento da leitura iniciada por dht22_start(), sem bloquear
+ * @param[out] temperature Recebe a temperatura lida. Só é alterada quando a leitura termina com
+ *             sucesso: qualquer valor, inclusive -1, é uma temperatura válida
+ * @return O estado da leitura
+ */
+dht22_status_t dht22_poll(int *temperature) {
+    if (!dht22.busy) {
+        return DHT22_IDLE;
+    }
+
+    if (dma_channel_is_busy(dht22.dma_chan)) {
+        if (!time_reached(dht22.deadline)) {
+            return DHT22_BUSY;
+        }
+
+        // O sensor não respondeu, descartar a leitura parcial
+        dma_channel_abort(dht22.dma_chan);
+        dht22_reset_sm();
+        dht22.busy = false;
+        return DHT22_ERROR_TIMEOUT;
+    }
+
+    dht22.busy = false;
+    return dht22_decode(dht22.pulses, DHT22_PULSE_COUNT, temperature);
+}
+
+#endif // DHT22_FUNCS_H
@@ -1,5 +1,7 @@
 #include "libs/pico-ssd1306/ssd1306.h"
 #include "string.h"
+#include "ui_screen.h"
+#include "dashboard.h"
 
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
@@ -8,6 +10,8 @@
 #define I2C_SCL 15          // Pino SCL
 
 ssd1306_t display;
+static ui_state_t ui;   // Tela exibida pelas funções draw_*
+static dashboard_t dashboard;   // Leituras e estado desenhado do painel com dígitos grandes
 
 /**
  * @brief Inicializa o display OLED ssd1306
@@ -25,20 +29,23 @@ int oled_display_init(){
         return 1; // Falha ao inicializar display
     }
 
+    ssd1306_clear(&display);
+    ui_invalidate(&ui);
+
     return 0;
 }
 
 /**
- * @brief Escreve um determinado texto na tela
+ * @brief Escreve um determinado texto na tela, que só é enviada ao display em oled_commit()
  * @param[in] text Texto a ser exibido
  * @param[in] posX Posição horizontal de exibição do texto
  * @param[in] posY Posição vertical da exibição do texto
  * @return void
  */
 void oled_write(char *text, uint32_t posX, uint32_t posY){
+    ui_invalidate(&ui);
     ssd1306_clear(&display);
     ssd1306_draw_string(&display, posX, posY, 1, text);
-    ssd1306_show(&display);
 }
 
 
@@ -50,61 +57,224 @@ void oled_write(char *text, uint32_t posX, uint32_t posY){
  * @return void
  */
 void oled_write_no_clear(char *text, uint32_t posX,uint32_t posY){
+    ui_invalidate(&ui);
     ssd1306_draw_string(&display, posX, posY, 1, text);
-    ssd1306_show(&display);
+}
+
+static bool oled_pending = false;  // Quadro aguardando o fim do envio anterior
+
+/**
+ * @brief Envia ao display o quadro montado pelas escritas anteriores, por DMA e sem bloquear.
+ * Apenas as colunas que mudaram desde o último envio passam pelo I2C, e o próximo quadro
+ * pode ser desenhado enquanto este é enviado
+ */
+void oled_commit(){
+    // Com um envio em andamento, o quadro sai em oled_poll() assim que o barramento liberar
+    oled_pending = !ssd1306_show_async(&display);
 }
 
+/**
+ * @brief Envia o quadro que ficou pendente em oled_commit(). Deve ser chamada a cada iteração do loop principal
+ */
+void oled_poll(){
+    if (oled_pending) {
+        oled_commit();
+    }
+}
+
+/**
+ * @brief Desenha as células da tela que mudaram e envia o quadro, se algo mudou
+ */
+static void oled_render(){
+    if (ui_render(&ui, &display) > 0) {
+        oled_commit();
+    }
+}
+
+// Campos do menu principal
+enum {
+    MAIN_MENU_TITLE,
+    MAIN_MENU_CURSOR_MAX,
+    MAIN_MENU_OPTION_MAX,
+    MAIN_MENU_CURSOR_MIN,
+    MAIN_MENU_OPTION_MIN,
+    MAIN_MENU_LABEL_MAX,
+    MAIN_MENU_VALUE_MAX,
+    MAIN_MENU_LABEL_MIN,
+    MAIN_MENU_VALUE_MIN
+};
+
+static const ui_field_def_t main_menu_fields[] = {
+    [MAIN_MENU_TITLE]      = {0, 0, 22, "=== MENU PRINCIPAL ==="},
+    [MAIN_MENU_CURSOR_MAX] = {0, 16, 1, NULL},
+    [MAIN_MENU_OPTION_MAX] = {12, 16, 17, "Ajustar Temp. MAX"},
+    [MAIN_MENU_CURSOR_MIN] = {0, 28, 1, NULL},
+    [MAIN_MENU_OPTION_MIN] = {12, 28, 17, "Ajustar Temp. MIN"},
+    [MAIN_MENU_LABEL_MAX]  = {0, 44, 10, "Atual MAX:"},
+    [MAIN_MENU_VALUE_MAX]  = {80, 44, 8, NULL},
+    [MAIN_MENU_LABEL_MIN]  = {0, 56, 10, "Atual MIN:"},
+    [MAIN_MENU_VALUE_MIN]  = {80, 56, 8, NULL}
+};
+
+static const ui_screen_def_t main_menu_screen = {main_menu_fields, sizeof(main_menu_fields) / sizeof(main_menu_fields[0])};
+
+// Campos das telas de ajuste de temperatura, que diferem apenas no título
+enum {
+    SET_TEMP_TITLE,
+    SET_TEMP_HINT,
+    SET_TEMP_LABEL,
+    SET_TEMP_VALUE,
+    SET_TEMP_ENTER,
+    SET_TEMP_BACK
+};
+
+static const ui_field_def_t set_temp_fields[] = {
+    [SET_TEMP_TITLE] = {0, 0, 22, NULL},
+    [SET_TEMP_HINT]  = {0, 16, 23, "Use joystick p/ ajustar"},
+    [SET_TEMP_LABEL] = {0, 28, 12, "Valor atual:"},
+    [SET_TEMP_VALUE] = {78, 28, 8, NULL},
+    [SET_TEMP_ENTER] = {0, 44, 20, "ENTER para confirmar"},
+    [SET_TEMP_BACK]  = {0, 56, 18, "BACK para cancelar"}
+};
+
+static const ui_screen_def_t set_temp_screen = {set_temp_fields, sizeof(set_temp_fields) / sizeof(set_temp_fields[0])};
+
+// Campos da tela de monitoramento
+enum {
+    MONITOR_LIMITS_LABEL,
+    MONITOR_LIMITS,
+    MONITOR_TEMP_LABEL,
+    MONITOR_TEMP,
+    MONITOR_STATUS
+};
+
+static const ui_field_def_t monitor_fields[] = {
+    [MONITOR_LIMITS_LABEL] = {0, 12, 8, "Limites:"},
+    [MONITOR_LIMITS]       = {54, 12, 14, NULL},
+    [MONITOR_TEMP_LABEL]   = {0, 32, 12, "Temperatura:"},
+    [MONITOR_TEMP]         = {78, 32, 9, NULL},
+    [MONITOR_STATUS]       = {0, 44, 18, NULL}
+};
+
+static const ui_screen_def_t monitor_screen = {monitor_fields, sizeof(monitor_fields) / sizeof(monitor_fields[0])};
+
+// Tela de falha na leitura do sensor
+static const ui_field_def_t sensor_error_fields[] = {
+    {0, 24, 19, "Erro ao ler sensor!"},
+    {0, 36, 19, "Verifique conexoes!"}
+};
+
+static const ui_screen_def_t sensor_error_screen = {sensor_error_fields, sizeof(sensor_error_fields) / sizeof(sensor_error_fields[0])};
+
 /**
  * @brief Atualiza a seleção no menu principal
  */
 void draw_main_menu_selection(int select_max) {
-    if (select_max) {
-        oled_write_no_clear("> Ajustar Temp. MAX", 0, 16);
-        oled_write_no_clear("  Ajustar Temp. MIN", 0, 28);
-    } else {
-        oled_write_no_clear("  Ajustar Temp. MAX", 0, 16);
-        oled_write_no_clear("> Ajustar Temp. MIN", 0, 28);
-    }
+    ui_set_text(&ui, MAIN_MENU_CURSOR_MAX, select_max ? ">" : "");
+    ui_set_text(&ui, MAIN_MENU_CURSOR_MIN, select_max ? "" : ">");
+    oled_render();
 }
 
 /**
- * @brief Desenha o menu principal no display OLED
+ * @brief Desenha o menu principal no display OLED. Só os campos que mudaram são redesenhados
  */
 void draw_main_menu(int *temp_min, int *temp_max, int menu_select) {
-    oled_write("=== MENU PRINCIPAL ===", 0, 0);
+    ui_show(&ui, &display, &main_menu_screen);
+    ui_set_int(&ui, MAIN_MENU_VALUE_MAX, *temp_max, " C");
+    ui_set_int(&ui, MAIN_MENU_VALUE_MIN, *temp_min, " C");
     draw_main_menu_selection(menu_select);
-    oled_write_no_clear("Atual MAX: ", 0, 44);
-    char temp_buffer[10];
-    sprintf(temp_buffer, "%d C", *temp_max);
-    oled_write_no_clear(temp_buffer, 80, 44);
-    oled_write_no_clear("Atual MIN: ", 0, 56);
-    sprintf(temp_buffer, "%d C", *temp_min);
-    oled_write_no_clear(temp_buffer, 80, 56);
 }
 
-
 /**
  * @brief Tela de ajuste de temperatura máxima
  */
 void draw_set_temp_max(int temp_max_setting) {
-    oled_write("== AJUSTE TEMP. MAX ==", 0, 0);
-    oled_write_no_clear("Use joystick p/ ajustar", 0, 16);
-    char temp_buffer[20];
-    sprintf(temp_buffer, "Valor atual: %d C", temp_max_setting);
-    oled_write_no_clear(temp_buffer, 0, 28);
-    oled_write_no_clear("ENTER para confirmar", 0, 44);
-    oled_write_no_clear("BACK para cancelar", 0, 56);
+    ui_show(&ui, &display, &set_temp_screen);
+    ui_set_text(&ui, SET_TEMP_TITLE, "== AJUSTE TEMP. MAX ==");
+    ui_set_int(&ui, SET_TEMP_VALUE, temp_max_setting, " C");
+    oled_render();
 }
 
 /**
  * @brief Tela de ajuste de temperatura mínima
  */
 void draw_set_temp_min(int temp_min_setting) {
-    oled_write("== AJUSTE TEMP. MIN ==", 0, 0);
-    oled_write_no_clear("Use joystick p/ ajustar", 0, 16);
-    char temp_buffer[20];
-    sprintf(temp_buffer, "Valor atual: %d C", temp_min_setting);
-    oled_write_no_clear(temp_buffer, 0, 28);
-    oled_write_no_clear("ENTER para confirmar", 0, 44);
-    oled_write_no_clear("BACK para cancelar", 0, 56);
-}
\ No newline at end of file
+    ui_show(&ui, &display, &set_temp_screen);
+    ui_set_text(&ui, SET_TEMP_TITLE, "== AJUSTE TEMP. MIN ==");
+    ui_set_int(&ui, SET_TEMP_VALUE, temp_min_setting, " C");
+    oled_render();
+}
+
+/**
+ * @brief Tela de monitoramento com a temperatura atual e os limites
+ * @param[in] *status Mensagem de alarme, ou "" sem alarme
+ */
+void draw_monitoring(int temperature, int temp_min, int temp_max, const char *status) {
+    char text[UI_FIELD_MAX + 24];   // Cabe qualquer par de inteiros
+
+    ui_show(&ui, &display, &monitor_screen);
+
+    char *end = ui_append_int(text, temp_min);
+    strcpy(end, " a ");
+    end = ui_append_int(end + 3, temp_max);
+    strcpy(end, " graus");
+    ui_set_text(&ui, MONITOR_LIMITS, text);
+
+    ui_set_int(&ui, MONITOR_TEMP, temperature, " graus");
+    ui_set_text(&ui, MONITOR_STATUS, status);
+    oled_render();
+}
+
+// Campos de texto do painel; os dígitos e o gráfico são desenhados por dashboard_render()
+enum {
+    DASHBOARD_FIELD_LIMITS,
+    DASHBOARD_FIELD_STATUS
+};
+
+static const ui_field_def_t dashboard_fields[] = {
+    [DASHBOARD_FIELD_LIMITS] = {0, 0, 15, NULL},
+    [DASHBOARD_FIELD_STATUS] = {98, 0, 5, NULL}
+};
+
+static const ui_screen_def_t dashboard_screen = {dashboard_fields, sizeof(dashboard_fields) / sizeof(dashboard_fields[0])};
+
+/**
+ * @brief Registra uma leitura para o gráfico do painel, mesmo que ele não esteja sendo exibido
+ */
+void oled_record_sample(int temperature) {
+    dashboard_record(&dashboard, temperature);
+}
+
+/**
+ * @brief Painel de monitoramento: temperatura em dígitos grandes e gráfico das últimas 128 leituras.
+ * A cada nova leitura o gráfico é deslocado uma coluna, sem ser redesenhado
+ */
+void draw_dashboard(int temperature, int temp_min, int temp_max) {
+    char text[UI_FIELD_MAX + 24];
+
+    // Na troca de tela o framebuffer é limpo, e o painel precisa ser desenhado por inteiro
+    if (ui.screen != &dashboard_screen) {
+        dashboard_invalidate(&dashboard);
+    }
+    ui_show(&ui, &display, &dashboard_screen);
+
+    char *end = ui_append_int(text, temp_min);
+    strcpy(end, " a ");
+    end = ui_append_int(end + 3, temp_max);
+    strcpy(end, " C");
+    ui_set_text(&ui, DASHBOARD_FIELD_LIMITS, text);
+    ui_set_text(&ui, DASHBOARD_FIELD_STATUS, temperature >= temp_max ? " ALTA" : temperature <= temp_min ? "BAIXA" : "");
+
+    bool drawn = dashboard_render(&dashboard, &display, temperature, temp_min, temp_max);
+    if (ui_render(&ui, &display) > 0 || drawn) {
+        oled_commit();
+    }
+}
+
+/**
+ * @brief Tela de falha na leitura do sensor
+ */
+void draw_sensor_error() {
+    ui_show(&ui, &display, &sensor_error_screen);
+    oled_render();
+}
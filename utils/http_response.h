@@ -0,0 +1,289 @@
+#ifndef HTTP_RESPONSE_H
+#define HTTP_RESPONSE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "cJSON.h"
+
+#define HTTP_LINE_MAX 64            // Início guardado de cada linha do cabeçalho, o restante é ignorado
+#define HTTP_JSON_TOKEN_MAX 128     // Maior string, chave ou número aceito no corpo JSON
+
+/**
+ * @brief Etapas da leitura de uma resposta HTTP
+ */
+typedef enum {
+    /* Linha de status: "HTTP/1.1 200 OK" */
+    HTTP_PARSE_STATUS,
+
+    /* Cabeçalhos, até a linha vazia */
+    HTTP_PARSE_HEADERS,
+
+    /* Corpo com Content-Length */
+    HTTP_PARSE_BODY,
+
+    /* Corpo sem tamanho conhecido, termina quando o servidor fecha a conexão */
+    HTTP_PARSE_BODY_UNTIL_CLOSE,
+
+    /* Linha com o tamanho em hexadecimal do próximo bloco (Transfer-Encoding: chunked) */
+    HTTP_PARSE_CHUNK_SIZE,
+
+    /* Dados de um bloco */
+    HTTP_PARSE_CHUNK_DATA,
+
+    /* "\r\n" após os dados de um bloco */
+    HTTP_PARSE_CHUNK_END,
+
+    /* Cabeçalhos opcionais após o último bloco, até a linha vazia */
+    HTTP_PARSE_TRAILERS,
+
+    /* Resposta completa */
+    HTTP_PARSE_DONE,
+
+    /* Resposta malformada, a conexão não está mais sincronizada */
+    HTTP_PARSE_ERROR
+} http_parse_state_t;
+
+// Estado da leitura de uma resposta HTTP, que pode chegar dividida em qualquer ponto entre segmentos TCP
+typedef struct {
+    http_parse_state_t state;
+    int status_code;
+    uint32_t remaining;         // Bytes restantes do corpo ou do bloco atual
+    bool has_content_length;
+    bool chunked;
+    bool connection_close;      // O servidor pediu para fechar a conexão após a resposta
+    bool json;                  // Corpo em JSON, repassado ao parser JSON incremental
+    bool json_ok;               // O corpo era um JSON válido e completo
+    char line[HTTP_LINE_MAX];
+    uint8_t line_len;
+    const cJSON_SaxCallbacks *json_callbacks;
+    void *json_user_data;
+    cJSON_SaxParser json_parser;
+    char json_token[HTTP_JSON_TOKEN_MAX];
+} http_response_t;
+
+/**
+ * @brief Prepara a leitura de uma nova resposta HTTP na mesma conexão
+ */
+static void http_response_reset(http_response_t *res) {
+    res->state = HTTP_PARSE_STATUS;
+    res->status_code = 0;
+    res->remaining = 0;
+    res->has_content_length = false;
+    res->chunked = false;
+    res->connection_close = false;
+    res->json = false;
+    res->json_ok = false;
+    res->line_len = 0;
+}
+
+/**
+ * @brief Inicializa a leitura de respostas HTTP
+ * @param[in] *callbacks Callbacks chamados para os valores de corpos JSON, ou NULL para ignorar os corpos
+ * @param[in] *user_data Repassado aos callbacks
+ */
+static void http_response_init(http_response_t *res, const cJSON_SaxCallbacks *callbacks, void *user_data) {
+    res->json_callbacks = callbacks;
+    res->json_user_data = user_data;
+    http_response_reset(res);
+}
+
+/**
+ * @brief Verifica se um cabeçalho contém um valor, sem diferenciar maiúsculas de minúsculas
+ */
+static bool http_header_contains(const char *value, const char *token) {
+    size_t token_len = strlen(token);
+
+    for (; *value != '\0'; value++) {
+        if (strncasecmp(value, token, token_len) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Finaliza o corpo da resposta
+ */
+static void http_response_finish(http_response_t *res) {
+    if (res->json) {
+        res->json_ok = cJSON_SaxFinish(&res->json_parser);
+    }
+    res->state = HTTP_PARSE_DONE;
+}
+
+/**
+ * @brief Repassa uma parte do corpo ao parser JSON, sem cópia.
+ * Um JSON inválido não interrompe a leitura da resposta, apenas deixa json_ok em false
+ */
+static void http_response_body(http_response_t *res, const char *data, size_t len) {
+    if (res->json) {
+        cJSON_SaxFeed(&res->json_parser, data, len);
+    }
+}
+
+/**
+ * @brief Decide como o corpo é delimitado ao fim dos cabeçalhos
+ */
+static void http_response_headers_end(http_response_t *res) {
+    if (res->status_code >= 100 && res->status_code < 200) {
+        // Resposta provisória (100 Continue), a resposta final vem em seguida
+        http_response_reset(res);
+        return;
+    }
+
+    if (res->json && res->json_callbacks != NULL) {
+        cJSON_SaxInit(&res->json_parser, res->json_callbacks, res->json_user_data,
+                      res->json_token, sizeof(res->json_token));
+    } else {
+        res->json = false;
+    }
+
+    if (res->status_code == 204 || res->status_code == 304) {
+        res->state = HTTP_PARSE_DONE;
+    } else if (res->chunked) {
+        res->state = HTTP_PARSE_CHUNK_SIZE;
+    } else if (res->has_content_length) {
+        if (res->remaining == 0) {
+            http_response_finish(res);
+        } else {
+            res->state = HTTP_PARSE_BODY;
+        }
+    } else if (res->connection_close) {
+        res->state = HTTP_PARSE_BODY_UNTIL_CLOSE;
+    } else {
+        // Sem tamanho em uma conexão mantida aberta: considera a resposta sem corpo
+        res->state = HTTP_PARSE_DONE;
+    }
+}
+
+/**
+ * @brief Interpreta uma linha completa, sem o "\r\n"
+ */
+static void http_response_line(http_response_t *res) {
+    res->line[res->line_len] = '\0';
+
+    switch (res->state) {
+        case HTTP_PARSE_STATUS:
+            if (strncmp(res->line, "HTTP/1.", 7) != 0 || res->line_len < 12) {
+                res->state = HTTP_PARSE_ERROR;
+                return;
+            }
+            res->status_code = atoi(res->line + 9);
+            res->state = HTTP_PARSE_HEADERS;
+            break;
+
+        case HTTP_PARSE_HEADERS:
+            if (res->line_len == 0) {
+                http_response_headers_end(res);
+            } else if (strncasecmp(res->line, "Content-Length:", 15) == 0) {
+                res->remaining = strtoul(res->line + 15, NULL, 10);
+                res->has_content_length = true;
+            } else if (strncasecmp(res->line, "Transfer-Encoding:", 18) == 0) {
+                res->chunked = http_header_contains(res->line + 18, "chunked");
+            } else if (strncasecmp(res->line, "Connection:", 11) == 0) {
+                res->connection_close = http_header_contains(res->line + 11, "close");
+            } else if (strncasecmp(res->line, "Content-Type:", 13) == 0) {
+                res->json = http_header_contains(res->line + 13, "json");
+            }
+            break;
+
+        case HTTP_PARSE_CHUNK_SIZE: {
+            // Tamanho em hexadecimal, possivelmente seguido de extensões após ';'
+            char *end = NULL;
+            uint32_t size = strtoul(res->line, &end, 16);
+            if (end == res->line) {
+                res->state = HTTP_PARSE_ERROR;
+            } else if (size == 0) {
+                res->state = HTTP_PARSE_TRAILERS;
+            } else {
+                res->remaining = size;
+                res->state = HTTP_PARSE_CHUNK_DATA;
+            }
+            break;
+        }
+
+        case HTTP_PARSE_CHUNK_END:
+            res->state = res->line_len == 0 ? HTTP_PARSE_CHUNK_SIZE : HTTP_PARSE_ERROR;
+            break;
+
+        case HTTP_PARSE_TRAILERS:
+            if (res->line_len == 0) {
+                http_response_finish(res);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Alimenta a leitura com dados recebidos, que podem terminar em qualquer ponto da resposta.
+ * O corpo é repassado ao parser JSON em trechos, sem cópia; só as linhas do cabeçalho são copiadas
+ * @param[in] *data Dados recebidos, como o payload de um pbuf
+ * @return Bytes consumidos. Se a resposta terminar antes do fim dos dados, o restante pertence à próxima
+ */
+static size_t http_response_feed(http_response_t *res, const char *data, size_t len) {
+    size_t used = 0;
+
+    while (used < len && res->state != HTTP_PARSE_DONE && res->state != HTTP_PARSE_ERROR) {
+        if (res->state == HTTP_PARSE_BODY || res->state == HTTP_PARSE_CHUNK_DATA) {
+            size_t n = len - used < res->remaining ? len - used : res->remaining;
+            http_response_body(res, data + used, n);
+            used += n;
+            res->remaining -= n;
+
+            if (res->remaining == 0) {
+                if (res->state == HTTP_PARSE_BODY) {
+                    http_response_finish(res);
+                } else {
+                    res->state = HTTP_PARSE_CHUNK_END;
+                }
+            }
+        } else if (res->state == HTTP_PARSE_BODY_UNTIL_CLOSE) {
+            http_response_body(res, data + used, len - used);
+            used = len;
+        } else {
+            // Status, cabeçalhos e tamanhos de bloco são lidos linha a linha
+            const char *newline = memchr(data + used, '\n', len - used);
+            size_t n = newline ? (size_t)(newline - (data + used)) : len - used;
+
+            // Linhas maiores que o buffer são truncadas, apenas o início interessa
+            size_t room = sizeof(res->line) - 1 - res->line_len;
+            memcpy(res->line + res->line_len, data + used, n < room ? n : room);
+            res->line_len += n < room ? n : room;
+            used += n;
+
+            if (newline) {
+                used++;
+                if (res->line_len > 0 && res->line[res->line_len - 1] == '\r') {
+                    res->line_len--;
+                }
+                http_response_line(res);
+                res->line_len = 0;
+            }
+        }
+    }
+
+    return used;
+}
+
+/**
+ * @brief Informa que o servidor fechou a conexão
+ * @return true se isso completou uma resposta cujo corpo vai até o fechamento da conexão
+ */
+static bool http_response_close(http_response_t *res) {
+    if (res->state != HTTP_PARSE_BODY_UNTIL_CLOSE) {
+        return false;
+    }
+
+    http_response_finish(res);
+    return true;
+}
+
+#endif // HTTP_RESPONSE_H
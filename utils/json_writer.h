@@ -0,0 +1,161 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define JSON_WRITER_MAX_DEPTH 32    // Níveis de objetos/arrays aninhados suportados
+
+// Estado da escrita de um JSON diretamente em um buffer fornecido pelo chamador, sem alocação
+typedef struct {
+    char *buf;
+    size_t cap;
+    size_t len;
+    bool overflow;          // O conteúdo não coube no buffer, o resultado deve ser descartado
+    bool after_key;         // O próximo valor pertence a uma chave já escrita
+    uint8_t depth;
+    uint32_t has_items;     // Bit por nível: o objeto/array já possui algum item
+} json_writer_t;
+
+/**
+ * @brief Prepara a escrita em um buffer
+ * @param[out] w Estado do escritor
+ * @param[in] buf Buffer de destino
+ * @param[in] cap Tamanho do buffer
+ */
+void json_writer_init(json_writer_t *w, char *buf, size_t cap) {
+    w->buf = buf;
+    w->cap = cap;
+    w->len = 0;
+    w->overflow = false;
+    w->after_key = false;
+    w->depth = 0;
+    w->has_items = 0;
+}
+
+/**
+ * @brief Escreve bytes sem nenhuma formatação
+ */
+void json_write_raw(json_writer_t *w, const char *data, size_t len) {
+    if (w->overflow || w->len + len > w->cap) {
+        w->overflow = true;
+        return;
+    }
+    memcpy(w->buf + w->len, data, len);
+    w->len += len;
+}
+
+static inline void json_write_char(json_writer_t *w, char c) {
+    if (w->overflow || w->len >= w->cap) {
+        w->overflow = true;
+        return;
+    }
+    w->buf[w->len++] = c;
+}
+
+/**
+ * @brief Escreve a vírgula entre itens quando necessário
+ */
+static void json_write_separator(json_writer_t *w) {
+    if (w->after_key) {
+        w->after_key = false;
+        return;
+    }
+
+    uint32_t bit = 1u << w->depth;
+    if (w->has_items & bit) {
+        json_write_char(w, ',');
+    }
+    w->has_items |= bit;
+}
+
+static void json_open(json_writer_t *w, char c) {
+    json_write_separator(w);
+    json_write_char(w, c);
+    if (++w->depth >= JSON_WRITER_MAX_DEPTH) {
+        w->overflow = true;
+        return;
+    }
+    w->has_items &= ~(1u << w->depth);
+}
+
+static void json_close(json_writer_t *w, char c) {
+    if (w->depth > 0) {
+        w->depth--;
+    }
+    json_write_char(w, c);
+}
+
+void json_begin_object(json_writer_t *w) { json_open(w, '{'); }
+void json_end_object(json_writer_t *w) { json_close(w, '}'); }
+void json_begin_array(json_writer_t *w) { json_open(w, '['); }
+void json_end_array(json_writer_t *w) { json_close(w, ']'); }
+
+/**
+ * @brief Escreve uma string entre aspas, escapando os caracteres necessários
+ */
+static void json_write_quoted(json_writer_t *w, const char *str) {
+    static const char hex[] = "0123456789abcdef";
+
+    json_write_char(w, '"');
+    for (const char *c = str; *c; c++) {
+        unsigned char ch = (unsigned char)*c;
+        if (ch == '"' || ch == '\\') {
+            json_write_char(w, '\\');
+            json_write_char(w, ch);
+        } else if (ch < 0x20) {
+            char escaped[6] = {'\\', 'u', '0', '0', hex[ch >> 4], hex[ch & 0xF]};
+            json_write_raw(w, escaped, sizeof(escaped));
+        } else {
+            json_write_char(w, ch);
+        }
+    }
+    json_write_char(w, '"');
+}
+
+/**
+ * @brief Escreve a chave de um membro de objeto; o próximo valor escrito pertence a ela
+ */
+void json_key(json_writer_t *w, const char *key) {
+    json_write_separator(w);
+    json_write_quoted(w, key);
+    json_write_char(w, ':');
+    w->after_key = true;
+}
+
+void json_string(json_writer_t *w, const char *str) {
+    json_write_separator(w);
+    json_write_quoted(w, str);
+}
+
+/**
+ * @brief Escreve um inteiro sem sinal em decimal, sem usar printf
+ */
+void json_uint(json_writer_t *w, uint32_t value) {
+    char digits[10];
+    int n = 0;
+
+    json_write_separator(w);
+    do {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+
+    while (n > 0) {
+        json_write_char(w, digits[--n]);
+    }
+}
+
+void json_int(json_writer_t *w, int32_t value) {
+    if (value < 0) {
+        json_write_separator(w);
+        json_write_char(w, '-');
+        w->after_key = true; // O número vem logo após o sinal, sem separador
+        json_uint(w, (uint32_t)0 - (uint32_t)value);
+    } else {
+        json_uint(w, (uint32_t)value);
+    }
+}
+
+#endif // JSON_WRITER_H
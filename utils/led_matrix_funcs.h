@@ -8,7 +8,7 @@
  */
 void led_matrix_init(){
     ws2812b_init(pio0, LED_MATRIX_PIN, 25);
-    ws2812b_set_global_dimming(7);
+    ws2812b_set_brightness(28); // Cerca de 1/128 da intensidade, sem perder a resolução das cores
     ws2812b_fill_all(GRB_SPRING);
     ws2812b_render();
 }
@@ -0,0 +1,128 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "connection_manager.h"
+
+#define TELEMETRY_BUFFER_SIZE 256       // Leituras guardadas em RAM aguardando envio
+#define TELEMETRY_BATCH_SIZE 32         // Leituras enviadas em cada requisição
+#define TELEMETRY_MAX_AGE_MS 60000      // Idade máxima da leitura mais antiga antes de forçar o envio
+
+// Leitura de temperatura registrada
+typedef struct {
+    uint32_t timestamp_ms;  // Milissegundos desde a inicialização
+    int16_t temperature;
+} telemetry_sample_t;
+
+// Buffer circular de leituras ainda não enviadas
+typedef struct {
+    telemetry_sample_t samples[TELEMETRY_BUFFER_SIZE];
+    uint16_t head;
+    uint16_t count;
+    uint32_t overwritten;   // Leituras perdidas por falta de espaço
+    bool flush_requested;
+} telemetry_buffer_t;
+
+static telemetry_buffer_t telemetry;
+
+/**
+ * @brief Registra uma leitura de temperatura. Se o buffer estiver cheio, a leitura mais antiga é sobrescrita
+ * @param[in] temperature Temperatura lida, em graus Celsius
+ */
+void telemetry_record(int temperature) {
+    telemetry_sample_t *sample = &telemetry.samples[(telemetry.head + telemetry.count) % TELEMETRY_BUFFER_SIZE];
+
+    if (telemetry.count == TELEMETRY_BUFFER_SIZE) {
+        telemetry.head = (telemetry.head + 1) % TELEMETRY_BUFFER_SIZE;
+        telemetry.overwritten++;
+    } else {
+        telemetry.count++;
+    }
+
+    sample->timestamp_ms = to_ms_since_boot(get_absolute_time());
+    sample->temperature = temperature;
+}
+
+/**
+ * @brief Solicita o envio das leituras pendentes na próxima chamada de telemetry_poll(), usado em alarmes
+ */
+void telemetry_request_flush() {
+    telemetry.flush_requested = true;
+}
+
+/**
+ * @brief Monta o JSON de um lote com as leituras mais antigas do buffer diretamente na fila de envio
+ * @param[in] *config Ponteiro para estrutura de dados contendo configurações de wifi
+ * @param[in] *device_id Identificador único do dispositivo
+ * @param[in] count Quantidade de leituras no lote
+ * @return true se o lote foi aceito pela fila
+ */
+static bool telemetry_send_batch(wifi_config_t *config, const char *device_id, uint16_t count) {
+    json_writer_t w;
+
+    api_message_begin(&w, config, MESSAGE_TELEMETRY);
+    json_begin_object(&w);
+    json_key(&w, "deviceId");
+    json_string(&w, device_id);
+    // Referência de tempo para que o servidor converta os timestamps das leituras
+    json_key(&w, "uptimeMs");
+    json_uint(&w, to_ms_since_boot(get_absolute_time()));
+
+    // Cada leitura é enviada como [timestamp, temperatura] para manter o JSON compacto
+    json_key(&w, "samples");
+    json_begin_array(&w);
+    for (uint16_t i = 0; i < count; i++) {
+        telemetry_sample_t *sample = &telemetry.samples[(telemetry.head + i) % TELEMETRY_BUFFER_SIZE];
+        json_begin_array(&w);
+        json_uint(&w, sample->timestamp_ms);
+        json_int(&w, sample->temperature);
+        json_end_array(&w);
+    }
+    json_end_array(&w);
+    json_end_object(&w);
+
+    return api_message_end(&w);
+}
+
+/**
+ * @brief Verifica as condições de envio e enfileira um lote de leituras quando necessário.
+ * O envio acontece quando há leituras suficientes para um lote, quando a leitura mais antiga
+ * passa de TELEMETRY_MAX_AGE_MS ou quando um alarme solicitou o envio imediato
+ * @param[in] *config Ponteiro para estrutura de dados contendo configurações de wifi
+ * @param[in] *device_id Identificador único do dispositivo
+ */
+void telemetry_poll(wifi_config_t *config, const char *device_id) {
+    if (telemetry.count == 0) {
+        telemetry.flush_requested = false;
+        return;
+    }
+
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    uint32_t oldest_age = now - telemetry.samples[telemetry.head].timestamp_ms;
+
+    if (telemetry.count < TELEMETRY_BATCH_SIZE && oldest_age < TELEMETRY_MAX_AGE_MS &&
+        !telemetry.flush_requested) {
+        return;
+    }
+
+    // Mantém sempre uma posição livre na fila para alertas; sem conexão, as leituras esperam aqui
+    if (alert_queue_free() < 2) {
+        return;
+    }
+
+    uint16_t count = telemetry.count < TELEMETRY_BATCH_SIZE ? telemetry.count : TELEMETRY_BATCH_SIZE;
+    if (!telemetry_send_batch(config, device_id, count)) {
+        return; // As leituras continuam no buffer para a próxima tentativa
+    }
+
+    telemetry.head = (telemetry.head + count) % TELEMETRY_BUFFER_SIZE;
+    telemetry.count -= count;
+
+    // Continua enviando até esvaziar o buffer quando o envio imediato foi solicitado
+    if (telemetry.count == 0) {
+        telemetry.flush_requested = false;
+    }
+}
+
+#endif // TELEMETRY_H
@@ -0,0 +1,158 @@
+#ifndef UI_SCREEN_H
+#define UI_SCREEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "libs/pico-ssd1306/ssd1306.h"
+
+#define UI_CHAR_WIDTH 6         // Largura de uma célula da fonte 8x5, com o espaçamento
+#define UI_CHAR_HEIGHT 8
+#define UI_FIELD_MAX 24         // Maior campo, em caracteres; uma linha de 128 pixels tem 21 inteiras
+#define UI_SCREEN_MAX_FIELDS 10
+
+// Campo de texto em uma posição fixa da tela
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t cols;               // Células reservadas ao campo; as que sobrarem do texto ficam em branco
+    const char *text;           // Texto inicial, ou NULL para campos preenchidos pelo código
+} ui_field_def_t;
+
+// Tela declarada como uma lista de campos
+typedef struct {
+    const ui_field_def_t *fields;
+    uint8_t count;
+} ui_screen_def_t;
+
+// Estado da tela exibida: para cada campo, o texto desejado e o que já está desenhado no framebuffer
+typedef struct {
+    const ui_screen_def_t *screen;
+    char text[UI_SCREEN_MAX_FIELDS][UI_FIELD_MAX + 1];
+    char shown[UI_SCREEN_MAX_FIELDS][UI_FIELD_MAX];
+    bool dirty;                 // Algum campo mudou desde o último ui_render()
+} ui_state_t;
+
+/**
+ * @brief Copia um texto para um campo, cortado em UI_FIELD_MAX caracteres e sempre terminado em '\0'
+ */
+static void ui_copy_text(char *dst, const char *text) {
+    size_t len = 0;
+
+    for (; len < UI_FIELD_MAX && text[len] != '\0'; len++) {
+        dst[len] = text[len];
+    }
+    dst[len] = '\0';
+}
+
+/**
+ * @brief Informa que o framebuffer foi alterado fora do modelo; a próxima tela é redesenhada por inteiro
+ */
+static void ui_invalidate(ui_state_t *ui) {
+    ui->screen = NULL;
+}
+
+/**
+ * @brief Passa a exibir uma tela. Se ela já for a tela atual, nada muda e os campos mantêm seus valores
+ * @param[in] *screen Tela a ser exibida
+ * @param[out] *disp Display cujo framebuffer é limpo na troca de tela
+ */
+static void ui_show(ui_state_t *ui, ssd1306_t *disp, const ui_screen_def_t *screen) {
+    if (ui->screen == screen) {
+        return;
+    }
+
+    ssd1306_clear(disp);
+    ui->screen = screen;
+    for (uint8_t i = 0; i < screen->count; i++) {
+        const char *text = screen->fields[i].text ? screen->fields[i].text : "";
+        ui_copy_text(ui->text[i], text);
+        memset(ui->shown[i], ' ', UI_FIELD_MAX); // Framebuffer em branco
+    }
+    ui->dirty = true;
+}
+
+/**
+ * @brief Altera o texto de um campo da tela atual. Só é desenhado em ui_render()
+ */
+static void ui_set_text(ui_state_t *ui, uint8_t field, const char *text) {
+    if (strncmp(ui->text[field], text, UI_FIELD_MAX) == 0) {
+        return;
+    }
+
+    ui_copy_text(ui->text[field], text);
+    ui->dirty = true;
+}
+
+/**
+ * @brief Escreve um inteiro em decimal, sem printf
+ * @return Posição após o último dígito, já terminada em '\0'
+ */
+static char *ui_append_int(char *dst, int value) {
+    char digits[10];
+    int n = 0;
+    uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+
+    if (value < 0) {
+        *dst++ = '-';
+    }
+    do {
+        digits[n++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude);
+
+    while (n > 0) {
+        *dst++ = digits[--n];
+    }
+    *dst = '\0';
+    return dst;
+}
+
+/**
+ * @brief Altera um campo para um inteiro seguido de um sufixo, como "32 C"
+ */
+static void ui_set_int(ui_state_t *ui, uint8_t field, int value, const char *suffix) {
+    char text[UI_FIELD_MAX + 12];
+
+    char *end = ui_append_int(text, value);
+    ui_copy_text(end, suffix);
+    ui_set_text(ui, field, text);
+}
+
+/**
+ * @brief Desenha no framebuffer apenas as células de caractere que mudaram desde a última chamada
+ * @return Quantidade de células redesenhadas; 0 se o framebuffer não mudou
+ */
+static uint32_t ui_render(ui_state_t *ui, ssd1306_t *disp) {
+    uint32_t cells = 0;
+
+    if (!ui->dirty || ui->screen == NULL) {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < ui->screen->count; i++) {
+        const ui_field_def_t *def = &ui->screen->fields[i];
+        const char *text = ui->text[i];
+        bool ended = false;
+
+        for (uint8_t col = 0; col < def->cols; col++) {
+            ended = ended || text[col] == '\0';
+            char c = ended ? ' ' : text[col];
+
+            if (c == ui->shown[i][col]) {
+                continue;
+            }
+
+            uint32_t x = def->x + col * UI_CHAR_WIDTH;
+            ssd1306_clear_square(disp, x, def->y, UI_CHAR_WIDTH, UI_CHAR_HEIGHT);
+            ssd1306_draw_char(disp, x, def->y, 1, c);
+            ui->shown[i][col] = c;
+            cells++;
+        }
+    }
+
+    ui->dirty = false;
+    return cells;
+}
+
+#endif // UI_SCREEN_H